@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SECURITY_COMPONENT_UPDATE_RING_H
+#define SECURITY_COMPONENT_UPDATE_RING_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+struct UpdateRingHeader;
+
+struct SecCompUpdateRecord {
+    int32_t scId = -1;
+    uint32_t seq = 0;
+    std::string payload;
+};
+
+enum class UpdateRingStatus {
+    RING_OK = 0,
+    RING_EMPTY,
+    RING_CORRUPTED,
+};
+
+// single producer (app) and single consumer (service) ring of component updates in a shared region.
+// the consumer keeps its own read position and capacity, every byte of the region is untrusted to it.
+class __attribute__((visibility("default"))) SecCompUpdateRing final {
+public:
+    static constexpr uint32_t MIN_RING_CAPACITY = 0x1000;
+    static constexpr uint32_t MAX_RING_CAPACITY = 0x100000;
+    static constexpr uint32_t MAX_RECORD_PAYLOAD = 0x4000;
+
+    SecCompUpdateRing(void* region, uint32_t regionSize);
+    ~SecCompUpdateRing();
+
+    static uint32_t GetRegionSize(uint32_t capacity);
+    // creates a shared memory region, fd is owned by the caller
+    static std::unique_ptr<SecCompUpdateRing> CreateProducer(uint32_t capacity, int32_t& fd);
+    // maps the region behind fd, fd stays owned by the caller
+    static std::unique_ptr<SecCompUpdateRing> AttachConsumer(int32_t fd);
+
+    bool InitProducer();
+    bool InitConsumer();
+    // false if the record does not fit or the ring is closed, needDoorbell is set when the consumer has gone idle
+    bool Push(int32_t scId, const std::string& payload, bool& needDoorbell);
+    UpdateRingStatus Pop(SecCompUpdateRecord& record);
+    // false if records arrived meanwhile, the consumer must keep popping
+    bool MarkIdle();
+    bool IsClosed() const;
+    // seq of the record pushed or popped next
+    uint32_t GetNextSeq() const;
+    uint32_t GetFailedNum() const;
+    void AddFailedNum();
+
+private:
+    void CopyIn(uint32_t pos, const void* src, uint32_t len);
+    void CopyOut(uint32_t pos, void* dst, uint32_t len) const;
+    UpdateRingStatus SetCorrupted();
+
+    uint8_t* region_ = nullptr;
+    uint32_t regionSize_ = 0;
+    bool isMapped_ = false;
+    UpdateRingHeader* header_ = nullptr;
+    uint8_t* data_ = nullptr;
+    uint32_t capacity_ = 0;
+    // private positions, only published to the peer
+    uint32_t writePos_ = 0;
+    uint32_t readPos_ = 0;
+    uint32_t seq_ = 0;
+    bool isCorrupted_ = false;
+    DISALLOW_COPY_AND_MOVE(SecCompUpdateRing);
+};
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
+#endif  // SECURITY_COMPONENT_UPDATE_RING_H
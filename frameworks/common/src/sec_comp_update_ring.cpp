@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sec_comp_update_ring.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "ashmem.h"
+#include "sec_comp_log.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+struct UpdateRingHeader {
+    uint32_t magic;
+    uint32_t capacity;
+    // free running byte positions, the used size is head - tail
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> consumerIdle;
+    // set by the consumer once it stops draining, the producer falls back to binder calls
+    std::atomic<uint32_t> consumerClosed;
+    // records the consumer failed to apply, the producer rebuilds its delta bases when it changes
+    std::atomic<uint32_t> failedNum;
+    uint32_t reserved;
+};
+
+namespace {
+static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "UpdateRing"};
+static constexpr uint32_t RING_MAGIC = 0x53435552;
+static constexpr uint32_t RECORD_ALIGN = 4;
+static constexpr char RING_NAME[] = "sec_comp_update_ring";
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "ring positions must be lock free");
+
+struct UpdateRecordHeader {
+    uint32_t len;
+    int32_t scId;
+    uint32_t seq;
+};
+
+static uint32_t GetRecordSize(uint32_t len)
+{
+    return sizeof(UpdateRecordHeader) + ((len + RECORD_ALIGN - 1) & ~(RECORD_ALIGN - 1));
+}
+
+static bool IsCapacityValid(uint32_t capacity)
+{
+    return (capacity >= SecCompUpdateRing::MIN_RING_CAPACITY) &&
+        (capacity <= SecCompUpdateRing::MAX_RING_CAPACITY) && ((capacity & (capacity - 1)) == 0);
+}
+}
+
+SecCompUpdateRing::SecCompUpdateRing(void* region, uint32_t regionSize)
+    : region_(static_cast<uint8_t*>(region)), regionSize_(regionSize)
+{}
+
+SecCompUpdateRing::~SecCompUpdateRing()
+{
+    if (isMapped_ && (region_ != nullptr)) {
+        munmap(region_, regionSize_);
+    }
+}
+
+uint32_t SecCompUpdateRing::GetRegionSize(uint32_t capacity)
+{
+    return sizeof(UpdateRingHeader) + capacity;
+}
+
+std::unique_ptr<SecCompUpdateRing> SecCompUpdateRing::CreateProducer(uint32_t capacity, int32_t& fd)
+{
+    if (!IsCapacityValid(capacity)) {
+        SC_LOG_ERROR(LABEL, "Ring capacity %{public}u is invalid", capacity);
+        return nullptr;
+    }
+    uint32_t regionSize = GetRegionSize(capacity);
+    fd = AshmemCreate(RING_NAME, regionSize);
+    if (fd < 0) {
+        SC_LOG_ERROR(LABEL, "Create ring ashmem failed");
+        return nullptr;
+    }
+    void* region = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region == MAP_FAILED) {
+        SC_LOG_ERROR(LABEL, "Map ring ashmem failed");
+        close(fd);
+        fd = -1;
+        return nullptr;
+    }
+    auto ring = std::make_unique<SecCompUpdateRing>(region, regionSize);
+    ring->isMapped_ = true;
+    if (!ring->InitProducer()) {
+        ring = nullptr;
+        close(fd);
+        fd = -1;
+    }
+    return ring;
+}
+
+std::unique_ptr<SecCompUpdateRing> SecCompUpdateRing::AttachConsumer(int32_t fd)
+{
+    // only ashmem is accepted, its size can not change once it is mapped
+    int32_t size = AshmemGetSize(fd);
+    if ((size <= static_cast<int32_t>(sizeof(UpdateRingHeader))) ||
+        !IsCapacityValid(static_cast<uint32_t>(size) - sizeof(UpdateRingHeader))) {
+        SC_LOG_ERROR(LABEL, "Ring region size %{public}d is invalid", size);
+        return nullptr;
+    }
+    uint32_t regionSize = static_cast<uint32_t>(size);
+    void* region = mmap(nullptr, regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (region == MAP_FAILED) {
+        SC_LOG_ERROR(LABEL, "Map ring region failed");
+        return nullptr;
+    }
+    auto ring = std::make_unique<SecCompUpdateRing>(region, regionSize);
+    ring->isMapped_ = true;
+    if (!ring->InitConsumer()) {
+        return nullptr;
+    }
+    return ring;
+}
+
+bool SecCompUpdateRing::InitProducer()
+{
+    if ((region_ == nullptr) || (regionSize_ <= sizeof(UpdateRingHeader)) ||
+        !IsCapacityValid(regionSize_ - sizeof(UpdateRingHeader))) {
+        return false;
+    }
+    capacity_ = regionSize_ - sizeof(UpdateRingHeader);
+    header_ = new (region_) UpdateRingHeader();
+    header_->magic = RING_MAGIC;
+    header_->capacity = capacity_;
+    // idle until the first drain, the first record always rings the doorbell
+    header_->consumerIdle.store(1);
+    data_ = region_ + sizeof(UpdateRingHeader);
+    writePos_ = 0;
+    seq_ = 0;
+    return true;
+}
+
+bool SecCompUpdateRing::InitConsumer()
+{
+    if ((region_ == nullptr) || (regionSize_ <= sizeof(UpdateRingHeader)) ||
+        !IsCapacityValid(regionSize_ - sizeof(UpdateRingHeader))) {
+        return false;
+    }
+    header_ = reinterpret_cast<UpdateRingHeader*>(region_);
+    capacity_ = regionSize_ - sizeof(UpdateRingHeader);
+    if ((header_->magic != RING_MAGIC) || (header_->capacity != capacity_)) {
+        SC_LOG_ERROR(LABEL, "Ring header is invalid");
+        return false;
+    }
+    data_ = region_ + sizeof(UpdateRingHeader);
+    readPos_ = 0;
+    seq_ = 0;
+    header_->tail.store(readPos_, std::memory_order_release);
+    return true;
+}
+
+void SecCompUpdateRing::CopyIn(uint32_t pos, const void* src, uint32_t len)
+{
+    uint32_t offset = pos & (capacity_ - 1);
+    uint32_t first = std::min(len, capacity_ - offset);
+    const uint8_t* bytes = static_cast<const uint8_t*>(src);
+    (void)memcpy_s(data_ + offset, capacity_ - offset, bytes, first);
+    if (first < len) {
+        (void)memcpy_s(data_, capacity_, bytes + first, len - first);
+    }
+}
+
+void SecCompUpdateRing::CopyOut(uint32_t pos, void* dst, uint32_t len) const
+{
+    uint32_t offset = pos & (capacity_ - 1);
+    uint32_t first = std::min(len, capacity_ - offset);
+    uint8_t* bytes = static_cast<uint8_t*>(dst);
+    (void)memcpy_s(bytes, len, data_ + offset, first);
+    if (first < len) {
+        (void)memcpy_s(bytes + first, len - first, data_, len - first);
+    }
+}
+
+bool SecCompUpdateRing::Push(int32_t scId, const std::string& payload, bool& needDoorbell)
+{
+    needDoorbell = false;
+    if ((header_ == nullptr) || (payload.size() > MAX_RECORD_PAYLOAD) || IsClosed()) {
+        return false;
+    }
+    uint32_t len = static_cast<uint32_t>(payload.size());
+    uint32_t recordSize = GetRecordSize(len);
+    uint32_t used = writePos_ - header_->tail.load(std::memory_order_acquire);
+    if ((used > capacity_) || (recordSize > capacity_ - used)) {
+        return false;
+    }
+
+    UpdateRecordHeader recordHeader = { len, scId, seq_ };
+    CopyIn(writePos_, &recordHeader, sizeof(recordHeader));
+    CopyIn(writePos_ + sizeof(recordHeader), payload.data(), len);
+    writePos_ += recordSize;
+    seq_++;
+    // pairs with the store and recheck in MarkIdle, one of both sides sees the other
+    header_->head.store(writePos_, std::memory_order_seq_cst);
+    needDoorbell = (header_->consumerIdle.exchange(0, std::memory_order_seq_cst) != 0);
+    return true;
+}
+
+UpdateRingStatus SecCompUpdateRing::SetCorrupted()
+{
+    SC_LOG_ERROR(LABEL, "Ring is corrupted at %{public}u", readPos_);
+    isCorrupted_ = true;
+    header_->consumerClosed.store(1, std::memory_order_release);
+    return UpdateRingStatus::RING_CORRUPTED;
+}
+
+bool SecCompUpdateRing::IsClosed() const
+{
+    return (header_ == nullptr) || (header_->consumerClosed.load(std::memory_order_acquire) != 0);
+}
+
+uint32_t SecCompUpdateRing::GetNextSeq() const
+{
+    return seq_;
+}
+
+uint32_t SecCompUpdateRing::GetFailedNum() const
+{
+    return (header_ == nullptr) ? 0 : header_->failedNum.load(std::memory_order_acquire);
+}
+
+void SecCompUpdateRing::AddFailedNum()
+{
+    if (header_ != nullptr) {
+        header_->failedNum.fetch_add(1, std::memory_order_release);
+    }
+}
+
+UpdateRingStatus SecCompUpdateRing::Pop(SecCompUpdateRecord& record)
+{
+    if ((header_ == nullptr) || isCorrupted_) {
+        return UpdateRingStatus::RING_CORRUPTED;
+    }
+    uint32_t avail = header_->head.load(std::memory_order_acquire) - readPos_;
+    if (avail == 0) {
+        return UpdateRingStatus::RING_EMPTY;
+    }
+    if ((avail > capacity_) || (avail < sizeof(UpdateRecordHeader)) || ((avail % RECORD_ALIGN) != 0)) {
+        return SetCorrupted();
+    }
+
+    // copy out before checking, the producer may rewrite the region at any time
+    UpdateRecordHeader recordHeader;
+    CopyOut(readPos_, &recordHeader, sizeof(recordHeader));
+    if ((recordHeader.len > MAX_RECORD_PAYLOAD) || (GetRecordSize(recordHeader.len) > avail) ||
+        (recordHeader.seq != seq_) || (recordHeader.scId < 0)) {
+        return SetCorrupted();
+    }
+    record.scId = recordHeader.scId;
+    record.seq = recordHeader.seq;
+    record.payload.resize(recordHeader.len);
+    CopyOut(readPos_ + sizeof(recordHeader), &record.payload[0], recordHeader.len);
+
+    readPos_ += GetRecordSize(recordHeader.len);
+    seq_++;
+    header_->tail.store(readPos_, std::memory_order_release);
+    return UpdateRingStatus::RING_OK;
+}
+
+bool SecCompUpdateRing::MarkIdle()
+{
+    // a corrupted ring is never drained again, the producer sees it closed and falls back
+    if ((header_ == nullptr) || isCorrupted_) {
+        return true;
+    }
+    header_->consumerIdle.store(1, std::memory_order_seq_cst);
+    if (header_->head.load(std::memory_order_seq_cst) == readPos_) {
+        return true;
+    }
+    header_->consumerIdle.store(0, std::memory_order_seq_cst);
+    return false;
+}
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,8 +14,10 @@
  */
 #include "sec_comp_enhance_adapter.h"
 
+#include <atomic>
 #include <dlfcn.h>
 #include <sys/types.h>
+#include <vector>
 
 #include "ipc_skeleton.h"
 #include "parcel.h"
@@ -33,6 +35,25 @@ static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
 static const std::string ENHANCE_INPUT_INTERFACE_LIB = "libsecurity_component_client_enhance.z.so";
 static const std::string ENHANCE_SRV_INTERFACE_LIB = "libsecurity_component_service_enhance.z.so";
 static const std::string ENHANCE_CLIENT_INTERFACE_LIB = "libsecurity_component_client_enhance.z.so";
+static constexpr size_t MAX_POOLED_PARCEL_NUM = 8;
+static std::mutex g_parcelPoolMutex;
+static std::vector<std::shared_ptr<MessageParcel>> g_parcelPool;
+
+// lets a parcel read a rawdata buffer in place, the buffer stays owned by the rawdata
+class BorrowedDataAllocator : public Allocator {
+public:
+    void* Realloc(void* data, size_t newSize) override
+    {
+        return nullptr;
+    }
+
+    void* Alloc(size_t size) override
+    {
+        return nullptr;
+    }
+
+    void Dealloc(void* data) override {}
+};
 }
 
 SecCompInputEnhanceInterface* SecCompEnhanceAdapter::inputHandler = nullptr;
@@ -199,6 +220,31 @@ static bool WriteMessageParcel(MessageParcel& tmpData, SecCompRawdata& data)
     return true;
 }
 
+static bool BorrowMessageParcel(const std::shared_ptr<MessageParcel>& tmpData, SecCompRawdata& data)
+{
+    if (tmpData == nullptr) {
+        SC_LOG_ERROR(LABEL, "TmpData is null.");
+        return false;
+    }
+    size_t bufferLength = tmpData->GetDataSize();
+    if (bufferLength == 0) {
+        SC_LOG_INFO(LABEL, "TmpData is empty.");
+        return true;
+    }
+
+    const void* buffer = reinterpret_cast<const void *>(tmpData->GetData());
+    if (buffer == nullptr) {
+        SC_LOG_ERROR(LABEL, "Get tmpData data failed.");
+        return false;
+    }
+
+    if (data.Borrow(buffer, static_cast<uint32_t>(bufferLength), tmpData) != SC_OK) {
+        SC_LOG_ERROR(LABEL, "Borrow tmpData to rawdata failed.");
+        return false;
+    }
+    return true;
+}
+
 static bool ReadMessageParcel(SecCompRawdata& tmpData, MessageParcel& data)
 {
     uint32_t size = tmpData.size;
@@ -210,6 +256,15 @@ static bool ReadMessageParcel(SecCompRawdata& tmpData, MessageParcel& data)
     }
     char* ptr = reinterpret_cast<char *>(const_cast<void *>(iter));
 
+    // a parcel without buffer reads rawdata in place, callers keep rawdata alive longer than the parcel
+    if (data.GetData() == 0) {
+        Allocator* allocator = new (std::nothrow) BorrowedDataAllocator();
+        if ((allocator != nullptr) && data.SetAllocator(allocator)) {
+            return data.ParseFrom(reinterpret_cast<uintptr_t>(ptr), size);
+        }
+        delete allocator;
+    }
+
     if (!data.WriteBuffer(reinterpret_cast<void *>(ptr), size)) {
         SC_LOG_ERROR(LABEL, "Write rawData failed.");
         return false;
@@ -232,6 +287,21 @@ __attribute__((noinline)) bool SecCompEnhanceAdapter::EnhanceClientSerialize(
     return WriteMessageParcel(input, output);
 }
 
+__attribute__((noinline)) bool SecCompEnhanceAdapter::EnhanceClientSerialize(
+    const std::shared_ptr<MessageParcel>& input, SecCompRawdata& output)
+{
+    if (!isEnhanceClientHandlerInit) {
+        InitEnhanceHandler(SEC_COMP_ENHANCE_CLIENT_INTERFACE);
+    }
+
+    uintptr_t enhanceCallerAddr = reinterpret_cast<uintptr_t>(__builtin_return_address(0));
+    if ((clientHandler != nullptr) && (input != nullptr)) {
+        return clientHandler->EnhanceClientSerialize(enhanceCallerAddr, *input, output);
+    }
+
+    return BorrowMessageParcel(input, output);
+}
+
 __attribute__((noinline)) bool SecCompEnhanceAdapter::EnhanceClientDeserialize(
     SecCompRawdata& input, MessageParcel& output)
 {
@@ -247,6 +317,34 @@ __attribute__((noinline)) bool SecCompEnhanceAdapter::EnhanceClientDeserialize(
     return ReadMessageParcel(input, output);
 }
 
+std::shared_ptr<MessageParcel> SecCompEnhanceAdapter::AcquireParcel()
+{
+    std::lock_guard<std::mutex> lock(g_parcelPoolMutex);
+    for (const auto& parcel : g_parcelPool) {
+        // only the pool holds it, no rawdata borrows its buffer any more
+        if (parcel.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            parcel->RewindRead(0);
+            parcel->RewindWrite(0);
+            return parcel;
+        }
+    }
+
+    std::shared_ptr<MessageParcel> parcel = std::make_shared<MessageParcel>();
+    if (g_parcelPool.size() < MAX_POOLED_PARCEL_NUM) {
+        g_parcelPool.emplace_back(parcel);
+    }
+    return parcel;
+}
+
+bool SecCompEnhanceAdapter::IsClientEnhanceEnabled()
+{
+    if (!isEnhanceClientHandlerInit) {
+        InitEnhanceHandler(SEC_COMP_ENHANCE_CLIENT_INTERFACE);
+    }
+    return clientHandler != nullptr;
+}
+
 bool SecCompEnhanceAdapter::EnhanceSrvSerialize(MessageParcel& input, SecCompRawdata& output)
 {
     if (!isEnhanceSrvHandlerInit) {
@@ -259,6 +357,19 @@ bool SecCompEnhanceAdapter::EnhanceSrvSerialize(MessageParcel& input, SecCompRaw
     return WriteMessageParcel(input, output);
 }
 
+bool SecCompEnhanceAdapter::EnhanceSrvSerialize(const std::shared_ptr<MessageParcel>& input,
+    SecCompRawdata& output)
+{
+    if (!isEnhanceSrvHandlerInit) {
+        InitEnhanceHandler(SEC_COMP_ENHANCE_SRV_INTERFACE);
+    }
+    if ((srvHandler != nullptr) && (input != nullptr)) {
+        return srvHandler->EnhanceSrvSerialize(*input, output);
+    }
+
+    return BorrowMessageParcel(input, output);
+}
+
 bool SecCompEnhanceAdapter::EnhanceSrvDeserialize(SecCompRawdata& input, MessageParcel& output)
 {
     if (!isEnhanceSrvHandlerInit) {
@@ -358,6 +469,14 @@ int32_t SecCompEnhanceAdapter::CheckComponentInfoEnhance(int32_t pid,
     }
     return SC_OK;
 }
+
+bool SecCompEnhanceAdapter::IsSrvEnhanceEnabled()
+{
+    if (!isEnhanceSrvHandlerInit) {
+        InitEnhanceHandler(SEC_COMP_ENHANCE_SRV_INTERFACE);
+    }
+    return srvHandler != nullptr;
+}
 }  // namespace SecurityComponent
 }  // namespace Security
 }  // namespace OHOS
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Copyright (c) 2024-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -113,6 +113,8 @@ HWTEST_F(SecCompEnhanceAdapterTest, EnhanceAdapter002, TestSize.Level0)
     SecCompEnhanceAdapter::EnhanceClientSerialize(input, outputData);
     SecCompEnhanceAdapter::isEnhanceClientHandlerInit = false;
     SecCompEnhanceAdapter::EnhanceClientDeserialize(inputData, output);
+    SecCompEnhanceAdapter::isEnhanceClientHandlerInit = false;
+    EXPECT_FALSE(SecCompEnhanceAdapter::IsClientEnhanceEnabled());
     SecCompEnhanceAdapter::isEnhanceSrvHandlerInit = false;
     SecCompEnhanceAdapter::EnhanceSrvSerialize(input, outputData);
     SecCompEnhanceAdapter::isEnhanceSrvHandlerInit = false;
@@ -121,3 +123,34 @@ HWTEST_F(SecCompEnhanceAdapterTest, EnhanceAdapter002, TestSize.Level0)
     const nlohmann::json jsonComponent;
     ASSERT_EQ(SC_OK, SecCompEnhanceAdapter::CheckComponentInfoEnhance(0, compInfo, jsonComponent));
 }
+
+/**
+ * @tc.name: EnhanceAdapter003
+ * @tc.desc: test rawdata borrows the pooled parcel buffer and is read in place
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompEnhanceAdapterTest, EnhanceAdapter003, TestSize.Level0)
+{
+    std::shared_ptr<OHOS::MessageParcel> input = SecCompEnhanceAdapter::AcquireParcel();
+    ASSERT_NE(nullptr, input);
+    ASSERT_TRUE(input->WriteInt32(1));
+    long useCount = input.use_count();
+    SecCompRawdata rawData;
+    SecCompEnhanceAdapter::isEnhanceClientHandlerInit = false;
+    ASSERT_TRUE(SecCompEnhanceAdapter::EnhanceClientSerialize(input, rawData));
+    EXPECT_EQ(reinterpret_cast<const void*>(input->GetData()), rawData.data);
+    EXPECT_EQ(useCount + 1, input.use_count());
+
+    {
+        OHOS::MessageParcel output;
+        SecCompEnhanceAdapter::isEnhanceClientHandlerInit = false;
+        ASSERT_TRUE(SecCompEnhanceAdapter::EnhanceClientDeserialize(rawData, output));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(rawData.data), output.GetData());
+        int32_t value = 0;
+        EXPECT_TRUE(output.ReadInt32(value));
+        EXPECT_EQ(1, value);
+    }
+    rawData.Reset();
+    EXPECT_EQ(useCount, input.use_count());
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,16 +16,22 @@
 #ifndef SECURITY_COMPONENT_CLIENT_H
 #define SECURITY_COMPONENT_CLIENT_H
 
+#include <atomic>
 #include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "access_token.h"
 #include "isec_comp_service.h"
+#include "nlohmann/json.hpp"
 #include "sec_comp_death_recipient.h"
 #include "sec_comp_enhance_adapter.h"
 #include "sec_comp_err.h"
 #include "sec_comp_info.h"
+#include "sec_comp_update_ring.h"
 #include "security_component_service_ipc_interface_code.h"
 
 namespace OHOS {
@@ -40,13 +46,20 @@ public:
     int32_t UnregisterWriteToRawdata(int32_t scId, SecCompRawdata& rawData);
     int32_t ReportWriteToRawdata(SecCompInfo& secCompInfo, SecCompRawdata& rawData, std::string& message);
     int32_t PreRegisterWriteToRawdata(SecCompRawdata& rawData);
+    int32_t RegisterBatchWriteToRawdata(const std::vector<SecCompRegisterItem>& items,
+        const std::vector<size_t>& indexes, SecCompRawdata& rawData);
+    int32_t UnregisterBatchWriteToRawdata(const std::vector<int32_t>& scIds, SecCompRawdata& rawData);
     int32_t RegisterSecurityComponent(SecCompType type, const std::string& componentInfo, int32_t& scId);
     int32_t UpdateSecurityComponent(int32_t scId, const std::string& componentInfo);
     int32_t UnregisterSecurityComponent(int32_t scId);
+    // items whose result is not SC_OK are skipped
+    int32_t RegisterSecurityComponents(std::vector<SecCompRegisterItem>& items);
+    int32_t UnregisterSecurityComponents(const std::vector<int32_t>& scIds, std::vector<int32_t>& results);
     int32_t ReportSecurityComponentClickEvent(SecCompInfo& secCompInfo,
         sptr<IRemoteObject> callerToken, sptr<IRemoteObject> dialogCallback, std::string& message);
     bool VerifySavePermission(AccessToken::AccessTokenID tokenId);
     int32_t PreRegisterSecCompProcess();
+    uint32_t GetComponentInfoVersion();
     bool IsServiceExist();
     bool LoadService();
     bool IsSystemAppCalling();
@@ -54,9 +67,20 @@ public:
     void FinishStartSASuccess(const sptr<IRemoteObject>& remoteObject);
     void FinishStartSAFail();
     void OnRemoteDiedHandle();
-    std::mutex useIPCMutex_;
 
 private:
+    // pairs one serialized request with its reply while an enhance client session is loaded,
+    // a waiting click report is let in before any waiting management request
+    class IpcSession final {
+    public:
+        IpcSession(SecCompClient& client, bool isClick);
+        ~IpcSession();
+    private:
+        SecCompClient& client_;
+        bool isHeld_ = false;
+        DISALLOW_COPY_AND_MOVE(IpcSession);
+    };
+
     SecCompClient();
     virtual ~SecCompClient();
     DISALLOW_COPY_AND_MOVE(SecCompClient);
@@ -70,6 +94,21 @@ private:
     void InstallProxyLocked(const sptr<IRemoteObject>& remoteObject);
     int32_t TryRegisterSecurityComponent(SecCompType type, const std::string& componentInfo,
         int32_t& scId, sptr<ISecCompService> proxy);
+    int32_t TryRegisterSecurityComponents(std::vector<SecCompRegisterItem>& items,
+        const std::vector<size_t>& indexes, sptr<ISecCompService> proxy);
+    int32_t RegisterSecurityComponentsChunk(std::vector<SecCompRegisterItem>& items,
+        const std::vector<size_t>& indexes);
+    int32_t UnregisterSecurityComponentsChunk(const std::vector<int32_t>& scIds, std::vector<int32_t>& results,
+        sptr<ISecCompService> proxy);
+    int32_t TryUpdateSecurityComponent(int32_t scId, const std::string& componentInfo,
+        sptr<ISecCompService> proxy, uint32_t& version, bool& hasVersion);
+    bool BuildUpdateDelta(int32_t scId, const std::string& componentInfo, nlohmann::json& jsonInfo,
+        std::string& deltaInfo, bool isRingBase = false);
+    void RecordUpdateDeltaBase(int32_t scId, bool hasVersion, nlohmann::json& jsonInfo, uint32_t version,
+        bool isRingBase = false);
+    void ClearRingDeltaBases();
+    void SetupUpdateChannel(uint32_t channelFlags, sptr<ISecCompService> proxy);
+    bool PushUpdateToRing(int32_t scId, const std::string& componentInfo, sptr<ISecCompService> proxy);
 
     std::mutex cvLock_;
     bool readyFlag_ = false;
@@ -81,6 +120,26 @@ private:
     std::mutex secCompSaMutex_;
     sptr<ISecCompService> proxy_ = nullptr;
     sptr<SecCompDeathRecipient> serviceDeathObserver_ = nullptr;
+    // component info format accepted by the service, negotiated in PreRegisterSecCompProcess
+    std::atomic<uint32_t> infoVersion_ {SC_INFO_VERSION_JSON};
+    // scId -> last full info accepted by the service and its version, base of the next update delta.
+    // a base left by a ring record is named by the seq of that record instead of the version.
+    struct UpdateDeltaBase {
+        nlohmann::json info;
+        uint32_t version = 0;
+        bool isRingBase = false;
+    };
+    std::mutex deltaBaseMutex_;
+    std::unordered_map<int32_t, UpdateDeltaBase> deltaBaseMap_;
+    // updates shared with the service without a binder call, set up when PreRegisterSecCompProcess offers it
+    std::mutex ringMutex_;
+    std::unique_ptr<SecCompUpdateRing> updateRing_;
+    // failed records seen in the ring, guarded by ringMutex_
+    uint32_t ringFailedNum_ = 0;
+    std::mutex sessionMutex_;
+    std::condition_variable sessionCon_;
+    bool isSessionBusy_ = false;
+    uint32_t waitingClickNum_ = 0;
 };
 }  // namespace SecurityComponent
 }  // namespace Security
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,6 +15,7 @@
 #ifndef SECURITY_COMPONENT_LOAD_CALLBACK_H
 #define SECURITY_COMPONENT_LOAD_CALLBACK_H
 
+#include <chrono>
 #include "system_ability_load_callback_stub.h"
 
 namespace OHOS {
@@ -26,6 +27,12 @@ public:
 
     void OnLoadSystemAbilitySuccess(int32_t systemAbilityId, const sptr<IRemoteObject>& remoteObject);
     void OnLoadSystemAbilityFail(int32_t systemAbilityId);
+
+private:
+    int64_t GetLoadElapsedMilliseconds() const;
+
+    // created right before LoadSystemAbility, the load latency is measured from it
+    std::chrono::steady_clock::time_point loadStartTime_;
 };
 }  // namespace SecurityComponent
 }  // namespace Security
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,6 +17,7 @@
 #include "accesstoken_kit.h"
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
+#include "sec_comp_base.h"
 #include "sec_comp_click_event_parcel.h"
 #include "sec_comp_load_callback.h"
 #include "sec_comp_log.h"
@@ -25,6 +26,7 @@
 #include "tokenid_kit.h"
 #include <algorithm>
 #include <chrono>
+#include <unistd.h>
 
 namespace OHOS {
 namespace Security {
@@ -56,6 +58,38 @@ SecCompClient& SecCompClient::GetInstance()
 SecCompClient::SecCompClient()
 {}
 
+SecCompClient::IpcSession::IpcSession(SecCompClient& client, bool isClick) : client_(client)
+{
+    // without enhance, serialization is a plain copy and requests need no pairing
+    if (!SecCompEnhanceAdapter::IsClientEnhanceEnabled()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(client_.sessionMutex_);
+    if (isClick) {
+        client_.waitingClickNum_++;
+        client_.sessionCon_.wait(lock, [this]() { return !client_.isSessionBusy_; });
+        client_.waitingClickNum_--;
+    } else {
+        client_.sessionCon_.wait(lock, [this]() {
+            return !client_.isSessionBusy_ && (client_.waitingClickNum_ == 0);
+        });
+    }
+    client_.isSessionBusy_ = true;
+    isHeld_ = true;
+}
+
+SecCompClient::IpcSession::~IpcSession()
+{
+    if (!isHeld_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(client_.sessionMutex_);
+        client_.isSessionBusy_ = false;
+    }
+    client_.sessionCon_.notify_all();
+}
+
 SecCompClient::~SecCompClient()
 {
     std::unique_lock<std::mutex> lock(proxyMutex_);
@@ -71,14 +105,14 @@ SecCompClient::~SecCompClient()
 int32_t SecCompClient::RegisterWriteToRawdata(SecCompType type, const std::string& componentInfo,
     SecCompRawdata& rawData)
 {
-    MessageParcel dataParcel;
+    std::shared_ptr<MessageParcel> dataParcel = SecCompEnhanceAdapter::AcquireParcel();
 
-    if (!dataParcel.WriteUint32(type)) {
+    if (!dataParcel->WriteUint32(type)) {
         SC_LOG_ERROR(LABEL, "Register write type failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
-    if (!dataParcel.WriteString(componentInfo)) {
+    if (!dataParcel->WriteString(componentInfo)) {
         SC_LOG_ERROR(LABEL, "Register write componentInfo failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
@@ -93,7 +127,7 @@ int32_t SecCompClient::RegisterWriteToRawdata(SecCompType type, const std::strin
 int32_t SecCompClient::TryRegisterSecurityComponent(SecCompType type, const std::string& componentInfo,
     int32_t& scId, sptr<ISecCompService> proxy)
 {
-    std::lock_guard<std::mutex> lock(useIPCMutex_);
+    IpcSession session(*this, false);
     SecCompRawdata rawData;
     if (RegisterWriteToRawdata(type, componentInfo, rawData) != SC_OK) {
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
@@ -159,26 +193,76 @@ int32_t SecCompClient::RegisterSecurityComponent(SecCompType type,
     return res;
 }
 
-int32_t SecCompClient::UpdateWriteToRawdata(int32_t scId, const std::string& componentInfo, SecCompRawdata& rawData)
+int32_t SecCompClient::RegisterBatchWriteToRawdata(const std::vector<SecCompRegisterItem>& items,
+    const std::vector<size_t>& indexes, SecCompRawdata& rawData)
 {
-    MessageParcel dataParcel;
-    if (!dataParcel.WriteInt32(scId)) {
-        SC_LOG_ERROR(LABEL, "Update write scId failed.");
+    std::shared_ptr<MessageParcel> dataParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!dataParcel->WriteUint32(static_cast<uint32_t>(indexes.size()))) {
+        SC_LOG_ERROR(LABEL, "Batch register write num failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
-    if (!dataParcel.WriteString(componentInfo)) {
-        SC_LOG_ERROR(LABEL, "Update write componentInfo failed.");
-        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+
+    for (size_t index : indexes) {
+        if (!dataParcel->WriteUint32(items[index].type) || !dataParcel->WriteString(items[index].componentInfo)) {
+            SC_LOG_ERROR(LABEL, "Batch register write component failed.");
+            return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+        }
     }
 
     if (!SecCompEnhanceAdapter::EnhanceClientSerialize(dataParcel, rawData)) {
-        SC_LOG_ERROR(LABEL, "Update serialize session info failed.");
+        SC_LOG_ERROR(LABEL, "Batch register serialize session info failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
     return SC_OK;
 }
 
-int32_t SecCompClient::UpdateSecurityComponent(int32_t scId, const std::string& componentInfo)
+int32_t SecCompClient::TryRegisterSecurityComponents(std::vector<SecCompRegisterItem>& items,
+    const std::vector<size_t>& indexes, sptr<ISecCompService> proxy)
+{
+    IpcSession session(*this, false);
+    SecCompRawdata rawData;
+    if (RegisterBatchWriteToRawdata(items, indexes, rawData) != SC_OK) {
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    SecCompRawdata rawReply;
+    int32_t res = proxy->RegisterSecurityComponents(rawData, rawReply);
+    if (res != SC_OK) {
+        SC_LOG_ERROR(LABEL, "Batch register request failed, result: %{public}d.", res);
+        return res;
+    }
+
+    MessageParcel deserializedReply;
+    if (!SecCompEnhanceAdapter::EnhanceClientDeserialize(rawReply, deserializedReply)) {
+        SC_LOG_ERROR(LABEL, "Batch register deserialize session info failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    int32_t serviceRes;
+    if (!deserializedReply.ReadInt32(serviceRes)) {
+        SC_LOG_ERROR(LABEL, "Batch register read serviceRes failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    if (serviceRes != SC_OK) {
+        return serviceRes;
+    }
+
+    uint32_t num = 0;
+    if (!deserializedReply.ReadUint32(num) || (num != indexes.size())) {
+        SC_LOG_ERROR(LABEL, "Batch register read num failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    for (size_t index : indexes) {
+        if (!deserializedReply.ReadInt32(items[index].result) || !deserializedReply.ReadInt32(items[index].scId)) {
+            SC_LOG_ERROR(LABEL, "Batch register read component result failed.");
+            return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+        }
+    }
+    return SC_OK;
+}
+
+int32_t SecCompClient::RegisterSecurityComponentsChunk(std::vector<SecCompRegisterItem>& items,
+    const std::vector<size_t>& indexes)
 {
     auto proxy = GetProxy(true);
     if (proxy == nullptr) {
@@ -186,7 +270,76 @@ int32_t SecCompClient::UpdateSecurityComponent(int32_t scId, const std::string&
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
 
-    std::lock_guard<std::mutex> lock(useIPCMutex_);
+    auto res = TryRegisterSecurityComponents(items, indexes, proxy);
+    if (std::find(RETRY_CODE_LIST.begin(), RETRY_CODE_LIST.end(), res) == RETRY_CODE_LIST.end()) {
+        return res;
+    }
+    bool waitStatus = false;
+    {
+        std::unique_lock<std::mutex> lock(secCompSaMutex_);
+        waitStatus = secCompSACon_.wait_for(lock, std::chrono::milliseconds(SA_DIED_TIME_OUT),
+            [this]() { return serviceAbilityNeedLoadFlag_; });
+    }
+    if (waitStatus) {
+        proxy = GetProxy(true);
+        if (proxy != nullptr) {
+            return TryRegisterSecurityComponents(items, indexes, proxy);
+        }
+    }
+    return res;
+}
+
+int32_t SecCompClient::RegisterSecurityComponents(std::vector<SecCompRegisterItem>& items)
+{
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < items.size(); ++i) {
+        items[i].scId = INVALID_SC_ID;
+        if (items[i].result == SC_OK) {
+            pending.emplace_back(i);
+        }
+    }
+
+    int32_t res = SC_OK;
+    for (size_t start = 0; start < pending.size(); start += SC_BATCH_MAX_NUM) {
+        size_t end = std::min(pending.size(), start + SC_BATCH_MAX_NUM);
+        std::vector<size_t> indexes(pending.begin() + start, pending.begin() + end);
+        int32_t chunkRes = RegisterSecurityComponentsChunk(items, indexes);
+        if (chunkRes == SC_OK) {
+            continue;
+        }
+        for (size_t index : indexes) {
+            items[index].result = chunkRes;
+            items[index].scId = INVALID_SC_ID;
+        }
+        res = (res == SC_OK) ? chunkRes : res;
+    }
+    return res;
+}
+
+int32_t SecCompClient::UpdateWriteToRawdata(int32_t scId, const std::string& componentInfo, SecCompRawdata& rawData)
+{
+    std::shared_ptr<MessageParcel> dataParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!dataParcel->WriteInt32(scId)) {
+        SC_LOG_ERROR(LABEL, "Update write scId failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    if (!dataParcel->WriteString(componentInfo)) {
+        SC_LOG_ERROR(LABEL, "Update write componentInfo failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    if (!SecCompEnhanceAdapter::EnhanceClientSerialize(dataParcel, rawData)) {
+        SC_LOG_ERROR(LABEL, "Update serialize session info failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    return SC_OK;
+}
+
+int32_t SecCompClient::TryUpdateSecurityComponent(int32_t scId, const std::string& componentInfo,
+    sptr<ISecCompService> proxy, uint32_t& version, bool& hasVersion)
+{
+    hasVersion = false;
+    IpcSession session(*this, false);
     SecCompRawdata rawData;
     int32_t res = UpdateWriteToRawdata(scId, componentInfo, rawData);
     if (res != SC_OK) {
@@ -213,14 +366,149 @@ int32_t SecCompClient::UpdateSecurityComponent(int32_t scId, const std::string&
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
+    // old service replies without version, no delta is built on it
+    hasVersion = (serviceRes == SC_OK) && deserializedReply.ReadUint32(version);
     return serviceRes;
 }
 
+bool SecCompClient::BuildUpdateDelta(int32_t scId, const std::string& componentInfo, nlohmann::json& jsonInfo,
+    std::string& deltaInfo, bool isRingBase)
+{
+    if ((infoVersion_.load() < SC_INFO_VERSION_DELTA) || SecCompBase::IsBinaryInfo(componentInfo)) {
+        return false;
+    }
+    jsonInfo = nlohmann::json::parse(componentInfo, nullptr, false);
+    if (jsonInfo.is_discarded() || !jsonInfo.is_object()) {
+        jsonInfo = nullptr;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(deltaBaseMutex_);
+    auto iter = deltaBaseMap_.find(scId);
+    if ((iter == deltaBaseMap_.end()) || (iter->second.isRingBase != isRingBase) ||
+        (iter->second.info.size() != jsonInfo.size())) {
+        return false;
+    }
+    const nlohmann::json& baseInfo = iter->second.info;
+    nlohmann::json jsonDelta = nlohmann::json {
+        { JsonTagConstants::JSON_BASE_VERSION_TAG, iter->second.version }
+    };
+    for (const auto& item : jsonInfo.items()) {
+        auto baseItem = baseInfo.find(item.key());
+        if ((baseItem != baseInfo.end()) && (*baseItem == item.value())) {
+            continue;
+        }
+        if ((baseItem == baseInfo.end()) || !SecCompBase::IsDeltaTag(item.key())) {
+            return false;
+        }
+        jsonDelta[item.key()] = item.value();
+    }
+    // rect is adjusted with its window rect by service, they are always sent together
+    if (jsonDelta.contains(JsonTagConstants::JSON_RECT) || jsonDelta.contains(JsonTagConstants::JSON_WINDOW_RECT)) {
+        jsonDelta[JsonTagConstants::JSON_RECT] = jsonInfo[JsonTagConstants::JSON_RECT];
+        jsonDelta[JsonTagConstants::JSON_WINDOW_RECT] = jsonInfo[JsonTagConstants::JSON_WINDOW_RECT];
+    }
+    deltaInfo.assign(1, static_cast<char>(SC_DELTA_MAGIC));
+    deltaInfo += jsonDelta.dump();
+    return true;
+}
+
+void SecCompClient::RecordUpdateDeltaBase(int32_t scId, bool hasVersion, nlohmann::json& jsonInfo,
+    uint32_t version, bool isRingBase)
+{
+    std::lock_guard<std::mutex> lock(deltaBaseMutex_);
+    if (!hasVersion || jsonInfo.is_null()) {
+        deltaBaseMap_.erase(scId);
+        return;
+    }
+    UpdateDeltaBase& base = deltaBaseMap_[scId];
+    base.info = std::move(jsonInfo);
+    base.version = version;
+    base.isRingBase = isRingBase;
+}
+
+void SecCompClient::ClearRingDeltaBases()
+{
+    std::lock_guard<std::mutex> lock(deltaBaseMutex_);
+    for (auto iter = deltaBaseMap_.begin(); iter != deltaBaseMap_.end();) {
+        if (iter->second.isRingBase) {
+            iter = deltaBaseMap_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+bool SecCompClient::PushUpdateToRing(int32_t scId, const std::string& componentInfo, sptr<ISecCompService> proxy)
+{
+    bool needDoorbell = false;
+    {
+        std::lock_guard<std::mutex> lock(ringMutex_);
+        if (updateRing_ == nullptr) {
+            return false;
+        }
+        if (updateRing_->IsClosed()) {
+            SC_LOG_ERROR(LABEL, "Update ring is closed by service, fall back to binder update.");
+            updateRing_ = nullptr;
+            ClearRingDeltaBases();
+            return false;
+        }
+        // a failed record breaks the delta chain of its component, every component sends full info once
+        uint32_t failedNum = updateRing_->GetFailedNum();
+        if (failedNum != ringFailedNum_) {
+            ringFailedNum_ = failedNum;
+            ClearRingDeltaBases();
+        }
+        nlohmann::json jsonInfo;
+        std::string deltaInfo;
+        bool isDelta = BuildUpdateDelta(scId, componentInfo, jsonInfo, deltaInfo, true);
+        uint32_t seq = updateRing_->GetNextSeq();
+        if (!updateRing_->Push(scId, isDelta ? deltaInfo : componentInfo, needDoorbell)) {
+            return false;
+        }
+        RecordUpdateDeltaBase(scId, true, jsonInfo, seq, true);
+    }
+    // an idle service is woken up by a oneway call, a busy one drains the ring by itself
+    if (needDoorbell && (proxy->NotifyUpdateChannel() != SC_OK)) {
+        SC_LOG_WARN(LABEL, "Notify update channel failed.");
+    }
+    return true;
+}
+
+int32_t SecCompClient::UpdateSecurityComponent(int32_t scId, const std::string& componentInfo)
+{
+    auto proxy = GetProxy(true);
+    if (proxy == nullptr) {
+        SC_LOG_ERROR(LABEL, "Proxy is null.");
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+
+    // result of a ring update is reported by the next binder call of the component, a full ring falls back to it
+    if (PushUpdateToRing(scId, componentInfo, proxy)) {
+        return SC_OK;
+    }
+
+    nlohmann::json jsonInfo;
+    std::string deltaInfo;
+    uint32_t version = 0;
+    bool hasVersion = false;
+    int32_t res = SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL;
+    if (BuildUpdateDelta(scId, componentInfo, jsonInfo, deltaInfo)) {
+        res = TryUpdateSecurityComponent(scId, deltaInfo, proxy, version, hasVersion);
+    }
+    // no delta or its base is stale, send the full info
+    if (res == SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL) {
+        res = TryUpdateSecurityComponent(scId, componentInfo, proxy, version, hasVersion);
+    }
+    RecordUpdateDeltaBase(scId, hasVersion, jsonInfo, version);
+    return res;
+}
+
 int32_t SecCompClient::UnregisterWriteToRawdata(int32_t scId, SecCompRawdata& rawData)
 {
-    MessageParcel dataParcel;
+    std::shared_ptr<MessageParcel> dataParcel = SecCompEnhanceAdapter::AcquireParcel();
 
-    if (!dataParcel.WriteInt32(scId)) {
+    if (!dataParcel->WriteInt32(scId)) {
         SC_LOG_ERROR(LABEL, "Unregister write scId failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
@@ -240,7 +528,11 @@ int32_t SecCompClient::UnregisterSecurityComponent(int32_t scId)
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
 
-    std::lock_guard<std::mutex> lock(useIPCMutex_);
+    IpcSession session(*this, false);
+    {
+        std::lock_guard<std::mutex> baseLock(deltaBaseMutex_);
+        deltaBaseMap_.erase(scId);
+    }
     SecCompRawdata rawData;
     int32_t res = UnregisterWriteToRawdata(scId, rawData);
     if (res != SC_OK) {
@@ -270,21 +562,122 @@ int32_t SecCompClient::UnregisterSecurityComponent(int32_t scId)
     return serviceRes;
 }
 
+int32_t SecCompClient::UnregisterBatchWriteToRawdata(const std::vector<int32_t>& scIds, SecCompRawdata& rawData)
+{
+    std::shared_ptr<MessageParcel> dataParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!dataParcel->WriteUint32(static_cast<uint32_t>(scIds.size()))) {
+        SC_LOG_ERROR(LABEL, "Batch unregister write num failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    for (int32_t scId : scIds) {
+        if (!dataParcel->WriteInt32(scId)) {
+            SC_LOG_ERROR(LABEL, "Batch unregister write scId failed.");
+            return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+        }
+    }
+
+    if (!SecCompEnhanceAdapter::EnhanceClientSerialize(dataParcel, rawData)) {
+        SC_LOG_ERROR(LABEL, "Batch unregister serialize session info failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    return SC_OK;
+}
+
+int32_t SecCompClient::UnregisterSecurityComponentsChunk(const std::vector<int32_t>& scIds,
+    std::vector<int32_t>& results, sptr<ISecCompService> proxy)
+{
+    IpcSession session(*this, false);
+    SecCompRawdata rawData;
+    int32_t res = UnregisterBatchWriteToRawdata(scIds, rawData);
+    if (res != SC_OK) {
+        return res;
+    }
+
+    SecCompRawdata rawReply;
+    res = proxy->UnregisterSecurityComponents(rawData, rawReply);
+    if (res != SC_OK) {
+        SC_LOG_ERROR(LABEL, "Batch unregister request failed, result: %{public}d.", res);
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    MessageParcel deserializedReply;
+    if (!SecCompEnhanceAdapter::EnhanceClientDeserialize(rawReply, deserializedReply)) {
+        SC_LOG_ERROR(LABEL, "Batch unregister deserialize session info failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    int32_t serviceRes;
+    if (!deserializedReply.ReadInt32(serviceRes)) {
+        SC_LOG_ERROR(LABEL, "Batch unregister read res failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    if (serviceRes != SC_OK) {
+        return serviceRes;
+    }
+
+    uint32_t num = 0;
+    if (!deserializedReply.ReadUint32(num) || (num != scIds.size())) {
+        SC_LOG_ERROR(LABEL, "Batch unregister read num failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    results.resize(num);
+    for (auto& result : results) {
+        if (!deserializedReply.ReadInt32(result)) {
+            SC_LOG_ERROR(LABEL, "Batch unregister read component result failed.");
+            return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+        }
+    }
+    return SC_OK;
+}
+
+int32_t SecCompClient::UnregisterSecurityComponents(const std::vector<int32_t>& scIds,
+    std::vector<int32_t>& results)
+{
+    results.assign(scIds.size(), SC_OK);
+    auto proxy = GetProxy(true);
+    if (proxy == nullptr) {
+        SC_LOG_ERROR(LABEL, "Proxy is null");
+        results.assign(scIds.size(), SC_SERVICE_ERROR_VALUE_INVALID);
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+
+    {
+        std::lock_guard<std::mutex> baseLock(deltaBaseMutex_);
+        for (int32_t scId : scIds) {
+            deltaBaseMap_.erase(scId);
+        }
+    }
+    int32_t res = SC_OK;
+    for (size_t start = 0; start < scIds.size(); start += SC_BATCH_MAX_NUM) {
+        size_t end = std::min(scIds.size(), start + SC_BATCH_MAX_NUM);
+        std::vector<int32_t> chunk(scIds.begin() + start, scIds.begin() + end);
+        std::vector<int32_t> chunkResults;
+        int32_t chunkRes = UnregisterSecurityComponentsChunk(chunk, chunkResults, proxy);
+        if (chunkRes != SC_OK) {
+            chunkResults.assign(chunk.size(), chunkRes);
+            res = (res == SC_OK) ? chunkRes : res;
+        }
+        std::copy(chunkResults.begin(), chunkResults.end(), results.begin() + start);
+    }
+    return res;
+}
+
 int32_t SecCompClient::ReportWriteToRawdata(SecCompInfo& secCompInfo, SecCompRawdata& rawData, std::string& message)
 {
-    MessageParcel dataParcel;
+    std::shared_ptr<MessageParcel> dataParcel = SecCompEnhanceAdapter::AcquireParcel();
 
-    if (!dataParcel.WriteInt32(secCompInfo.scId)) {
+    if (!dataParcel->WriteInt32(secCompInfo.scId)) {
         SC_LOG_ERROR(LABEL, "Report write scId failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
-    if (!dataParcel.WriteString(secCompInfo.componentInfo)) {
+    if (!dataParcel->WriteString(secCompInfo.componentInfo)) {
         SC_LOG_ERROR(LABEL, "Report write componentInfo failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
-    if (!dataParcel.WriteString(message)) {
+    if (!dataParcel->WriteString(message)) {
         SC_LOG_ERROR(LABEL, "Report write message failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
@@ -295,7 +688,7 @@ int32_t SecCompClient::ReportWriteToRawdata(SecCompInfo& secCompInfo, SecCompRaw
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
     parcel->clickInfoParams_ = secCompInfo.clickInfo;
-    if (!dataParcel.WriteParcelable(parcel)) {
+    if (!dataParcel->WriteParcelable(parcel)) {
         SC_LOG_ERROR(LABEL, "Report write clickInfo failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
@@ -316,7 +709,7 @@ int32_t SecCompClient::ReportSecurityComponentClickEvent(SecCompInfo& secCompInf
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
 
-    std::lock_guard<std::mutex> lock(useIPCMutex_);
+    IpcSession session(*this, true);
     SecCompRawdata rawData;
     int32_t res = ReportWriteToRawdata(secCompInfo, rawData, message);
     if (res != SC_OK) {
@@ -374,7 +767,12 @@ bool SecCompClient::IsSystemAppCalling()
 
 int32_t SecCompClient::PreRegisterWriteToRawdata(SecCompRawdata& rawData)
 {
-    MessageParcel dataParcel;
+    std::shared_ptr<MessageParcel> dataParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!dataParcel->WriteUint32(SC_INFO_VERSION_DELTA)) {
+        SC_LOG_ERROR(LABEL, "PreRegister write info version failed.");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
     if (!SecCompEnhanceAdapter::EnhanceClientSerialize(dataParcel, rawData)) {
         SC_LOG_ERROR(LABEL, "PreRegister serialize session info failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
@@ -390,7 +788,7 @@ int32_t SecCompClient::PreRegisterSecCompProcess()
         SC_LOG_ERROR(LABEL, "Proxy is null");
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
-    std::lock_guard<std::mutex> lock(useIPCMutex_);
+    IpcSession session(*this, false);
     SecCompRawdata rawData;
     int32_t res = PreRegisterWriteToRawdata(rawData);
     if (res != SC_OK) {
@@ -416,9 +814,50 @@ int32_t SecCompClient::PreRegisterSecCompProcess()
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
+    // old service replies without info version and only knows json
+    uint32_t infoVersion = SC_INFO_VERSION_JSON;
+    if ((serviceRes != SC_OK) || !deserializedReply.ReadUint32(infoVersion)) {
+        infoVersion = SC_INFO_VERSION_JSON;
+    }
+    infoVersion_ = infoVersion;
+
+    // old service offers no update channel
+    uint32_t channelFlags = 0;
+    if ((serviceRes == SC_OK) && deserializedReply.ReadUint32(channelFlags)) {
+        SetupUpdateChannel(channelFlags, proxy);
+    }
     return serviceRes;
 }
 
+void SecCompClient::SetupUpdateChannel(uint32_t channelFlags, sptr<ISecCompService> proxy)
+{
+    std::lock_guard<std::mutex> lock(ringMutex_);
+    if ((updateRing_ != nullptr) || ((channelFlags & SC_CHANNEL_UPDATE_RING) == 0) ||
+        SecCompEnhanceAdapter::IsClientEnhanceEnabled()) {
+        return;
+    }
+    int32_t fd = -1;
+    std::unique_ptr<SecCompUpdateRing> ring = SecCompUpdateRing::CreateProducer(SC_UPDATE_RING_CAPACITY, fd);
+    if (ring == nullptr) {
+        SC_LOG_ERROR(LABEL, "Create update ring failed.");
+        return;
+    }
+    int32_t res = proxy->SetupUpdateChannel(fd);
+    // the parcel has sent its own copy of fd
+    close(fd);
+    if (res != SC_OK) {
+        SC_LOG_ERROR(LABEL, "Setup update channel failed, result: %{public}d.", res);
+        return;
+    }
+    updateRing_ = std::move(ring);
+    ringFailedNum_ = 0;
+}
+
+uint32_t SecCompClient::GetComponentInfoVersion()
+{
+    return infoVersion_.load();
+}
+
 static sptr<IRemoteObject> GetServiceHandler()
 {
     auto sam = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
@@ -542,6 +981,15 @@ void SecCompClient::OnRemoteDiedHandle()
     }
     proxy_ = nullptr;
     serviceDeathObserver_ = nullptr;
+    infoVersion_ = SC_INFO_VERSION_JSON;
+    {
+        std::lock_guard<std::mutex> lock1(deltaBaseMutex_);
+        deltaBaseMap_.clear();
+    }
+    {
+        std::lock_guard<std::mutex> lock1(ringMutex_);
+        updateRing_ = nullptr;
+    }
     {
         std::unique_lock<std::mutex> lock1(cvLock_);
         readyFlag_ = false;
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -105,6 +105,60 @@ int32_t SecCompKit::UnregisterSecurityComponent(int32_t scId)
     return res;
 }
 
+SECURITY_COMPONENT_API_CALLER
+__attribute__((noinline)) int32_t SecCompKit::RegisterSecurityComponents(std::vector<SecCompRegisterItem>& items)
+{
+    if (!SecCompCallerAuthorization::GetInstance().IsKitCaller(
+        reinterpret_cast<uintptr_t>(__builtin_return_address(0)))) {
+        SC_LOG_ERROR(LABEL, "register security components fail, caller invalid");
+        int32_t uid = IPCSkeleton::GetCallingUid();
+        OHOS::AppExecFwk::BundleMgrClient bmsClient;
+        std::string bundleName = "";
+        bmsClient.GetNameForUid(uid, bundleName);
+        HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "CALLER_CHECK_FAILED",
+            HiviewDFX::HiSysEvent::EventType::SECURITY, "CALLER_UID", uid, "CALLER_BUNDLE_NAME", bundleName,
+            "CALLER_PID", IPCSkeleton::GetCallingRealPid(), "CALL_SCENE", "REGISTER");
+        return SC_SERVICE_ERROR_CALLER_INVALID;
+    }
+
+    for (auto& item : items) {
+        item.scId = INVALID_SC_ID;
+        if ((item.result == SC_OK) && !SecCompEnhanceAdapter::EnhanceDataPreprocess(item.componentInfo)) {
+            SC_LOG_ERROR(LABEL, "Preprocess security component fail");
+            item.result = SC_ENHANCE_ERROR_VALUE_INVALID;
+        }
+    }
+
+    int32_t res = SecCompClient::GetInstance().RegisterSecurityComponents(items);
+    if (res != SC_OK) {
+        SC_LOG_ERROR(LABEL, "register security components fail, error: %{public}d", res);
+    }
+    for (const auto& item : items) {
+        if (item.result == SC_OK) {
+            SecCompEnhanceAdapter::RegisterScIdEnhance(item.scId);
+        }
+    }
+    return res;
+}
+
+SECURITY_COMPONENT_API_CALLER
+int32_t SecCompKit::UnregisterSecurityComponents(const std::vector<int32_t>& scIds, std::vector<int32_t>& results)
+{
+    int32_t res = SecCompClient::GetInstance().UnregisterSecurityComponents(scIds, results);
+    if (res != SC_OK) {
+        SC_LOG_ERROR(LABEL, "unregister security components fail, error: %{public}d", res);
+    }
+    for (size_t i = 0; i < scIds.size(); ++i) {
+        SecCompEnhanceAdapter::UnregisterScIdEnhance(scIds[i]);
+        if ((i < results.size()) && (results[i] == SC_OK)) {
+            HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "UNREGISTER_SUCCESS",
+                HiviewDFX::HiSysEvent::EventType::BEHAVIOR, "CALLER_UID", IPCSkeleton::GetCallingUid(),
+                "CALLER_PID", IPCSkeleton::GetCallingRealPid(), "SC_ID", scIds[i]);
+        }
+    }
+    return res;
+}
+
 SECURITY_COMPONENT_API_CALLER
 __attribute__((noinline)) int32_t SecCompKit::ReportSecurityComponentClickEvent(SecCompInfo& secCompInfo,
     sptr<IRemoteObject> callerToken, OnFirstUseDialogCloseFunc&& callback, std::string& message)
@@ -161,6 +215,11 @@ int32_t SecCompKit::PreRegisterSecCompProcess()
     return SecCompClient::GetInstance().PreRegisterSecCompProcess();
 }
 
+uint32_t SecCompKit::GetComponentInfoVersion()
+{
+    return SecCompClient::GetInstance().GetComponentInfoVersion();
+}
+
 bool SecCompKit::IsServiceExist()
 {
     return SecCompClient::GetInstance().IsServiceExist();
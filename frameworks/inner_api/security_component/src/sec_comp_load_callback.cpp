@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -25,7 +25,13 @@ namespace {
 static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompClient"};
 constexpr int32_t SA_ID_SECURITY_COMPONENT_SERVICE = 3506;
 }  // namespace
-SecCompLoadCallback::SecCompLoadCallback() {}
+SecCompLoadCallback::SecCompLoadCallback() : loadStartTime_(std::chrono::steady_clock::now()) {}
+
+int64_t SecCompLoadCallback::GetLoadElapsedMilliseconds() const
+{
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - loadStartTime_).count());
+}
 
 void SecCompLoadCallback::OnLoadSystemAbilitySuccess(
     int32_t systemAbilityId, const sptr<IRemoteObject>& remoteObject)
@@ -41,7 +47,8 @@ void SecCompLoadCallback::OnLoadSystemAbilitySuccess(
         return;
     }
 
-    SC_LOG_INFO(LABEL, "Start systemAbilityId: %{public}d success!", systemAbilityId);
+    SC_LOG_INFO(LABEL, "Start systemAbilityId: %{public}d success in %{public}lld ms!",
+        systemAbilityId, static_cast<long long>(GetLoadElapsedMilliseconds()));
 
     SecCompClient::GetInstance().FinishStartSASuccess(remoteObject);
 }
@@ -53,7 +60,8 @@ void SecCompLoadCallback::OnLoadSystemAbilityFail(int32_t systemAbilityId)
         return;
     }
 
-    SC_LOG_ERROR(LABEL, "Start systemAbilityId: %{public}d failed.", systemAbilityId);
+    SC_LOG_ERROR(LABEL, "Start systemAbilityId: %{public}d failed in %{public}lld ms.",
+        systemAbilityId, static_cast<long long>(GetLoadElapsedMilliseconds()));
 
     SecCompClient::GetInstance().FinishStartSAFail();
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,6 +14,7 @@
  */
 #include "location_button_test.h"
 
+#include <cmath>
 #include <string>
 #include "sec_comp_log.h"
 #include "sec_comp_err.h"
@@ -26,6 +27,8 @@ using namespace OHOS::Security::SecurityComponent;
 namespace {
 static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
     LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "LocationButtonTest"};
+static const std::string TEST_PARENT_TAG = "Column";
+static const std::string TEST_UNKNOWN_TAG = "unknown";
 }
 
 void LocationButtonTest::SetUpTestCase()
@@ -236,3 +239,184 @@ HWTEST_F(LocationButtonTest, IsCorrespondenceType001, TestSize.Level1)
     button.type_ = SAVE_COMPONENT;
     EXPECT_FALSE(button.IsCorrespondenceType());
 }
+
+/**
+ * @tc.name: FromBinary001
+ * @tc.desc: Test binary component info round trip
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LocationButtonTest, FromBinary001, TestSize.Level1)
+{
+    nlohmann::json jsonComponent;
+    TestCommon::BuildLocationComponentInfo(jsonComponent);
+    jsonComponent[JsonTagConstants::JSON_PARENT_TAG][JsonTagConstants::JSON_PARENT_TAG_TAG] = TEST_PARENT_TAG;
+    LocationButton button;
+    std::string message;
+    ASSERT_TRUE(button.FromJson(jsonComponent, message, false));
+
+    uint8_t buf[SC_BINARY_MAX_SIZE] = { 0 };
+    size_t len = 0;
+    ASSERT_TRUE(button.ToBinary(buf, sizeof(buf), len));
+    EXPECT_TRUE(SecCompBase::IsBinaryInfo(std::string(reinterpret_cast<char*>(buf), len)));
+    EXPECT_FALSE(SecCompBase::IsBinaryInfo(jsonComponent.dump()));
+    EXPECT_LT(len, jsonComponent.dump().size());
+
+    LocationButton decoded;
+    ASSERT_TRUE(decoded.FromBinary(buf, len, message, false));
+    EXPECT_EQ(button.ToJsonStr(), decoded.ToJsonStr());
+    EXPECT_EQ(TEST_PARENT_TAG, decoded.parentTag_);
+    EXPECT_TRUE(decoded.CompareComponentBasicInfo(&button, true));
+}
+
+/**
+ * @tc.name: FromBinary002
+ * @tc.desc: Test invalid binary component info
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LocationButtonTest, FromBinary002, TestSize.Level1)
+{
+    nlohmann::json jsonComponent;
+    TestCommon::BuildLocationComponentInfo(jsonComponent);
+    LocationButton button;
+    std::string message;
+    ASSERT_TRUE(button.FromJson(jsonComponent, message, false));
+
+    uint8_t buf[SC_BINARY_MAX_SIZE] = { 0 };
+    size_t len = 0;
+    EXPECT_FALSE(button.ToBinary(nullptr, sizeof(buf), len));
+    EXPECT_FALSE(button.ToBinary(buf, 1, len));
+    ASSERT_TRUE(button.ToBinary(buf, sizeof(buf), len));
+
+    LocationButton decoded;
+    EXPECT_FALSE(decoded.FromBinary(nullptr, len, message, false));
+    EXPECT_FALSE(decoded.FromBinary(buf, len - 1, message, false));
+    buf[1] = SC_INFO_VERSION_BINARY + 1;
+    EXPECT_FALSE(decoded.FromBinary(buf, len, message, false));
+
+    button.fontSize_ = std::nan("");
+    ASSERT_TRUE(button.ToBinary(buf, sizeof(buf), len));
+    EXPECT_FALSE(decoded.FromBinary(buf, len, message, false));
+
+    button.fontSize_ = TestCommon::TEST_SIZE;
+    button.text_ = UNKNOWN_TEXT;
+    ASSERT_TRUE(button.ToBinary(buf, sizeof(buf), len));
+    EXPECT_FALSE(decoded.FromBinary(buf, len, message, false));
+
+    button.parentTag_ = std::string(SC_BINARY_MAX_PARENT_TAG_LEN + 1, 'a');
+    EXPECT_FALSE(button.ToBinary(buf, sizeof(buf), len));
+}
+
+/**
+ * @tc.name: FromJsonDelta001
+ * @tc.desc: Test patch component info with update delta
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LocationButtonTest, FromJsonDelta001, TestSize.Level1)
+{
+    nlohmann::json jsonComponent;
+    TestCommon::BuildLocationComponentInfo(jsonComponent);
+    LocationButton button;
+    std::string message;
+    ASSERT_TRUE(button.FromJson(jsonComponent, message, false));
+
+    bool isRectChanged = false;
+    EXPECT_FALSE(button.FromJsonDelta(nlohmann::json::array(), isRectChanged));
+    nlohmann::json jsonDelta;
+    jsonDelta[JsonTagConstants::JSON_BASE_VERSION_TAG] = 1;
+    jsonDelta[JsonTagConstants::JSON_RECT] = jsonComponent[JsonTagConstants::JSON_RECT];
+    jsonDelta[JsonTagConstants::JSON_RECT][JsonTagConstants::JSON_RECT_Y] = TestCommon::TEST_COORDINATE + 1;
+    EXPECT_FALSE(button.FromJsonDelta(jsonDelta, isRectChanged));
+
+    jsonDelta[JsonTagConstants::JSON_WINDOW_RECT] = jsonComponent[JsonTagConstants::JSON_WINDOW_RECT];
+    jsonDelta[JsonTagConstants::JSON_PARENT_TAG] = jsonComponent[JsonTagConstants::JSON_PARENT_TAG];
+    jsonDelta[JsonTagConstants::JSON_PARENT_TAG][JsonTagConstants::JSON_TOP_CLIP_TAG] = TestCommon::TEST_DIMENSION;
+    ASSERT_TRUE(button.FromJsonDelta(jsonDelta, isRectChanged));
+    EXPECT_TRUE(isRectChanged);
+    EXPECT_EQ(TestCommon::TEST_COORDINATE + 1, button.rect_.y_);
+    EXPECT_EQ(TestCommon::TEST_DIMENSION, button.topClip_);
+    EXPECT_EQ(TestCommon::TEST_SIZE, button.fontSize_);
+
+    jsonDelta[JsonTagConstants::JSON_SIZE_TAG] = jsonComponent[JsonTagConstants::JSON_SIZE_TAG];
+    EXPECT_FALSE(button.FromJsonDelta(jsonDelta, isRectChanged));
+}
+
+/**
+ * @tc.name: FromJsonText001
+ * @tc.desc: Test sax parsing gets the same component as FromJson
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LocationButtonTest, FromJsonText001, TestSize.Level1)
+{
+    nlohmann::json jsonComponent;
+    TestCommon::BuildLocationComponentInfo(jsonComponent);
+    jsonComponent[JsonTagConstants::JSON_PARENT_TAG][JsonTagConstants::JSON_PARENT_TAG_TAG] = TEST_PARENT_TAG;
+    LocationButton button;
+    std::string message;
+    ASSERT_TRUE(button.FromJson(jsonComponent, message, false));
+
+    LocationButton textButton;
+    ASSERT_TRUE(textButton.FromJsonText(jsonComponent.dump(), message, false));
+    EXPECT_EQ(button.ToJsonStr(), textButton.ToJsonStr());
+    EXPECT_EQ(TEST_PARENT_TAG, textButton.parentTag_);
+    EXPECT_EQ(button.borderRadius_.leftTop, textButton.rect_.borderRadius_.leftTop);
+
+    // unknown tags are skipped as FromJson does
+    jsonComponent[TEST_UNKNOWN_TAG] = nlohmann::json::array({ 1, nlohmann::json { { TEST_UNKNOWN_TAG, "a" } } });
+    jsonComponent[JsonTagConstants::JSON_STYLE_TAG][TEST_UNKNOWN_TAG] = nlohmann::json::object();
+    LocationButton unknownButton;
+    ASSERT_TRUE(unknownButton.FromJsonText(jsonComponent.dump(), message, false));
+    EXPECT_EQ(button.ToJsonStr(), unknownButton.ToJsonStr());
+}
+
+/**
+ * @tc.name: FromJsonText002
+ * @tc.desc: Test sax parsing with invalid json text
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(LocationButtonTest, FromJsonText002, TestSize.Level1)
+{
+    nlohmann::json jsonComponent;
+    TestCommon::BuildLocationComponentInfo(jsonComponent);
+    std::string jsonStr = jsonComponent.dump();
+    std::string message;
+    LocationButton button;
+    EXPECT_FALSE(button.FromJsonText("", message, false));
+    EXPECT_FALSE(button.FromJsonText("[]", message, false));
+    EXPECT_FALSE(button.FromJsonText("1", message, false));
+    EXPECT_FALSE(button.FromJsonText(jsonStr.substr(0, jsonStr.size() - 1), message, false));
+    EXPECT_FALSE(button.FromJsonText(jsonStr + "}", message, false));
+    EXPECT_FALSE(button.FromJsonText(std::string(SC_JSON_MAX_SIZE, ' ') + jsonStr, message, false));
+
+    nlohmann::json jsonInvalid = jsonComponent;
+    jsonInvalid.erase(JsonTagConstants::JSON_NODE_ID);
+    EXPECT_FALSE(button.FromJsonText(jsonInvalid.dump(), message, false));
+
+    jsonInvalid = jsonComponent;
+    jsonInvalid[JsonTagConstants::JSON_RECT][JsonTagConstants::JSON_RECT_X] = 1;
+    EXPECT_FALSE(button.FromJsonText(jsonInvalid.dump(), message, false));
+
+    jsonInvalid = jsonComponent;
+    jsonInvalid[JsonTagConstants::JSON_SC_TYPE] = UNKNOWN_SC_TYPE;
+    EXPECT_FALSE(button.FromJsonText(jsonInvalid.dump(), message, false));
+
+    jsonInvalid = jsonComponent;
+    jsonInvalid[JsonTagConstants::JSON_STYLE_TAG] = 1;
+    EXPECT_FALSE(button.FromJsonText(jsonInvalid.dump(), message, false));
+
+    jsonInvalid = jsonComponent;
+    jsonInvalid[JsonTagConstants::JSON_NODE_ID] = nlohmann::json::array();
+    EXPECT_FALSE(button.FromJsonText(jsonInvalid.dump(), message, false));
+
+    jsonInvalid = jsonComponent;
+    nlohmann::json jsonNested = nlohmann::json::object();
+    for (size_t i = 0; i < SC_JSON_MAX_DEPTH; ++i) {
+        jsonNested = nlohmann::json { { TEST_UNKNOWN_TAG, jsonNested } };
+    }
+    jsonInvalid[TEST_UNKNOWN_TAG] = jsonNested;
+    EXPECT_FALSE(button.FromJsonText(jsonInvalid.dump(), message, false));
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -35,6 +35,30 @@ namespace {
 static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
     LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompKitTest"};
 constexpr int32_t SA_ID_SECURITY_COMPONENT_SERVICE = 3506;
+constexpr int32_t TEST_SC_ID = 1;
+
+class TestClientEnhance : public SecCompClientEnhanceInterface {
+public:
+    bool EnhanceDataPreprocess(const uintptr_t caller, std::string& componentInfo) override
+    {
+        return true;
+    }
+    bool EnhanceDataPreprocess(const uintptr_t caller, int32_t scId, std::string& componentInfo) override
+    {
+        return true;
+    }
+    bool EnhanceClientSerialize(const uintptr_t caller, OHOS::MessageParcel& input, SecCompRawdata& output) override
+    {
+        return true;
+    }
+    bool EnhanceClientDeserialize(const uintptr_t caller, SecCompRawdata& input, OHOS::MessageParcel& output) override
+    {
+        return true;
+    }
+    void RegisterScIdEnhance(const uintptr_t caller, int32_t scId) override {}
+    void UnregisterScIdEnhance(const uintptr_t caller, int32_t scId) override {}
+    void Update() override {}
+};
 
 static void TestInCallerNotCheckList() __attribute__((noinline, aligned(8192)));
 static void TestInCallerCheckList() __attribute__((noinline, aligned(8192)));
@@ -50,8 +74,11 @@ static void TestInCallerNotCheckList()
     SecCompInfo secCompInfo{ scId, emptyStr, click };
     std::string message;
     int reportRes = SecCompKit::ReportSecurityComponentClickEvent(secCompInfo, nullptr, std::move(func), message);
+    std::vector<SecCompRegisterItem> items(1);
+    int batchRes = SecCompKit::RegisterSecurityComponents(items);
 
     EXPECT_EQ(registerRes, SC_SERVICE_ERROR_CALLER_INVALID);
+    EXPECT_EQ(batchRes, SC_SERVICE_ERROR_CALLER_INVALID);
     EXPECT_EQ(updateRes, SC_SERVICE_ERROR_CALLER_INVALID);
     EXPECT_EQ(reportRes, SC_SERVICE_ERROR_CALLER_INVALID);
 }
@@ -67,8 +94,11 @@ static void TestInCallerCheckList()
     SecCompInfo secCompInfo{ scId, emptyStr, click };
     std::string message;
     int reportRes = SecCompKit::ReportSecurityComponentClickEvent(secCompInfo, nullptr, std::move(func), message);
+    std::vector<SecCompRegisterItem> items(1);
+    int batchRes = SecCompKit::RegisterSecurityComponents(items);
 
     EXPECT_NE(registerRes, SC_SERVICE_ERROR_CALLER_INVALID);
+    EXPECT_NE(batchRes, SC_SERVICE_ERROR_CALLER_INVALID);
     EXPECT_NE(updateRes, SC_SERVICE_ERROR_CALLER_INVALID);
     EXPECT_NE(reportRes, SC_SERVICE_ERROR_CALLER_INVALID);
 }
@@ -329,3 +359,118 @@ HWTEST_F(SecCompKitTest, LoadService001, TestSize.Level0)
     EXPECT_EQ(true, SecCompKit::LoadService());
     EXPECT_EQ(true, SecCompKit::IsServiceExist());
 }
+
+/**
+ * @tc.name: BuildUpdateDelta001
+ * @tc.desc: Test update delta is only built on a known base with rect or parent changes
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompKitTest, BuildUpdateDelta001, TestSize.Level0)
+{
+    SecCompClient& client = SecCompClient::GetInstance();
+    nlohmann::json jsonComponent;
+    TestCommon::BuildLocationComponentInfo(jsonComponent);
+    std::string baseInfo = jsonComponent.dump();
+    nlohmann::json jsonInfo;
+    std::string deltaInfo;
+    client.infoVersion_ = SC_INFO_VERSION_BINARY;
+    EXPECT_FALSE(client.BuildUpdateDelta(TEST_SC_ID, baseInfo, jsonInfo, deltaInfo));
+
+    client.infoVersion_ = SC_INFO_VERSION_DELTA;
+    EXPECT_FALSE(client.BuildUpdateDelta(TEST_SC_ID, baseInfo, jsonInfo, deltaInfo));
+    client.RecordUpdateDeltaBase(TEST_SC_ID, true, jsonInfo, 1);
+
+    jsonComponent[JsonTagConstants::JSON_RECT][JsonTagConstants::JSON_RECT_X] = TestCommon::TEST_COORDINATE + 1;
+    ASSERT_TRUE(client.BuildUpdateDelta(TEST_SC_ID, jsonComponent.dump(), jsonInfo, deltaInfo));
+    EXPECT_TRUE(SecCompBase::IsDeltaInfo(deltaInfo));
+    nlohmann::json jsonDelta = nlohmann::json::parse(deltaInfo.substr(1), nullptr, false);
+    EXPECT_EQ(1U, jsonDelta[JsonTagConstants::JSON_BASE_VERSION_TAG].get<uint32_t>());
+    EXPECT_TRUE(jsonDelta.contains(JsonTagConstants::JSON_WINDOW_RECT));
+    EXPECT_FALSE(jsonDelta.contains(JsonTagConstants::JSON_PARENT_TAG));
+    EXPECT_LT(deltaInfo.size(), baseInfo.size());
+    EXPECT_FALSE(SecCompBase::IsDeltaInfo(jsonDelta.dump()));
+
+    jsonComponent[JsonTagConstants::JSON_NODE_ID] = 1;
+    EXPECT_FALSE(client.BuildUpdateDelta(TEST_SC_ID, jsonComponent.dump(), jsonInfo, deltaInfo));
+
+    client.OnRemoteDiedHandle();
+    EXPECT_TRUE(client.deltaBaseMap_.empty());
+}
+
+/**
+ * @tc.name: RegisterSecurityComponents001
+ * @tc.desc: test batch register skips failed items and writes the rest.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompKitTest, RegisterSecurityComponents001, TestSize.Level0)
+{
+    std::vector<SecCompRegisterItem> items(2);
+    items[0].type = LOCATION_COMPONENT;
+    items[0].componentInfo = "{}";
+    items[1].result = SC_ENHANCE_ERROR_VALUE_INVALID;
+    SecCompRawdata rawData;
+    EXPECT_EQ(SC_OK, SecCompClient::GetInstance().RegisterBatchWriteToRawdata(items, { 0 }, rawData));
+    EXPECT_NE(nullptr, rawData.data);
+
+    // no item to send, no ipc is made
+    std::vector<SecCompRegisterItem> failedItems(1);
+    failedItems[0].result = SC_ENHANCE_ERROR_VALUE_INVALID;
+    failedItems[0].scId = TEST_SC_ID;
+    EXPECT_EQ(SC_OK, SecCompClient::GetInstance().RegisterSecurityComponents(failedItems));
+    EXPECT_EQ(SC_ENHANCE_ERROR_VALUE_INVALID, failedItems[0].result);
+    EXPECT_EQ(INVALID_SC_ID, failedItems[0].scId);
+
+    SecCompRawdata unregisterData;
+    EXPECT_EQ(SC_OK, SecCompClient::GetInstance().UnregisterBatchWriteToRawdata({ TEST_SC_ID }, unregisterData));
+}
+
+/**
+ * @tc.name: IpcSession001
+ * @tc.desc: test waiting click report goes before waiting management request.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompKitTest, IpcSession001, TestSize.Level0)
+{
+    SecCompClient& client = SecCompClient::GetInstance();
+    SecCompEnhanceAdapter::isEnhanceClientHandlerInit = true;
+    SecCompEnhanceAdapter::clientHandler = nullptr;
+    {
+        // no enhance session, nothing is serialized
+        SecCompClient::IpcSession session(client, false);
+        EXPECT_FALSE(client.isSessionBusy_);
+    }
+
+    TestClientEnhance enhance;
+    SecCompEnhanceAdapter::clientHandler = &enhance;
+    std::mutex orderMutex;
+    std::vector<bool> order;
+    auto session = std::make_unique<SecCompClient::IpcSession>(client, false);
+    EXPECT_TRUE(client.isSessionBusy_);
+    std::thread update([&]() {
+        SecCompClient::IpcSession updateSession(client, false);
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.emplace_back(false);
+    });
+    std::thread click([&]() {
+        SecCompClient::IpcSession clickSession(client, true);
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.emplace_back(true);
+    });
+    while (true) {
+        std::lock_guard<std::mutex> lock(client.sessionMutex_);
+        if (client.waitingClickNum_ == 1) {
+            break;
+        }
+    }
+    session.reset();
+    update.join();
+    click.join();
+    ASSERT_EQ(2u, order.size());
+    EXPECT_TRUE(order[0]);
+    EXPECT_FALSE(client.isSessionBusy_);
+    SecCompEnhanceAdapter::clientHandler = nullptr;
+    SecCompEnhanceAdapter::isEnhanceClientHandlerInit = false;
+}
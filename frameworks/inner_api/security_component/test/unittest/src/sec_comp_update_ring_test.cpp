@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sec_comp_update_ring_test.h"
+
+#include <string>
+#include <vector>
+#include "sec_comp_log.h"
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::Security::SecurityComponent;
+
+namespace {
+static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
+    LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompUpdateRingTest"};
+// region layout: magic, capacity, head, tail, consumerIdle, consumerClosed, failedNum, reserved, then the records
+static constexpr size_t HEAD_INDEX = 2;
+static constexpr size_t FIRST_RECORD_LEN_INDEX = 8;
+static constexpr int32_t TEST_SC_ID = 1;
+static const std::string TEST_PAYLOAD = "{\"type\":1}";
+
+class TestRingRegion {
+public:
+    TestRingRegion()
+        : buffer_(SecCompUpdateRing::GetRegionSize(SecCompUpdateRing::MIN_RING_CAPACITY) / sizeof(uint32_t)),
+          producer_(buffer_.data(), buffer_.size() * sizeof(uint32_t)),
+          consumer_(buffer_.data(), buffer_.size() * sizeof(uint32_t))
+    {}
+
+    std::vector<uint32_t> buffer_;
+    SecCompUpdateRing producer_;
+    SecCompUpdateRing consumer_;
+};
+}
+
+void SecCompUpdateRingTest::SetUpTestCase()
+{}
+
+void SecCompUpdateRingTest::TearDownTestCase()
+{}
+
+void SecCompUpdateRingTest::SetUp()
+{
+    SC_LOG_INFO(LABEL, "setup");
+}
+
+void SecCompUpdateRingTest::TearDown()
+{}
+
+/**
+ * @tc.name: PushPop001
+ * @tc.desc: Test records are popped in order and the doorbell is only needed by an idle consumer
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompUpdateRingTest, PushPop001, TestSize.Level0)
+{
+    TestRingRegion region;
+    ASSERT_TRUE(region.producer_.InitProducer());
+    ASSERT_TRUE(region.consumer_.InitConsumer());
+
+    bool needDoorbell = false;
+    ASSERT_TRUE(region.producer_.Push(TEST_SC_ID, TEST_PAYLOAD, needDoorbell));
+    EXPECT_TRUE(needDoorbell);
+    ASSERT_TRUE(region.producer_.Push(TEST_SC_ID + 1, "", needDoorbell));
+    EXPECT_FALSE(needDoorbell);
+
+    SecCompUpdateRecord record;
+    ASSERT_EQ(UpdateRingStatus::RING_OK, region.consumer_.Pop(record));
+    EXPECT_EQ(TEST_SC_ID, record.scId);
+    EXPECT_EQ(0, record.seq);
+    EXPECT_EQ(TEST_PAYLOAD, record.payload);
+    ASSERT_EQ(UpdateRingStatus::RING_OK, region.consumer_.Pop(record));
+    EXPECT_EQ(TEST_SC_ID + 1, record.scId);
+    EXPECT_TRUE(record.payload.empty());
+    EXPECT_EQ(UpdateRingStatus::RING_EMPTY, region.consumer_.Pop(record));
+    EXPECT_TRUE(region.consumer_.MarkIdle());
+
+    ASSERT_TRUE(region.producer_.Push(TEST_SC_ID, TEST_PAYLOAD, needDoorbell));
+    EXPECT_TRUE(needDoorbell);
+    EXPECT_FALSE(region.consumer_.MarkIdle());
+}
+
+/**
+ * @tc.name: Push001
+ * @tc.desc: Test push fails on an oversized record or a full ring, and records wrap around the end
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompUpdateRingTest, Push001, TestSize.Level0)
+{
+    TestRingRegion region;
+    ASSERT_TRUE(region.producer_.InitProducer());
+    ASSERT_TRUE(region.consumer_.InitConsumer());
+
+    bool needDoorbell = false;
+    std::string payload(SecCompUpdateRing::MAX_RECORD_PAYLOAD + 1, 'a');
+    EXPECT_FALSE(region.producer_.Push(TEST_SC_ID, payload, needDoorbell));
+
+    payload.resize(SecCompUpdateRing::MIN_RING_CAPACITY / 3);
+    ASSERT_TRUE(region.producer_.Push(TEST_SC_ID, payload, needDoorbell));
+    ASSERT_TRUE(region.producer_.Push(TEST_SC_ID, payload, needDoorbell));
+    EXPECT_FALSE(region.producer_.Push(TEST_SC_ID, payload, needDoorbell));
+
+    SecCompUpdateRecord record;
+    ASSERT_EQ(UpdateRingStatus::RING_OK, region.consumer_.Pop(record));
+    payload.assign(payload.size(), 'b');
+    ASSERT_TRUE(region.producer_.Push(TEST_SC_ID, payload, needDoorbell));
+    ASSERT_EQ(UpdateRingStatus::RING_OK, region.consumer_.Pop(record));
+    ASSERT_EQ(UpdateRingStatus::RING_OK, region.consumer_.Pop(record));
+    EXPECT_EQ(payload, record.payload);
+    EXPECT_EQ(2, record.seq);
+}
+
+/**
+ * @tc.name: Pop001
+ * @tc.desc: Test consumer rejects a tampered region and stays corrupted
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompUpdateRingTest, Pop001, TestSize.Level0)
+{
+    TestRingRegion region;
+    ASSERT_TRUE(region.producer_.InitProducer());
+    ASSERT_TRUE(region.consumer_.InitConsumer());
+    bool needDoorbell = false;
+    ASSERT_TRUE(region.producer_.Push(TEST_SC_ID, TEST_PAYLOAD, needDoorbell));
+
+    region.buffer_[FIRST_RECORD_LEN_INDEX] = SecCompUpdateRing::MIN_RING_CAPACITY;
+    SecCompUpdateRecord record;
+    EXPECT_FALSE(region.producer_.IsClosed());
+    EXPECT_EQ(UpdateRingStatus::RING_CORRUPTED, region.consumer_.Pop(record));
+    EXPECT_TRUE(region.consumer_.MarkIdle());
+    region.buffer_[FIRST_RECORD_LEN_INDEX] = TEST_PAYLOAD.size();
+    EXPECT_EQ(UpdateRingStatus::RING_CORRUPTED, region.consumer_.Pop(record));
+    // producer stops pushing into a ring the consumer gave up
+    EXPECT_TRUE(region.producer_.IsClosed());
+    EXPECT_FALSE(region.producer_.Push(TEST_SC_ID, TEST_PAYLOAD, needDoorbell));
+
+    TestRingRegion headRegion;
+    ASSERT_TRUE(headRegion.producer_.InitProducer());
+    ASSERT_TRUE(headRegion.consumer_.InitConsumer());
+    headRegion.buffer_[HEAD_INDEX] = SecCompUpdateRing::MIN_RING_CAPACITY + sizeof(uint32_t);
+    EXPECT_EQ(UpdateRingStatus::RING_CORRUPTED, headRegion.consumer_.Pop(record));
+
+    TestRingRegion magicRegion;
+    EXPECT_FALSE(magicRegion.consumer_.InitConsumer());
+}
+
+/**
+ * @tc.name: FailedNum001
+ * @tc.desc: Test seq of the next record and failed records are shared between both sides
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompUpdateRingTest, FailedNum001, TestSize.Level0)
+{
+    TestRingRegion region;
+    ASSERT_TRUE(region.producer_.InitProducer());
+    ASSERT_TRUE(region.consumer_.InitConsumer());
+    EXPECT_EQ(0, region.producer_.GetNextSeq());
+    bool needDoorbell = false;
+    ASSERT_TRUE(region.producer_.Push(TEST_SC_ID, TEST_PAYLOAD, needDoorbell));
+    EXPECT_EQ(1, region.producer_.GetNextSeq());
+
+    SecCompUpdateRecord record;
+    ASSERT_EQ(UpdateRingStatus::RING_OK, region.consumer_.Pop(record));
+    EXPECT_EQ(1, region.consumer_.GetNextSeq());
+    EXPECT_EQ(0, region.producer_.GetFailedNum());
+    region.consumer_.AddFailedNum();
+    EXPECT_EQ(1, region.producer_.GetFailedNum());
+    EXPECT_FALSE(region.producer_.IsClosed());
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,14 +14,749 @@
  */
 #include "sec_comp_base.h"
 
+#include <cmath>
+#include <vector>
 #include "sec_comp_err.h"
 #include "sec_comp_log.h"
+#include "securec.h"
 
 namespace OHOS {
 namespace Security {
 namespace SecurityComponent {
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompBase"};
+// magic(1) + version(1) + total length(2)
+constexpr size_t BINARY_LENGTH_OFFSET = 2;
+
+class BinaryWriter {
+public:
+    BinaryWriter(uint8_t* buf, size_t size) : buf_(buf), size_(size) {}
+
+    template<typename T>
+    void Write(T value)
+    {
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void WriteBool(bool value)
+    {
+        Write(static_cast<uint8_t>(value ? 1 : 0));
+    }
+
+    void WriteRect(const SecCompRect& rect)
+    {
+        Write(rect.x_);
+        Write(rect.y_);
+        Write(rect.width_);
+        Write(rect.height_);
+    }
+
+    void WriteBytes(const void* data, size_t len)
+    {
+        if (!isValid_ || (len > size_ - pos_)) {
+            isValid_ = false;
+            return;
+        }
+        if ((len != 0) && (memcpy_s(buf_ + pos_, size_ - pos_, data, len) != EOK)) {
+            isValid_ = false;
+            return;
+        }
+        pos_ += len;
+    }
+
+    bool IsValid() const
+    {
+        return isValid_;
+    }
+
+    size_t GetPos() const
+    {
+        return pos_;
+    }
+
+private:
+    uint8_t* buf_;
+    size_t size_;
+    size_t pos_ = 0;
+    bool isValid_ = true;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* buf, size_t size) : buf_(buf), size_(size) {}
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        return ReadBytes(&value, sizeof(T));
+    }
+
+    bool ReadBool(bool& value)
+    {
+        uint8_t raw = 0;
+        if (!Read(raw) || (raw > 1)) {
+            return false;
+        }
+        value = (raw == 1);
+        return true;
+    }
+
+    // json can not carry nan or inf, keep the same value domain for binary
+    bool ReadDimension(double& value)
+    {
+        return Read(value) && std::isfinite(value);
+    }
+
+    bool ReadRect(SecCompRect& rect)
+    {
+        return ReadDimension(rect.x_) && ReadDimension(rect.y_) &&
+            ReadDimension(rect.width_) && ReadDimension(rect.height_);
+    }
+
+    bool ReadString(std::string& value, size_t maxLen)
+    {
+        uint16_t len = 0;
+        if (!Read(len) || (len > maxLen) || (len > size_ - pos_)) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(buf_ + pos_), len);
+        pos_ += len;
+        return true;
+    }
+
+    bool ReadBytes(void* data, size_t len)
+    {
+        if (len > size_ - pos_) {
+            return false;
+        }
+        if ((len != 0) && (memcpy_s(data, len, buf_ + pos_, len) != EOK)) {
+            return false;
+        }
+        pos_ += len;
+        return true;
+    }
+
+    bool IsEnd() const
+    {
+        return pos_ == size_;
+    }
+
+private:
+    const uint8_t* buf_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+bool IsBackgroundValid(SecCompBackground bg)
+{
+    return (bg == SecCompBackground::NO_BG_TYPE) || (bg == SecCompBackground::CAPSULE) ||
+        (bg == SecCompBackground::CIRCLE) || (bg == SecCompBackground::NORMAL) ||
+        (bg == SecCompBackground::ROUNDED_RECTANGLE);
+}
+
+void WriteBinaryParent(BinaryWriter& writer, const SecCompBase& comp)
+{
+    writer.WriteBool(comp.parentEffect_);
+    writer.WriteBool(comp.isClipped_);
+    writer.Write(comp.topClip_);
+    writer.Write(comp.bottomClip_);
+    writer.Write(comp.leftClip_);
+    writer.Write(comp.rightClip_);
+    writer.Write(static_cast<uint16_t>(comp.parentTag_.size()));
+    writer.WriteBytes(comp.parentTag_.data(), comp.parentTag_.size());
+}
+
+void WriteBinarySize(BinaryWriter& writer, const SecCompBase& comp)
+{
+    writer.Write(comp.fontSize_);
+    writer.Write(comp.iconSize_);
+    writer.Write(comp.textIconSpace_);
+    writer.Write(comp.padding_.top);
+    writer.Write(comp.padding_.right);
+    writer.Write(comp.padding_.bottom);
+    writer.Write(comp.padding_.left);
+    writer.Write(comp.borderRadius_.leftTop);
+    writer.Write(comp.borderRadius_.rightTop);
+    writer.Write(comp.borderRadius_.leftBottom);
+    writer.Write(comp.borderRadius_.rightBottom);
+}
+
+void WriteBinaryStyle(BinaryWriter& writer, const SecCompBase& comp)
+{
+    writer.Write(comp.fontColor_.value);
+    writer.Write(comp.iconColor_.value);
+    writer.Write(comp.bgColor_.value);
+    writer.Write(comp.borderWidth_);
+    writer.Write(comp.text_);
+    writer.Write(comp.icon_);
+    writer.Write(static_cast<int32_t>(comp.bg_));
+    writer.WriteBool(comp.isArkuiComponent_);
+    writer.WriteBool(comp.isSmartEdgeState_);
+}
+
+void WriteBinaryWindowInfo(BinaryWriter& writer, const SecCompBase& comp)
+{
+    writer.WriteRect(comp.windowRect_);
+    writer.Write(comp.windowId_);
+    writer.Write(comp.displayId_);
+    writer.Write(static_cast<int32_t>(comp.crossAxisState_));
+    writer.WriteBool(comp.isCustomizable_);
+    writer.Write(static_cast<int32_t>(comp.tipPosition_));
+}
+
+void WriteBinaryNonCompatibleChange(BinaryWriter& writer, const SecCompBase& comp)
+{
+    writer.WriteBool(comp.hasNonCompatibleChange_);
+    writer.WriteBool(comp.isIconExceeded_);
+    writer.WriteBool(comp.isBorderCovered_);
+    writer.Write(comp.blurRadius_);
+    writer.Write(comp.foregroundBlurRadius_);
+    writer.WriteBool(comp.isOverlayTextSet_);
+    writer.WriteBool(comp.isOverlayNodeCovered_);
+}
+
+bool ReadBinaryType(BinaryReader& reader, SecCompBase& comp)
+{
+    int32_t type = 0;
+    if (!reader.Read(type) || (type <= static_cast<int32_t>(SecCompType::UNKNOWN_SC_TYPE)) ||
+        (type >= static_cast<int32_t>(SecCompType::MAX_SC_TYPE))) {
+        return false;
+    }
+    comp.type_ = static_cast<SecCompType>(type);
+    return reader.Read(comp.nodeId_) && reader.ReadBool(comp.isWearableDevice_);
+}
+
+bool ReadBinaryParent(BinaryReader& reader, SecCompBase& comp)
+{
+    return reader.ReadBool(comp.parentEffect_) && reader.ReadBool(comp.isClipped_) &&
+        reader.ReadDimension(comp.topClip_) && reader.ReadDimension(comp.bottomClip_) &&
+        reader.ReadDimension(comp.leftClip_) && reader.ReadDimension(comp.rightClip_) &&
+        reader.ReadString(comp.parentTag_, SC_BINARY_MAX_PARENT_TAG_LEN);
+}
+
+bool ReadBinarySize(BinaryReader& reader, SecCompBase& comp)
+{
+    if (!reader.ReadDimension(comp.fontSize_) || !reader.ReadDimension(comp.iconSize_) ||
+        !reader.ReadDimension(comp.textIconSpace_)) {
+        return false;
+    }
+    if (!reader.ReadDimension(comp.padding_.top) || !reader.ReadDimension(comp.padding_.right) ||
+        !reader.ReadDimension(comp.padding_.bottom) || !reader.ReadDimension(comp.padding_.left)) {
+        return false;
+    }
+    if (!reader.ReadDimension(comp.borderRadius_.leftTop) || !reader.ReadDimension(comp.borderRadius_.rightTop) ||
+        !reader.ReadDimension(comp.borderRadius_.leftBottom) ||
+        !reader.ReadDimension(comp.borderRadius_.rightBottom)) {
+        return false;
+    }
+    comp.rect_.borderRadius_ = comp.borderRadius_;
+    return true;
+}
+
+bool ReadBinaryStyle(BinaryReader& reader, SecCompBase& comp)
+{
+    if (!reader.Read(comp.fontColor_.value) || !reader.Read(comp.iconColor_.value) ||
+        !reader.Read(comp.bgColor_.value) || !reader.ReadDimension(comp.borderWidth_)) {
+        return false;
+    }
+    int32_t bg = 0;
+    if (!reader.Read(comp.text_) || !reader.Read(comp.icon_) || !reader.Read(bg)) {
+        return false;
+    }
+    comp.bg_ = static_cast<SecCompBackground>(bg);
+    if (!IsBackgroundValid(comp.bg_)) {
+        SC_LOG_ERROR(LABEL, "Background is invalid.");
+        return false;
+    }
+    return reader.ReadBool(comp.isArkuiComponent_) && reader.ReadBool(comp.isSmartEdgeState_);
+}
+
+bool ReadBinaryWindowInfo(BinaryReader& reader, SecCompBase& comp)
+{
+    int32_t crossAxisState = 0;
+    if (!reader.ReadRect(comp.windowRect_) || !reader.Read(comp.windowId_) || !reader.Read(comp.displayId_) ||
+        !reader.Read(crossAxisState)) {
+        return false;
+    }
+    if ((crossAxisState < static_cast<int32_t>(CrossAxisState::STATE_INVALID)) ||
+        (crossAxisState > static_cast<int32_t>(CrossAxisState::STATE_NO_CROSS))) {
+        SC_LOG_ERROR(LABEL, "Cross axis state: %{public}d is invalid.", crossAxisState);
+        return false;
+    }
+    comp.crossAxisState_ = static_cast<CrossAxisState>(crossAxisState);
+
+    int32_t tipPosition = 0;
+    if (!reader.ReadBool(comp.isCustomizable_) || !reader.Read(tipPosition)) {
+        return false;
+    }
+    if ((tipPosition < static_cast<int32_t>(TipPosition::ABOVE_BOTTOM)) ||
+        (tipPosition > static_cast<int32_t>(TipPosition::BELOW_TOP))) {
+        SC_LOG_ERROR(LABEL, "Save tip position: %{public}d is invalid.", tipPosition);
+        return false;
+    }
+    comp.tipPosition_ = static_cast<TipPosition>(tipPosition);
+    return true;
+}
+
+bool ReadBinaryNonCompatibleChange(BinaryReader& reader, SecCompBase& comp)
+{
+    return reader.ReadBool(comp.hasNonCompatibleChange_) && reader.ReadBool(comp.isIconExceeded_) &&
+        reader.ReadBool(comp.isBorderCovered_) && reader.ReadDimension(comp.blurRadius_) &&
+        reader.ReadDimension(comp.foregroundBlurRadius_) && reader.ReadBool(comp.isOverlayTextSet_) &&
+        reader.ReadBool(comp.isOverlayNodeCovered_);
+}
+
+enum class SaxGroup : uint8_t {
+    ROOT = 0,
+    RECT,
+    WINDOW_RECT,
+    SIZE,
+    PADDING,
+    BORDER_RADIUS,
+    COLORS,
+    BORDER,
+    PARENT,
+    STYLE,
+    UNKNOWN
+};
+
+// scalar reported by the sax parser, converted the same way as nlohmann::json::get does
+struct SaxScalar {
+    enum class Type : uint8_t { NONE = 0, BOOL, INTEGER, UNSIGNED, FLOAT, STRING };
+    Type type = Type::NONE;
+    bool boolValue = false;
+    int64_t intValue = 0;
+    uint64_t unsignedValue = 0;
+    double floatValue = 0.0;
+    std::string* stringValue = nullptr;
+
+    bool GetDimension(DimensionT& res) const
+    {
+        if (type != Type::FLOAT) {
+            return false;
+        }
+        res = floatValue;
+        return true;
+    }
+
+    bool GetBool(bool& res) const
+    {
+        if (type != Type::BOOL) {
+            return false;
+        }
+        res = boolValue;
+        return true;
+    }
+
+    template<typename T>
+    bool GetNumber(T& res) const
+    {
+        switch (type) {
+            case Type::INTEGER:
+                res = static_cast<T>(intValue);
+                return true;
+            case Type::UNSIGNED:
+                res = static_cast<T>(unsignedValue);
+                return true;
+            case Type::FLOAT:
+                res = static_cast<T>(floatValue);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool GetString(std::string& res) const
+    {
+        if ((type != Type::STRING) || (stringValue == nullptr)) {
+            return false;
+        }
+        res = std::move(*stringValue);
+        return true;
+    }
+};
+
+using SaxSetter = bool (*)(SecCompBase& comp, const SaxScalar& value);
+
+struct SaxContainer {
+    SaxGroup parent;
+    const std::string& tag;
+    SaxGroup group;
+};
+
+struct SaxLeaf {
+    SaxGroup group;
+    const std::string& tag;
+    SaxSetter setter;
+};
+
+bool SetSaxType(SecCompBase& comp, const SaxScalar& value)
+{
+    int32_t type = 0;
+    if (!value.GetNumber(type) || !IsComponentTypeValid(type)) {
+        return false;
+    }
+    comp.type_ = static_cast<SecCompType>(type);
+    return true;
+}
+
+bool SetSaxCrossAxisState(SecCompBase& comp, const SaxScalar& value)
+{
+    int32_t state = 0;
+    if (!value.GetNumber(state) || (state < static_cast<int32_t>(CrossAxisState::STATE_INVALID)) ||
+        (state > static_cast<int32_t>(CrossAxisState::STATE_NO_CROSS))) {
+        return false;
+    }
+    comp.crossAxisState_ = static_cast<CrossAxisState>(state);
+    return true;
+}
+
+bool SetSaxTipPosition(SecCompBase& comp, const SaxScalar& value)
+{
+    int32_t position = 0;
+    if (!value.GetNumber(position) || (position < static_cast<int32_t>(TipPosition::ABOVE_BOTTOM)) ||
+        (position > static_cast<int32_t>(TipPosition::BELOW_TOP))) {
+        return false;
+    }
+    comp.tipPosition_ = static_cast<TipPosition>(position);
+    return true;
+}
+
+bool SetSaxBackground(SecCompBase& comp, const SaxScalar& value)
+{
+    int32_t bg = 0;
+    if (!value.GetNumber(bg)) {
+        return false;
+    }
+    comp.bg_ = static_cast<SecCompBackground>(bg);
+    return true;
+}
+
+const std::vector<SaxContainer>& GetSaxContainers()
+{
+    static const std::vector<SaxContainer> containers = {
+        { SaxGroup::ROOT, JsonTagConstants::JSON_RECT, SaxGroup::RECT },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_WINDOW_RECT, SaxGroup::WINDOW_RECT },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_SIZE_TAG, SaxGroup::SIZE },
+        { SaxGroup::SIZE, JsonTagConstants::JSON_PADDING_SIZE_TAG, SaxGroup::PADDING },
+        { SaxGroup::SIZE, JsonTagConstants::JSON_BORDER_RADIUS_TAG, SaxGroup::BORDER_RADIUS },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_COLORS_TAG, SaxGroup::COLORS },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_BORDER_TAG, SaxGroup::BORDER },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_PARENT_TAG, SaxGroup::PARENT },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_STYLE_TAG, SaxGroup::STYLE },
+    };
+    return containers;
+}
+
+// every leaf is required, same as FromJson
+const std::vector<SaxLeaf>& GetSaxLeaves()
+{
+    static const std::vector<SaxLeaf> leaves = {
+        { SaxGroup::ROOT, JsonTagConstants::JSON_SC_TYPE, SetSaxType },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_NODE_ID,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetNumber(comp.nodeId_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_IS_WEARABLE,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isWearableDevice_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_IS_ARKUI_COMPONENT,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isArkuiComponent_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_IS_SMART_EDGE_STATE,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isSmartEdgeState_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_WINDOW_ID,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetNumber(comp.windowId_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_DISPLAY_ID,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetNumber(comp.displayId_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_CROSS_AXIS_STATE, SetSaxCrossAxisState },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_IS_CUSTOMIZABLE,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isCustomizable_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_TIP_POSITION, SetSaxTipPosition },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_NON_COMPATIBLE_CHANGE_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.hasNonCompatibleChange_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_IS_ICON_EXCEEDED_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isIconExceeded_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_IS_BORDER_COVERED_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isBorderCovered_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_LINEAR_GRADIENT_BLUR_RADIUS_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.blurRadius_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_FOREGROUND_BLUR_RADIUS_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.foregroundBlurRadius_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_IS_OVERLAY_TEXT_SET_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isOverlayTextSet_); } },
+        { SaxGroup::ROOT, JsonTagConstants::JSON_IS_OVERLAY_NODE_SET_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isOverlayNodeCovered_); } },
+        { SaxGroup::RECT, JsonTagConstants::JSON_RECT_X,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.rect_.x_); } },
+        { SaxGroup::RECT, JsonTagConstants::JSON_RECT_Y,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.rect_.y_); } },
+        { SaxGroup::RECT, JsonTagConstants::JSON_RECT_WIDTH,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.rect_.width_); } },
+        { SaxGroup::RECT, JsonTagConstants::JSON_RECT_HEIGHT,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.rect_.height_); } },
+        { SaxGroup::WINDOW_RECT, JsonTagConstants::JSON_RECT_X,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.windowRect_.x_); } },
+        { SaxGroup::WINDOW_RECT, JsonTagConstants::JSON_RECT_Y,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.windowRect_.y_); } },
+        { SaxGroup::WINDOW_RECT, JsonTagConstants::JSON_RECT_WIDTH,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.windowRect_.width_); } },
+        { SaxGroup::WINDOW_RECT, JsonTagConstants::JSON_RECT_HEIGHT,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.windowRect_.height_); } },
+        { SaxGroup::SIZE, JsonTagConstants::JSON_FONT_SIZE_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.fontSize_); } },
+        { SaxGroup::SIZE, JsonTagConstants::JSON_ICON_SIZE_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.iconSize_); } },
+        { SaxGroup::SIZE, JsonTagConstants::JSON_TEXT_ICON_PADDING_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.textIconSpace_); } },
+        { SaxGroup::PADDING, JsonTagConstants::JSON_TOP_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.padding_.top); } },
+        { SaxGroup::PADDING, JsonTagConstants::JSON_RIGHT_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.padding_.right); } },
+        { SaxGroup::PADDING, JsonTagConstants::JSON_BOTTOM_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.padding_.bottom); } },
+        { SaxGroup::PADDING, JsonTagConstants::JSON_LEFT_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.padding_.left); } },
+        { SaxGroup::BORDER_RADIUS, JsonTagConstants::JSON_LEFT_TOP_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.borderRadius_.leftTop); } },
+        { SaxGroup::BORDER_RADIUS, JsonTagConstants::JSON_RIGHT_TOP_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.borderRadius_.rightTop); } },
+        { SaxGroup::BORDER_RADIUS, JsonTagConstants::JSON_LEFT_BOTTOM_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) {
+                return value.GetDimension(comp.borderRadius_.leftBottom);
+            } },
+        { SaxGroup::BORDER_RADIUS, JsonTagConstants::JSON_RIGHT_BOTTOM_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) {
+                return value.GetDimension(comp.borderRadius_.rightBottom);
+            } },
+        { SaxGroup::COLORS, JsonTagConstants::JSON_FONT_COLOR_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetNumber(comp.fontColor_.value); } },
+        { SaxGroup::COLORS, JsonTagConstants::JSON_ICON_COLOR_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetNumber(comp.iconColor_.value); } },
+        { SaxGroup::COLORS, JsonTagConstants::JSON_BG_COLOR_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetNumber(comp.bgColor_.value); } },
+        { SaxGroup::BORDER, JsonTagConstants::JSON_BORDER_WIDTH_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.borderWidth_); } },
+        { SaxGroup::PARENT, JsonTagConstants::JSON_PARENT_EFFECT_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.parentEffect_); } },
+        { SaxGroup::PARENT, JsonTagConstants::JSON_IS_CLIPPED_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetBool(comp.isClipped_); } },
+        { SaxGroup::PARENT, JsonTagConstants::JSON_TOP_CLIP_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.topClip_); } },
+        { SaxGroup::PARENT, JsonTagConstants::JSON_BOTTOM_CLIP_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.bottomClip_); } },
+        { SaxGroup::PARENT, JsonTagConstants::JSON_LEFT_CLIP_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.leftClip_); } },
+        { SaxGroup::PARENT, JsonTagConstants::JSON_RIGHT_CLIP_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetDimension(comp.rightClip_); } },
+        { SaxGroup::PARENT, JsonTagConstants::JSON_PARENT_TAG_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetString(comp.parentTag_); } },
+        { SaxGroup::STYLE, JsonTagConstants::JSON_TEXT_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetNumber(comp.text_); } },
+        { SaxGroup::STYLE, JsonTagConstants::JSON_ICON_TAG,
+            [](SecCompBase& comp, const SaxScalar& value) { return value.GetNumber(comp.icon_); } },
+        { SaxGroup::STYLE, JsonTagConstants::JSON_BG_TAG, SetSaxBackground },
+    };
+    return leaves;
+}
+
+// fills a component in one pass over the json text, no dom is built
+class ComponentSaxHandler {
+public:
+    explicit ComponentSaxHandler(SecCompBase& comp) : comp_(comp) {}
+
+    bool null()
+    {
+        return OnScalar(SaxScalar {});
+    }
+
+    bool boolean(bool val)
+    {
+        SaxScalar value;
+        value.type = SaxScalar::Type::BOOL;
+        value.boolValue = val;
+        return OnScalar(value);
+    }
+
+    bool number_integer(nlohmann::json::number_integer_t val)
+    {
+        SaxScalar value;
+        value.type = SaxScalar::Type::INTEGER;
+        value.intValue = val;
+        return OnScalar(value);
+    }
+
+    bool number_unsigned(nlohmann::json::number_unsigned_t val)
+    {
+        SaxScalar value;
+        value.type = SaxScalar::Type::UNSIGNED;
+        value.unsignedValue = val;
+        return OnScalar(value);
+    }
+
+    bool number_float(nlohmann::json::number_float_t val, const nlohmann::json::string_t& raw)
+    {
+        (void)raw;
+        SaxScalar value;
+        value.type = SaxScalar::Type::FLOAT;
+        value.floatValue = val;
+        return OnScalar(value);
+    }
+
+    bool string(nlohmann::json::string_t& val)
+    {
+        SaxScalar value;
+        value.type = SaxScalar::Type::STRING;
+        value.stringValue = &val;
+        return OnScalar(value);
+    }
+
+    bool binary(nlohmann::json::binary_t& val)
+    {
+        (void)val;
+        return false;
+    }
+
+    bool start_object(std::size_t elements)
+    {
+        (void)elements;
+        return Enter(true);
+    }
+
+    bool end_object()
+    {
+        return Leave();
+    }
+
+    bool start_array(std::size_t elements)
+    {
+        (void)elements;
+        return Enter(false);
+    }
+
+    bool end_array()
+    {
+        return Leave();
+    }
+
+    bool key(nlohmann::json::string_t& val)
+    {
+        // the buffer is reused, no allocation once it is large enough
+        key_.assign(val);
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string& lastToken, const nlohmann::detail::exception& ex)
+    {
+        (void)lastToken;
+        (void)ex;
+        SC_LOG_ERROR(LABEL, "Json text is invalid at %{public}zu.", position);
+        return false;
+    }
+
+    bool IsAllLeavesSet() const
+    {
+        const auto& leaves = GetSaxLeaves();
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            if ((leafMask_ & (1ULL << i)) == 0) {
+                SC_LOG_ERROR(LABEL, "Json: %{public}s tag invalid.", leaves[i].tag.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    bool Enter(bool isObject)
+    {
+        if (depth_ >= SC_JSON_MAX_DEPTH) {
+            SC_LOG_ERROR(LABEL, "Json depth exceeds %{public}zu.", SC_JSON_MAX_DEPTH);
+            return false;
+        }
+        SaxGroup group = SaxGroup::UNKNOWN;
+        if (depth_ == 0) {
+            if (!isObject) {
+                SC_LOG_ERROR(LABEL, "Json root is not an object.");
+                return false;
+            }
+            group = SaxGroup::ROOT;
+        } else if (groups_[depth_ - 1] != SaxGroup::UNKNOWN) {
+            size_t index = 0;
+            if (FindLeaf(groups_[depth_ - 1], index)) {
+                SC_LOG_ERROR(LABEL, "Json: %{public}s tag invalid.", key_.c_str());
+                return false;
+            }
+            const SaxContainer* container = FindContainer(groups_[depth_ - 1]);
+            if ((container != nullptr) && !isObject) {
+                SC_LOG_ERROR(LABEL, "Json: %{public}s tag invalid.", key_.c_str());
+                return false;
+            }
+            group = (container != nullptr) ? container->group : SaxGroup::UNKNOWN;
+        }
+        groups_[depth_++] = group;
+        return true;
+    }
+
+    bool Leave()
+    {
+        if (depth_ == 0) {
+            return false;
+        }
+        --depth_;
+        return true;
+    }
+
+    bool OnScalar(const SaxScalar& value)
+    {
+        if (depth_ == 0) {
+            SC_LOG_ERROR(LABEL, "Json root is not an object.");
+            return false;
+        }
+        SaxGroup group = groups_[depth_ - 1];
+        if (group == SaxGroup::UNKNOWN) {
+            return true;
+        }
+        if (FindContainer(group) != nullptr) {
+            SC_LOG_ERROR(LABEL, "Json: %{public}s tag invalid.", key_.c_str());
+            return false;
+        }
+        size_t index = 0;
+        if (!FindLeaf(group, index)) {
+            return true;
+        }
+        if (!GetSaxLeaves()[index].setter(comp_, value)) {
+            SC_LOG_ERROR(LABEL, "Json: %{public}s tag invalid.", key_.c_str());
+            return false;
+        }
+        leafMask_ |= (1ULL << index);
+        return true;
+    }
+
+    const SaxContainer* FindContainer(SaxGroup parent) const
+    {
+        for (const auto& container : GetSaxContainers()) {
+            if ((container.parent == parent) && (container.tag == key_)) {
+                return &container;
+            }
+        }
+        return nullptr;
+    }
+
+    bool FindLeaf(SaxGroup group, size_t& index) const
+    {
+        const auto& leaves = GetSaxLeaves();
+        for (size_t i = 0; i < leaves.size(); ++i) {
+            if ((leaves[i].group == group) && (leaves[i].tag == key_)) {
+                index = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SecCompBase& comp_;
+    std::string key_;
+    SaxGroup groups_[SC_JSON_MAX_DEPTH] = {};
+    size_t depth_ = 0;
+    // bit i is set once GetSaxLeaves()[i] is parsed
+    uint64_t leafMask_ = 0;
+};
 }
 
 const std::string JsonTagConstants::JSON_RECT = "rect";
@@ -81,6 +816,7 @@ const std::string JsonTagConstants::JSON_TIP_POSITION = "tipPosition";
 const std::string JsonTagConstants::JSON_IS_CUSTOMIZABLE = "isCustomizable";
 const std::string JsonTagConstants::JSON_IS_ARKUI_COMPONENT = "isArkuiComponent";
 const std::string JsonTagConstants::JSON_IS_SMART_EDGE_STATE = "isSmartEdgeState";
+const std::string JsonTagConstants::JSON_BASE_VERSION_TAG = "baseVersion";
 
 bool SecCompBase::ParseNonCompatibleChange(const nlohmann::json& json)
 {
@@ -502,6 +1238,65 @@ bool SecCompBase::FromJson(const nlohmann::json& jsonSrc, std::string& message,
     return true;
 }
 
+bool SecCompBase::FromJsonText(const std::string& jsonText, std::string& message, bool isClicked)
+{
+    if (jsonText.size() > SC_JSON_MAX_SIZE) {
+        SC_LOG_ERROR(LABEL, "Json text size %{public}zu is too large.", jsonText.size());
+        return false;
+    }
+    ComponentSaxHandler handler(*this);
+    if (!nlohmann::json::sax_parse(jsonText, &handler) || !handler.IsAllLeavesSet()) {
+        return false;
+    }
+    rect_.borderRadius_ = borderRadius_;
+    if (!IsTextIconTypeValid(message, isClicked)) {
+        SC_LOG_ERROR(LABEL, "Text or icon is invalid.");
+        return false;
+    }
+    if (!IsBackgroundValid(bg_)) {
+        SC_LOG_ERROR(LABEL, "Background is invalid.");
+        return false;
+    }
+    return true;
+}
+
+bool SecCompBase::IsDeltaTag(const std::string& tag)
+{
+    return (tag == JsonTagConstants::JSON_RECT) || (tag == JsonTagConstants::JSON_WINDOW_RECT) ||
+        (tag == JsonTagConstants::JSON_PARENT_TAG);
+}
+
+bool SecCompBase::FromJsonDelta(const nlohmann::json& jsonDelta, bool& isRectChanged)
+{
+    if (!jsonDelta.is_object()) {
+        SC_LOG_ERROR(LABEL, "Delta is not an object.");
+        return false;
+    }
+    for (const auto& item : jsonDelta.items()) {
+        if ((item.key() != JsonTagConstants::JSON_BASE_VERSION_TAG) && !IsDeltaTag(item.key())) {
+            SC_LOG_ERROR(LABEL, "Json: %{public}s tag can not be updated by delta.", item.key().c_str());
+            return false;
+        }
+    }
+
+    // the stored rects may be scaled already, rect and windowRect are only replaced together as raw rects
+    bool hasRect = jsonDelta.contains(JsonTagConstants::JSON_RECT);
+    if (hasRect != jsonDelta.contains(JsonTagConstants::JSON_WINDOW_RECT)) {
+        SC_LOG_ERROR(LABEL, "Delta rect and windowRect must be updated together.");
+        return false;
+    }
+    if (hasRect && (!ParseRect(jsonDelta, JsonTagConstants::JSON_RECT, rect_) ||
+        !ParseRect(jsonDelta, JsonTagConstants::JSON_WINDOW_RECT, windowRect_))) {
+        return false;
+    }
+    if (jsonDelta.contains(JsonTagConstants::JSON_PARENT_TAG) &&
+        !ParseParent(jsonDelta, JsonTagConstants::JSON_PARENT_TAG)) {
+        return false;
+    }
+    isRectChanged = hasRect;
+    return true;
+}
+
 void SecCompBase::ToJsonRect(nlohmann::json& jsonRes) const
 {
     jsonRes[JsonTagConstants::JSON_RECT] = nlohmann::json {
@@ -599,6 +1394,65 @@ std::string SecCompBase::ToJsonStr() const
     return json.dump();
 }
 
+bool SecCompBase::FromBinary(const uint8_t* buf, size_t len, std::string& message, bool isClicked)
+{
+    if (buf == nullptr) {
+        SC_LOG_ERROR(LABEL, "Binary: buffer is null.");
+        return false;
+    }
+    BinaryReader reader(buf, len);
+    uint8_t magic = 0;
+    uint8_t version = 0;
+    uint16_t totalLen = 0;
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(totalLen) || (magic != SC_BINARY_MAGIC) ||
+        (version != SC_INFO_VERSION_BINARY) || (totalLen != len)) {
+        SC_LOG_ERROR(LABEL, "Binary: header invalid.");
+        return false;
+    }
+    if (!ReadBinaryType(reader, *this) || !ReadBinaryParent(reader, *this) || !reader.ReadRect(rect_) ||
+        !ReadBinarySize(reader, *this) || !ReadBinaryStyle(reader, *this) || !ReadBinaryWindowInfo(reader, *this) ||
+        !ReadBinaryNonCompatibleChange(reader, *this) || !reader.IsEnd()) {
+        SC_LOG_ERROR(LABEL, "Binary: component info invalid.");
+        return false;
+    }
+    if (!IsTextIconTypeValid(message, isClicked)) {
+        SC_LOG_ERROR(LABEL, "Text or icon is invalid.");
+        return false;
+    }
+    return true;
+}
+
+bool SecCompBase::ToBinary(uint8_t* buf, size_t bufLen, size_t& len) const
+{
+    if ((buf == nullptr) || (parentTag_.size() > SC_BINARY_MAX_PARENT_TAG_LEN)) {
+        SC_LOG_ERROR(LABEL, "Binary: buffer is null or parent tag is too long.");
+        return false;
+    }
+    BinaryWriter writer(buf, bufLen);
+    writer.Write(SC_BINARY_MAGIC);
+    writer.Write(static_cast<uint8_t>(SC_INFO_VERSION_BINARY));
+    writer.Write(static_cast<uint16_t>(0));
+    writer.Write(static_cast<int32_t>(type_));
+    writer.Write(nodeId_);
+    writer.WriteBool(isWearableDevice_);
+    WriteBinaryParent(writer, *this);
+    writer.WriteRect(rect_);
+    WriteBinarySize(writer, *this);
+    WriteBinaryStyle(writer, *this);
+    WriteBinaryWindowInfo(writer, *this);
+    WriteBinaryNonCompatibleChange(writer, *this);
+    if (!writer.IsValid() || (writer.GetPos() > UINT16_MAX)) {
+        SC_LOG_ERROR(LABEL, "Binary: buffer is too small.");
+        return false;
+    }
+    len = writer.GetPos();
+    uint16_t totalLen = static_cast<uint16_t>(len);
+    if (memcpy_s(buf + BINARY_LENGTH_OFFSET, bufLen - BINARY_LENGTH_OFFSET, &totalLen, sizeof(totalLen)) != EOK) {
+        return false;
+    }
+    return true;
+}
+
 bool SecCompBase::CompareComponentBasicInfo(SecCompBase *other, bool isRectCheck) const
 {
     if (other == nullptr) {
@@ -658,9 +1512,7 @@ bool SecCompBase::ParseStyle(const nlohmann::json& json, const std::string& tag,
         return false;
     }
     bg_ = static_cast<SecCompBackground>(jsonStyle.at(JsonTagConstants::JSON_BG_TAG).get<int32_t>());
-    if ((bg_ != SecCompBackground::NO_BG_TYPE) && (bg_ != SecCompBackground::CAPSULE) &&
-        (bg_ != SecCompBackground::CIRCLE) && (bg_ != SecCompBackground::NORMAL) &&
-        (bg_ != SecCompBackground::ROUNDED_RECTANGLE)) {
+    if (!IsBackgroundValid(bg_)) {
         SC_LOG_ERROR(LABEL, "Background is invalid.");
         return false;
     }
@@ -98,6 +98,7 @@ public:
     static const std::string JSON_TIP_POSITION;
     static const std::string JSON_IS_ARKUI_COMPONENT;
     static const std::string JSON_IS_SMART_EDGE_STATE;
+    static const std::string JSON_BASE_VERSION_TAG;
 };
 
 class __attribute__((visibility("default"))) SecCompBase {
@@ -105,8 +106,23 @@ public:
     SecCompBase() = default;
     virtual ~SecCompBase() = default;
     bool FromJson(const nlohmann::json& jsonSrc, std::string& message, bool isClicked);
+    // same result as FromJson, the json text is parsed in one pass without building a dom
+    bool FromJsonText(const std::string& jsonText, std::string& message, bool isClicked);
     void ToJson(nlohmann::json& jsonRes) const;
     std::string ToJsonStr(void) const;
+    bool FromBinary(const uint8_t* buf, size_t len, std::string& message, bool isClicked);
+    bool ToBinary(uint8_t* buf, size_t bufLen, size_t& len) const;
+    // delta of an update, only rect, windowRect and parent may change, the rects always come together
+    bool FromJsonDelta(const nlohmann::json& jsonDelta, bool& isRectChanged);
+    static bool IsDeltaTag(const std::string& tag);
+    static bool IsDeltaInfo(const std::string& componentInfo)
+    {
+        return !componentInfo.empty() && (static_cast<uint8_t>(componentInfo[0]) == SC_DELTA_MAGIC);
+    };
+    static bool IsBinaryInfo(const std::string& componentInfo)
+    {
+        return !componentInfo.empty() && (static_cast<uint8_t>(componentInfo[0]) == SC_BINARY_MAGIC);
+    };
     virtual bool CompareComponentBasicInfo(SecCompBase *other, bool isRectCheck) const;
     void SetValid(bool valid)
     {
@@ -145,6 +161,9 @@ public:
     SecCompType type_ = UNKNOWN_SC_TYPE;
     SecCompRect rect_;
     SecCompRect windowRect_;
+    // rects as reported by the client, before they are adjusted by the window scale
+    SecCompRect rawRect_;
+    SecCompRect rawWindowRect_;
     bool isValid_ = false;
 
     int32_t text_ = UNKNOWN_TEXT;
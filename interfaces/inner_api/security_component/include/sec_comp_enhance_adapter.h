@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,6 +15,7 @@
 #ifndef SECURITY_COMPONENT_ENHANCE_ADAPTER_H
 #define SECURITY_COMPONENT_ENHANCE_ADAPTER_H
 
+#include <memory>
 #include <mutex>
 #include "iremote_object.h"
 #include "nlohmann/json.hpp"
@@ -110,6 +111,7 @@ public:
     static int32_t DisableInputEnhance();
     static int32_t CheckComponentInfoEnhance(int32_t pid, std::shared_ptr<SecCompBase>& compInfo,
         const nlohmann::json& jsonComponent);
+    static bool IsSrvEnhanceEnabled();
     static void StartEnhanceService();
     static void ExitEnhanceService();
     static void NotifyProcessDied(int32_t pid);
@@ -118,6 +120,9 @@ public:
     static bool EnhanceDataPreprocess(int32_t scId, std::string& componentInfo);
     static bool EnhanceClientSerialize(MessageParcel& input, SecCompRawdata& output);
     static bool EnhanceClientDeserialize(SecCompRawdata& input, MessageParcel& output);
+    // output borrows the parcel buffer instead of copying it
+    static bool EnhanceClientSerialize(const std::shared_ptr<MessageParcel>& input, SecCompRawdata& output);
+    static bool IsClientEnhanceEnabled();
     static void RegisterScIdEnhance(int32_t scId);
     static void UnregisterScIdEnhance(int32_t scId);
 
@@ -126,6 +131,9 @@ public:
 
     static bool EnhanceSrvSerialize(MessageParcel& input, SecCompRawdata& output);
     static bool EnhanceSrvDeserialize(SecCompRawdata& input, MessageParcel& output);
+    static bool EnhanceSrvSerialize(const std::shared_ptr<MessageParcel>& input, SecCompRawdata& output);
+    // request and reply parcels are reused, their buffers are kept between calls
+    static std::shared_ptr<MessageParcel> AcquireParcel();
     static __attribute__((visibility("default"))) SecCompInputEnhanceInterface* inputHandler;
     static bool isEnhanceInputHandlerInit;
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -32,6 +32,26 @@ static constexpr DimensionT MIN_ICON_SIZE = 12.0;
 static constexpr DimensionT MIN_PADDING_SIZE = 0.0;
 static constexpr DimensionT MIN_PADDING_WITHOUT_BG = 4.0;
 static constexpr uint32_t MAX_EXTRA_SIZE = 0x1000;
+// component info format negotiated by PreRegisterSecCompProcess, json is always accepted
+static constexpr uint32_t SC_INFO_VERSION_JSON = 0;
+static constexpr uint32_t SC_INFO_VERSION_BINARY = 1;
+// binary info is still accepted, update may carry only changed fields, see SC_DELTA_MAGIC
+static constexpr uint32_t SC_INFO_VERSION_DELTA = 2;
+// leading byte of binary component info, never the first byte of a json text
+static constexpr uint8_t SC_BINARY_MAGIC = 0xA5;
+// leading byte of update delta info, the json text of the delta follows
+static constexpr uint8_t SC_DELTA_MAGIC = 0xA6;
+static constexpr size_t SC_BINARY_MAX_SIZE = 512;
+static constexpr size_t SC_BINARY_MAX_PARENT_TAG_LEN = 128;
+// json text limits checked before it is parsed
+static constexpr size_t SC_JSON_MAX_SIZE = 0x4000;
+static constexpr size_t SC_JSON_MAX_DEPTH = 8;
+// components carried by one RegisterSecurityComponents or UnregisterSecurityComponents request
+static constexpr size_t SC_BATCH_MAX_NUM = 64;
+// optional channels offered in the PreRegisterSecCompProcess reply, an old service offers none
+static constexpr uint32_t SC_CHANNEL_UPDATE_RING = 0x1;
+// data bytes of the update ring shared by one process, see SecCompUpdateRing
+static constexpr uint32_t SC_UPDATE_RING_CAPACITY = 0x10000;
 
 static constexpr int32_t KEY_SPACE = 2050;
 static constexpr int32_t KEY_ENTER = 2054;
@@ -200,6 +220,14 @@ struct SecCompInfo {
     std::string componentInfo;
     SecCompClickEvent clickInfo;
 };
+
+// one component of a batch register, result and scId are filled per component
+struct SecCompRegisterItem {
+    SecCompType type = UNKNOWN_SC_TYPE;
+    std::string componentInfo;
+    int32_t result = 0;
+    int32_t scId = INVALID_SC_ID;
+};
 }  // namespace SecurityComponent
 }  // namespace Security
 }  // namespace OHOS
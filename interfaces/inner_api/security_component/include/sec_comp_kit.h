@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -17,6 +17,7 @@
 #define SECURITY_COMPONENT_API_CALLER __attribute__((optnone))
 
 #include <string>
+#include <vector>
 #include "accesstoken_kit.h"
 #include "iremote_object.h"
 #include "sec_comp_info.h"
@@ -30,10 +31,14 @@ public:
     static int32_t RegisterSecurityComponent(SecCompType type, std::string& componentInfo, int32_t& scId);
     static int32_t UpdateSecurityComponent(int32_t scId, std::string& componentInfo);
     static int32_t UnregisterSecurityComponent(int32_t scId);
+    // items whose result is not SC_OK on input are skipped, per item result and scId are filled back
+    static int32_t RegisterSecurityComponents(std::vector<SecCompRegisterItem>& items);
+    static int32_t UnregisterSecurityComponents(const std::vector<int32_t>& scIds, std::vector<int32_t>& results);
     static int32_t ReportSecurityComponentClickEvent(SecCompInfo& SecCompInfo, sptr<IRemoteObject> callerToken,
         OnFirstUseDialogCloseFunc&& callback, std::string& message);
     static bool VerifySavePermission(AccessToken::AccessTokenID tokenId);
     static int32_t PreRegisterSecCompProcess();
+    static uint32_t GetComponentInfoVersion();
     static bool IsServiceExist();
     static bool LoadService();
     static bool IsSystemAppCalling();
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2025-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,6 +16,7 @@
 #ifndef SEC_COMP_RAWDATA_H
 #define SEC_COMP_RAWDATA_H
 
+#include <memory>
 #include "securec.h"
 
 namespace OHOS {
@@ -29,9 +30,7 @@ public:
 
     ~SecCompRawdata()
     {
-        if (data != nullptr) {
-            delete[] static_cast<uint8_t*>(const_cast<void*>(data));
-        }
+        Reset();
     }
 
     int32_t RawDataCpy(const void* readData)
@@ -39,6 +38,9 @@ public:
         if ((size == 0) || (size >= MAX_RAW_DATA_SIZE)) {
             return -1;
         }
+        uint32_t len = size;
+        Reset();
+        size = len;
         uint8_t* buffer = new (std::nothrow) uint8_t[size];
         if (buffer == nullptr) {
             return -1;
@@ -51,6 +53,32 @@ public:
         data = reinterpret_cast<void *>(buffer);
         return 0;
     }
+
+    // view of a buffer owned by holder, no copy is made and holder is kept alive until reset
+    int32_t Borrow(const void* buffer, uint32_t len, std::shared_ptr<void> holder)
+    {
+        if ((buffer == nullptr) || (len == 0) || (len >= MAX_RAW_DATA_SIZE) || (holder == nullptr)) {
+            return -1;
+        }
+        Reset();
+        data = buffer;
+        size = len;
+        holder_ = std::move(holder);
+        return 0;
+    }
+
+    void Reset()
+    {
+        if ((data != nullptr) && (holder_ == nullptr)) {
+            delete[] static_cast<uint8_t*>(const_cast<void*>(data));
+        }
+        holder_ = nullptr;
+        data = nullptr;
+        size = 0;
+    }
+
+private:
+    std::shared_ptr<void> holder_ = nullptr;
 };
 }  // namespace SecurityComponent
 }  // namespace Security
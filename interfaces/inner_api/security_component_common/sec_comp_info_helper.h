@@ -24,11 +24,49 @@
 namespace OHOS {
 namespace Security {
 namespace SecurityComponent {
+// component info of one request, json forms are held in json and binary info is only viewed in the request
+// buffer, which must outlive the parsing, see SecCompService::ParseComponentInfo
+struct SecCompInfoPayload {
+    SecCompInfoPayload() = default;
+    SecCompInfoPayload(const nlohmann::json& jsonInfo) : json(jsonInfo) {}
+    nlohmann::json json;
+    const uint8_t* binary = nullptr;
+    size_t binaryLen = 0;
+    // json is an update delta object, see SC_DELTA_MAGIC
+    bool isDelta = false;
+};
+
 template<typename T>
-T* ConstructComponent(const nlohmann::json& jsonComponent, std::string& message, bool isClicked)
+T* ConstructComponent(const SecCompInfoPayload& info, std::string& message, bool isClicked)
 {
     T *componentPtr = new (std::nothrow)T();
-    if ((componentPtr != nullptr) && !componentPtr->FromJson(jsonComponent, message, isClicked)) {
+    if (componentPtr == nullptr) {
+        return nullptr;
+    }
+    // json text is deferred as a json string and parsed once the component type is known
+    bool isParsed = false;
+    if (info.binary != nullptr) {
+        isParsed = componentPtr->FromBinary(info.binary, info.binaryLen, message, isClicked);
+    } else if (info.json.is_string()) {
+        isParsed = componentPtr->FromJsonText(info.json.get_ref<const std::string&>(), message, isClicked);
+    } else {
+        isParsed = componentPtr->FromJson(info.json, message, isClicked);
+    }
+    if (!isParsed) {
+        delete componentPtr;
+        return nullptr;
+    }
+    return componentPtr;
+}
+
+template<typename T>
+T* ClonePatchedComponent(const SecCompBase* base, const nlohmann::json& jsonDelta, bool& isRectChanged)
+{
+    T *componentPtr = new (std::nothrow)T(*static_cast<const T*>(base));
+    if (componentPtr == nullptr) {
+        return nullptr;
+    }
+    if (!componentPtr->FromJsonDelta(jsonDelta, isRectChanged)) {
         delete componentPtr;
         return nullptr;
     }
@@ -46,14 +84,17 @@ struct ScreenInfo {
     OHOS::Rosen::ScreenShape screenShape;
 };
 
-    static SecCompBase* ParseComponent(SecCompType type, const nlohmann::json& jsonComponent, int32_t userId,
+    static SecCompBase* ParseComponent(SecCompType type, const SecCompInfoPayload& info, int32_t userId,
         std::string& message, bool isClicked = false);
+    static SecCompBase* PatchComponent(const SecCompBase* base, const nlohmann::json& jsonDelta,
+        std::string& message);
     static bool CheckComponentValid(SecCompBase* comp, std::string& message);
     static bool CheckRectValid(const SecCompRect& rect, const SecCompRect& windowRect, ScreenInfo& screenInfo,
         std::string& message, const float scale);
     static double GetDistance(DimensionT x1, DimensionT y1, DimensionT x2, DimensionT y2);
 
 private:
+    static void AdjustSecCompRectByWindow(SecCompBase* comp);
     static void AdjustSecCompRect(SecCompBase* comp, const Scales scales, bool isCompatScaleMode,
         SecCompRect& windowRect);
     static bool IsOutOfWatchScreen(const SecCompRect& rect, double radius, std::string& message);
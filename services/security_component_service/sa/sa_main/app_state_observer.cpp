@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,6 +14,8 @@
  */
 #include "app_state_observer.h"
 
+#include <algorithm>
+#include "sec_comp_bundle_info_cache.h"
 #include "sec_comp_log.h"
 #include "sec_comp_manager.h"
 
@@ -35,33 +37,52 @@ AppStateObserver::~AppStateObserver()
 
 bool AppStateObserver::IsProcessForeground(int32_t pid, int32_t uid)
 {
-    std::unique_lock<ffrt::shared_mutex> infoGuard(this->fgProcLock_);
-    for (auto iter = foregrandProcList_.begin(); iter != foregrandProcList_.end(); ++iter) {
-        if (pid == iter->pid) {
+    {
+        std::shared_lock<ffrt::shared_mutex> infoGuard(this->fgProcLock_);
+        if (fgPidProcMap_.find(pid) != fgPidProcMap_.end()) {
             return true;
         }
-
-        if ((iter->pid == -1) && (uid == iter->uid)) {
-            iter->pid = pid;
-            return true;
+        if (fgUidProcMap_.find(uid) == fgUidProcMap_.end()) {
+            return false;
         }
     }
-    return false;
+    return BackfillProcessPid(pid, uid);
+}
+
+bool AppStateObserver::BackfillProcessPid(int32_t pid, int32_t uid)
+{
+    std::unique_lock<ffrt::shared_mutex> infoGuard(this->fgProcLock_);
+    // the table may be changed between the shared and the exclusive lock, look up again
+    if (fgPidProcMap_.find(pid) != fgPidProcMap_.end()) {
+        return true;
+    }
+    auto iter = fgUidProcMap_.find(uid);
+    if (iter == fgUidProcMap_.end()) {
+        return false;
+    }
+    SecCompProcessData data = iter->second;
+    data.pid = pid;
+    fgUidProcMap_.erase(iter);
+    fgPidProcMap_.emplace(pid, data);
+    return true;
 }
 
 void AppStateObserver::AddProcessToForegroundSet(int32_t pid, const SecCompProcessData& data)
 {
     std::unique_lock<ffrt::shared_mutex> infoGuard(this->fgProcLock_);
-    for (auto iter = foregrandProcList_.begin(); iter != foregrandProcList_.end(); ++iter) {
-        if (pid == -1) {
-            if (iter->uid == data.uid) {
-                return;
-            }
-        } else if (pid == iter->pid) {
-            return;
-        }
+    if (pid != -1) {
+        fgPidProcMap_.emplace(pid, data);
+        return;
+    }
+    if (fgUidProcMap_.find(data.uid) != fgUidProcMap_.end()) {
+        return;
+    }
+    auto iter = std::find_if(fgPidProcMap_.begin(), fgPidProcMap_.end(),
+        [&data](const std::pair<const int32_t, SecCompProcessData>& proc) { return proc.second.uid == data.uid; });
+    if (iter != fgPidProcMap_.end()) {
+        return;
     }
-    foregrandProcList_.emplace_back(data);
+    fgUidProcMap_.emplace(data.uid, data);
 }
 
 void AppStateObserver::AddProcessToForegroundSet(const AppExecFwk::AppStateData& stateData)
@@ -71,6 +92,7 @@ void AppStateObserver::AddProcessToForegroundSet(const AppExecFwk::AppStateData&
         .pid = stateData.pid,
         .uid = stateData.uid
     };
+    SecCompBundleInfoCache::GetInstance().UpdateBundleName(stateData.uid, stateData.bundleName);
     AddProcessToForegroundSet(stateData.pid, proc);
 }
 
@@ -81,18 +103,14 @@ void AppStateObserver::AddProcessToForegroundSet(const AppExecFwk::ProcessData &
         .pid = processData.pid,
         .uid = processData.uid
     };
+    SecCompBundleInfoCache::GetInstance().UpdateBundleName(processData.uid, processData.bundleName);
     AddProcessToForegroundSet(processData.pid, proc);
 }
 
 void AppStateObserver::RemoveProcessFromForegroundSet(int32_t pid)
 {
     std::unique_lock<ffrt::shared_mutex> infoGuard(this->fgProcLock_);
-    for (auto iter = foregrandProcList_.begin(); iter != foregrandProcList_.end(); ++iter) {
-        if (pid == iter->pid) {
-            foregrandProcList_.erase(iter);
-            return;
-        }
-    }
+    fgPidProcMap_.erase(pid);
 }
 
 void AppStateObserver::OnProcessStateChanged(const AppExecFwk::ProcessData &processData)
@@ -109,6 +127,7 @@ void AppStateObserver::OnProcessStateChanged(const AppExecFwk::ProcessData &proc
 void AppStateObserver::OnProcessDied(const AppExecFwk::ProcessData& processData)
 {
     RemoveProcessFromForegroundSet(processData.pid);
+    SecCompBundleInfoCache::GetInstance().RemoveBundleInfo(processData.uid);
     SecCompManager::GetInstance().NotifyProcessDied(processData.pid, false);
 }
 
@@ -123,10 +142,12 @@ void AppStateObserver::OnAppCacheStateChanged(const AppExecFwk::AppStateData &ap
 
 void AppStateObserver::DumpProcess(std::string& dumpStr)
 {
-    std::unique_lock<ffrt::shared_mutex> infoGuard(this->fgProcLock_);
-    for (auto iter = foregrandProcList_.begin(); iter != foregrandProcList_.end(); ++iter) {
-        dumpStr.append("uid:" + std::to_string(iter->uid) + ", pid:" + std::to_string(iter->pid));
-        dumpStr.append(", procName:" + iter->bundleName + "\n");
+    std::shared_lock<ffrt::shared_mutex> infoGuard(this->fgProcLock_);
+    for (const auto& proc : { &fgPidProcMap_, &fgUidProcMap_ }) {
+        for (auto iter = proc->begin(); iter != proc->end(); ++iter) {
+            dumpStr.append("uid:" + std::to_string(iter->second.uid) + ", pid:" + std::to_string(iter->second.pid));
+            dumpStr.append(", procName:" + iter->second.bundleName + "\n");
+        }
     }
 }
 }  // namespace SecurityComponent
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,6 +16,7 @@
 #define SECURITY_COMPONENT_SA_APP_STATE_OBSERVER_APP_STATE_OBSERVER_H
 
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include "app_mgr_interface.h"
 #include "application_state_observer_stub.h"
@@ -47,7 +48,11 @@ public:
 
 private:
     void RemoveProcessFromForegroundSet(int32_t pid);
-    std::vector<SecCompProcessData> foregrandProcList_;
+    bool BackfillProcessPid(int32_t pid, int32_t uid);
+    // pid -> foreground process
+    std::unordered_map<int32_t, SecCompProcessData> fgPidProcMap_;
+    // uid -> foreground process whose pid is not known yet, moved to fgPidProcMap_ when its pid calls in
+    std::unordered_map<int32_t, SecCompProcessData> fgUidProcMap_;
     ffrt::shared_mutex fgProcLock_;
 };
 }  // namespace SecurityComponent
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "display_geometry_cache.h"
+
+#include "display.h"
+#include "display_info.h"
+#include "sec_comp_log.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
+    LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "DisplayGeometryCache"};
+static std::mutex g_instanceMutex;
+
+static int32_t GetCreaseFoldOffsetY(const std::vector<Rosen::Rect>& creaseRects)
+{
+    if (creaseRects.empty()) {
+        SC_LOG_ERROR(LABEL, "creaseRects is empty");
+        return 0;
+    }
+    const auto& rect = creaseRects.front();
+    SC_LOG_INFO(LABEL, "height: %{public}u, posY: %{public}d", rect.height_, rect.posY_);
+    return static_cast<int32_t>(rect.height_) + rect.posY_;
+}
+}
+
+DisplayGeometryCache& DisplayGeometryCache::GetInstance()
+{
+    static DisplayGeometryCache* instance = nullptr;
+    if (instance == nullptr) {
+        std::lock_guard<std::mutex> lock(g_instanceMutex);
+        if (instance == nullptr) {
+            instance = new DisplayGeometryCache();
+        }
+    }
+    return *instance;
+}
+
+void DisplayGeometryCache::DisplayListener::OnCreate(Rosen::DisplayId displayId)
+{
+    DisplayGeometryCache::GetInstance().UpdateDisplay(displayId);
+}
+
+void DisplayGeometryCache::DisplayListener::OnDestroy(Rosen::DisplayId displayId)
+{
+    DisplayGeometryCache::GetInstance().RemoveDisplay(displayId);
+}
+
+void DisplayGeometryCache::DisplayListener::OnChange(Rosen::DisplayId displayId)
+{
+    DisplayGeometryCache::GetInstance().UpdateDisplay(displayId);
+}
+
+void DisplayGeometryCache::FoldStatusListener::OnFoldStatusChanged(Rosen::FoldStatus foldStatus)
+{
+    SC_LOG_INFO(LABEL, "Fold status changed to %{public}u", static_cast<uint32_t>(foldStatus));
+    // display size and crease both change with fold status, reload them.
+    DisplayGeometryCache::GetInstance().Clear();
+    DisplayGeometryCache::GetInstance().UpdateFoldCrease();
+}
+
+bool DisplayGeometryCache::RegisterListeners()
+{
+    std::lock_guard<std::mutex> lock(listenerLock_);
+    if (displayListener_ != nullptr) {
+        SC_LOG_INFO(LABEL, "Display listeners already registered");
+        return true;
+    }
+    sptr<DisplayListener> displayListener = new (std::nothrow) DisplayListener();
+    sptr<FoldStatusListener> foldStatusListener = new (std::nothrow) FoldStatusListener();
+    if ((displayListener == nullptr) || (foldStatusListener == nullptr)) {
+        SC_LOG_ERROR(LABEL, "Failed to create display listeners");
+        return false;
+    }
+    auto& displayManager = Rosen::DisplayManager::GetInstance();
+    if (displayManager.RegisterDisplayListener(displayListener) != Rosen::DMError::DM_OK) {
+        SC_LOG_ERROR(LABEL, "Failed to register display listener");
+        return false;
+    }
+    if (displayManager.RegisterFoldStatusListener(foldStatusListener) != Rosen::DMError::DM_OK) {
+        SC_LOG_ERROR(LABEL, "Failed to register fold status listener");
+        displayManager.UnregisterDisplayListener(displayListener);
+        return false;
+    }
+    displayListener_ = displayListener;
+    foldStatusListener_ = foldStatusListener;
+    isListening_.store(true);
+    // events before registration are lost, drop anything loaded so far.
+    Clear();
+    SC_LOG_INFO(LABEL, "Register display listeners success");
+    return true;
+}
+
+void DisplayGeometryCache::UnregisterListeners()
+{
+    std::lock_guard<std::mutex> lock(listenerLock_);
+    if (displayListener_ == nullptr) {
+        return;
+    }
+    auto& displayManager = Rosen::DisplayManager::GetInstance();
+    displayManager.UnregisterDisplayListener(displayListener_);
+    displayManager.UnregisterFoldStatusListener(foldStatusListener_);
+    displayListener_ = nullptr;
+    foldStatusListener_ = nullptr;
+    isListening_.store(false);
+    Clear();
+}
+
+std::shared_ptr<const DisplayGeometrySnapshot> DisplayGeometryCache::LoadSnapshot() const
+{
+    return std::atomic_load(&snapshot_);
+}
+
+void DisplayGeometryCache::StoreSnapshot(std::shared_ptr<const DisplayGeometrySnapshot> snapshot)
+{
+    std::atomic_store(&snapshot_, std::move(snapshot));
+}
+
+bool DisplayGeometryCache::QueryDisplay(uint64_t displayId, DisplayGeometry& geometry)
+{
+    sptr<OHOS::Rosen::Display> display = OHOS::Rosen::DisplayManager::GetInstance().GetDisplayById(displayId);
+    if (display == nullptr) {
+        SC_LOG_ERROR(LABEL, "Get display manager failed");
+        return false;
+    }
+
+    auto info = display->GetDisplayInfo();
+    if (info == nullptr) {
+        SC_LOG_ERROR(LABEL, "Get display info failed");
+        return false;
+    }
+    geometry.width = static_cast<int32_t>(info->GetWidth());
+    geometry.height = static_cast<int32_t>(info->GetHeight());
+    geometry.physicalHeight = static_cast<int32_t>(info->GetPhysicalHeight());
+    geometry.availableHeight = static_cast<int32_t>(info->GetAvailableHeight());
+    geometry.screenShape = info->GetScreenShape();
+    return true;
+}
+
+bool DisplayGeometryCache::QueryFoldCrease(std::vector<Rosen::Rect>& creaseRects)
+{
+    auto foldCreaseRegion = OHOS::Rosen::DisplayManager::GetInstance().GetCurrentFoldCreaseRegion();
+    if (foldCreaseRegion == nullptr) {
+        SC_LOG_ERROR(LABEL, "foldCreaseRegion is nullptr");
+        return false;
+    }
+    creaseRects = foldCreaseRegion->GetCreaseRects();
+    return true;
+}
+
+void DisplayGeometryCache::SetDisplay(uint64_t displayId, const DisplayGeometry& geometry)
+{
+    std::lock_guard<std::mutex> lock(updateLock_);
+    generation_++;
+    auto snapshot = std::make_shared<DisplayGeometrySnapshot>(*LoadSnapshot());
+    snapshot->displays[displayId] = geometry;
+    StoreSnapshot(std::move(snapshot));
+}
+
+void DisplayGeometryCache::PublishQueriedDisplay(uint64_t displayId, const DisplayGeometry& geometry,
+    uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(updateLock_);
+    // a change seen while querying may be newer than the queried geometry, leave it to the next reader
+    if (generation_.load() != generation) {
+        return;
+    }
+    auto snapshot = std::make_shared<DisplayGeometrySnapshot>(*LoadSnapshot());
+    snapshot->displays[displayId] = geometry;
+    StoreSnapshot(std::move(snapshot));
+}
+
+bool DisplayGeometryCache::GetDisplayGeometry(uint64_t displayId, DisplayGeometry& geometry)
+{
+    if (!isListening_.load()) {
+        return QueryDisplay(displayId, geometry);
+    }
+    auto snapshot = LoadSnapshot();
+    auto iter = snapshot->displays.find(displayId);
+    if (iter != snapshot->displays.end()) {
+        geometry = iter->second;
+        return true;
+    }
+    uint64_t generation = generation_.load();
+    if (!QueryDisplay(displayId, geometry)) {
+        return false;
+    }
+    PublishQueriedDisplay(displayId, geometry, generation);
+    return true;
+}
+
+int32_t DisplayGeometryCache::GetFoldOffsetY()
+{
+    std::vector<Rosen::Rect> creaseRects;
+    if (!isListening_.load()) {
+        return QueryFoldCrease(creaseRects) ? GetCreaseFoldOffsetY(creaseRects) : 0;
+    }
+    auto snapshot = LoadSnapshot();
+    if (snapshot->isCreaseLoaded) {
+        return snapshot->foldOffsetY;
+    }
+    uint64_t generation = generation_.load();
+    if (!QueryFoldCrease(creaseRects)) {
+        return LoadSnapshot()->foldOffsetY;
+    }
+    int32_t foldOffsetY = GetCreaseFoldOffsetY(creaseRects);
+    StoreFoldCrease(std::move(creaseRects), foldOffsetY, &generation);
+    return foldOffsetY;
+}
+
+void DisplayGeometryCache::UpdateDisplay(uint64_t displayId)
+{
+    DisplayGeometry geometry;
+    if (!QueryDisplay(displayId, geometry)) {
+        // let the next reader query it again
+        RemoveDisplay(displayId);
+        return;
+    }
+    SetDisplay(displayId, geometry);
+}
+
+void DisplayGeometryCache::RemoveDisplay(uint64_t displayId)
+{
+    std::lock_guard<std::mutex> lock(updateLock_);
+    // a reader may be querying the display right now
+    generation_++;
+    auto current = LoadSnapshot();
+    if (current->displays.find(displayId) == current->displays.end()) {
+        return;
+    }
+    auto snapshot = std::make_shared<DisplayGeometrySnapshot>(*current);
+    snapshot->displays.erase(displayId);
+    StoreSnapshot(std::move(snapshot));
+}
+
+void DisplayGeometryCache::UpdateFoldCrease()
+{
+    std::vector<Rosen::Rect> creaseRects;
+    if (!QueryFoldCrease(creaseRects)) {
+        return;
+    }
+    int32_t foldOffsetY = GetCreaseFoldOffsetY(creaseRects);
+    StoreFoldCrease(std::move(creaseRects), foldOffsetY, nullptr);
+}
+
+void DisplayGeometryCache::StoreFoldCrease(std::vector<Rosen::Rect>&& creaseRects, int32_t foldOffsetY,
+    const uint64_t* queriedGeneration)
+{
+    std::lock_guard<std::mutex> lock(updateLock_);
+    if (queriedGeneration == nullptr) {
+        generation_++;
+    } else if (generation_.load() != *queriedGeneration) {
+        return;
+    }
+    auto snapshot = std::make_shared<DisplayGeometrySnapshot>(*LoadSnapshot());
+    snapshot->creaseRects = std::move(creaseRects);
+    snapshot->foldOffsetY = foldOffsetY;
+    snapshot->isCreaseLoaded = true;
+    StoreSnapshot(std::move(snapshot));
+}
+
+void DisplayGeometryCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(updateLock_);
+    generation_++;
+    StoreSnapshot(std::make_shared<DisplayGeometrySnapshot>());
+}
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
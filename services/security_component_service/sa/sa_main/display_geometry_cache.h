@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SECURITY_COMPONENT_DISPLAY_GEOMETRY_CACHE_H
+#define SECURITY_COMPONENT_DISPLAY_GEOMETRY_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "display_manager.h"
+#include "dm_common.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+struct DisplayGeometry {
+    int32_t width = 0;
+    int32_t height = 0;
+    int32_t physicalHeight = 0;
+    int32_t availableHeight = 0;
+    Rosen::ScreenShape screenShape = Rosen::ScreenShape::RECTANGLE;
+};
+
+// immutable once published, readers only take a reference
+struct DisplayGeometrySnapshot {
+    std::unordered_map<uint64_t, DisplayGeometry> displays;
+    std::vector<Rosen::Rect> creaseRects;
+    int32_t foldOffsetY = 0;
+    bool isCreaseLoaded = false;
+};
+
+class __attribute__((visibility("default"))) DisplayGeometryCache {
+public:
+    static DisplayGeometryCache& GetInstance();
+    virtual ~DisplayGeometryCache() = default;
+
+    bool RegisterListeners();
+    void UnregisterListeners();
+    bool GetDisplayGeometry(uint64_t displayId, DisplayGeometry& geometry);
+    int32_t GetFoldOffsetY();
+    void UpdateDisplay(uint64_t displayId);
+    void RemoveDisplay(uint64_t displayId);
+    void UpdateFoldCrease();
+    void Clear();
+
+private:
+    class DisplayListener : public Rosen::DisplayManager::IDisplayListener {
+    public:
+        void OnCreate(Rosen::DisplayId displayId) override;
+        void OnDestroy(Rosen::DisplayId displayId) override;
+        void OnChange(Rosen::DisplayId displayId) override;
+    };
+
+    class FoldStatusListener : public Rosen::DisplayManager::IFoldStatusListener {
+    public:
+        void OnFoldStatusChanged(Rosen::FoldStatus foldStatus) override;
+    };
+
+    DisplayGeometryCache() = default;
+    bool QueryDisplay(uint64_t displayId, DisplayGeometry& geometry);
+    bool QueryFoldCrease(std::vector<Rosen::Rect>& creaseRects);
+    void SetDisplay(uint64_t displayId, const DisplayGeometry& geometry);
+    void PublishQueriedDisplay(uint64_t displayId, const DisplayGeometry& geometry, uint64_t generation);
+    // queriedGeneration is null for a change from events
+    void StoreFoldCrease(std::vector<Rosen::Rect>&& creaseRects, int32_t foldOffsetY,
+        const uint64_t* queriedGeneration);
+    std::shared_ptr<const DisplayGeometrySnapshot> LoadSnapshot() const;
+    void StoreSnapshot(std::shared_ptr<const DisplayGeometrySnapshot> snapshot);
+
+    // serializes writers, readers load snapshot_ without it
+    std::mutex updateLock_;
+    std::shared_ptr<const DisplayGeometrySnapshot> snapshot_ = std::make_shared<DisplayGeometrySnapshot>();
+    // bumped by every change from events, a reader only publishes what it queried if nothing changed meanwhile
+    std::atomic<uint64_t> generation_ {0};
+    // without listeners nothing invalidates the cache, readers query every time
+    std::atomic<bool> isListening_ {false};
+    std::mutex listenerLock_;
+    sptr<DisplayListener> displayListener_ = nullptr;
+    sptr<FoldStatusListener> foldStatusListener_ = nullptr;
+    DISALLOW_COPY_AND_MOVE(DisplayGeometryCache);
+};
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
+#endif  // SECURITY_COMPONENT_DISPLAY_GEOMETRY_CACHE_H
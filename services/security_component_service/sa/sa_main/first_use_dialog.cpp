@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,25 +14,29 @@
  */
 #include "first_use_dialog.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <fcntl.h>
 #include <fstream>
+#include <map>
 #include <cstdlib>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include "ability_manager_client.h"
 #include "accesstoken_kit.h"
-#include "bundle_mgr_client.h"
-#include "display.h"
-#include "display_info.h"
-#include "display_manager.h"
+#include "display_geometry_cache.h"
 #include "hisysevent.h"
 #include "i_sec_comp_dialog_callback.h"
 #include "ipc_skeleton.h"
+#include "sec_comp_bundle_info_cache.h"
 #include "sec_comp_dialog_callback_proxy.h"
 #include "sec_comp_err.h"
+#include "sec_comp_latency_stats.h"
 #include "sec_comp_log.h"
+#include "sec_comp_manager.h"
 #include "want_params_wrapper.h"
 
 namespace OHOS {
@@ -43,6 +47,11 @@ constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, SECURITY_DOMAIN_SECURIT
 static const std::string SECURITY_COMPONENT_MANAGER = "security_component_manager";
 static const std::string SEC_COMP_SRV_CFG_PATH = "/data/service/el1/public/security_component_service";
 static const std::string FIRST_USE_RECORD_JSON = SEC_COMP_SRV_CFG_PATH + "/first_use_record.json";
+static const std::string FIRST_USE_RECORD_DAT = SEC_COMP_SRV_CFG_PATH + "/first_use_record.dat";
+static const std::string FIRST_USE_RECORD_TMP = FIRST_USE_RECORD_DAT + ".tmp";
+static const std::string FIRST_USE_RECORD_JOURNAL = SEC_COMP_SRV_CFG_PATH + "/first_use_record.journal";
+static const std::string FLUSH_FIRST_USE_RECORD_TASK = "FlushFirstUseRecord";
+static const std::string LOAD_FIRST_USE_RECORD_TASK = "LoadFirstUseRecord";
 static const std::string FIRST_USE_RECORD_TAG = "FirstUseRecord";
 static const std::string TOKEN_ID_TAG = "TokenId";
 static const std::string COMP_TYPE_TAG = "CompType";
@@ -65,6 +74,14 @@ const std::string TOAST_OFFSET = "ohos.toast.offset";
 
 constexpr int32_t DISPLAY_HALF_RATIO = 2;
 constexpr uint32_t MAX_CFG_FILE_SIZE = 100 * 1024; // 100k
+constexpr uint32_t FIRST_USE_RECORD_MAGIC = 0x46555352; // "FUSR"
+constexpr uint32_t FIRST_USE_SNAPSHOT_MAGIC = 0x4655534E; // "FUSN"
+constexpr uint32_t MAX_SNAPSHOT_RECORD_NUM = 64 * 1024;
+constexpr int64_t FLUSH_FIRST_USE_RECORD_DELAY_MILLISECONDS = 1000;
+// journal is compacted when it has more records than this or than the records in memory
+constexpr uint32_t MIN_COMPACT_JOURNAL_RECORD_NUM = 128;
+// journal is compacted before an append would pass this, so it is always read back whole
+constexpr uint32_t MAX_JOURNAL_RECORD_NUM = MAX_SNAPSHOT_RECORD_NUM;
 constexpr uint64_t LOCATION_BUTTON_FIRST_USE = 1 << 0;
 constexpr uint64_t SAVE_BUTTON_FIRST_USE = 1 << 1;
 constexpr int32_t ABOVE_BOTTOM_OFFSET = 80;
@@ -72,6 +89,61 @@ constexpr int32_t BELOW_TOP_OFFSET = 112;
 static std::mutex g_instanceMutex;
 static std::unordered_map<TipPosition, int32_t> tipPositionsMap = {{TipPosition::ABOVE_BOTTOM, ABOVE_BOTTOM_OFFSET},
     {TipPosition::BELOW_TOP, BELOW_TOP_OFFSET}};
+
+static bool WriteAll(int fd, const void* data, size_t size)
+{
+    const char* buf = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t len = write(fd, buf, size);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        buf += len;
+        size -= static_cast<size_t>(len);
+    }
+    return true;
+}
+
+static ssize_t ReadAll(int fd, void* data, size_t size)
+{
+    char* buf = static_cast<char*>(data);
+    size_t total = 0;
+    while (total < size) {
+        ssize_t len = read(fd, buf + total, size - total);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        if (len == 0) {
+            break;
+        }
+        total += static_cast<size_t>(len);
+    }
+    return static_cast<ssize_t>(total);
+}
+
+static bool CompareRecordTokenId(const FirstUseRecordItem& record, AccessToken::AccessTokenID tokenId)
+{
+    return record.tokenId < tokenId;
+}
+
+static void SyncCfgDir(void)
+{
+    int fd = open(SEC_COMP_SRV_CFG_PATH.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        SC_LOG_ERROR(LABEL, "open dir %{public}s failed, errno %{public}d.", SEC_COMP_SRV_CFG_PATH.c_str(), errno);
+        return;
+    }
+    if (fsync(fd) != 0) {
+        SC_LOG_ERROR(LABEL, "sync dir %{public}s failed, errno %{public}d.", SEC_COMP_SRV_CFG_PATH.c_str(), errno);
+    }
+    close(fd);
+}
 }
 
 bool ReportUserData(const std::string& filePath, const std::string& folderPath)
@@ -129,6 +201,11 @@ FirstUseDialog& FirstUseDialog::GetInstance()
     return *instance;
 }
 
+FirstUseDialog::~FirstUseDialog()
+{
+    UnmapFirstUseSnapshot(snapshot_);
+}
+
 bool FirstUseDialog::IsCfgDirExist(void)
 {
     struct stat fstat = {};
@@ -144,16 +221,6 @@ bool FirstUseDialog::IsCfgDirExist(void)
     return true;
 }
 
-bool FirstUseDialog::IsCfgFileExist(void)
-{
-    struct stat fstat = {};
-    if (stat(FIRST_USE_RECORD_JSON.c_str(), &fstat) != 0) {
-        SC_LOG_INFO(LABEL, "path %{public}s errno %{public}d.", FIRST_USE_RECORD_JSON.c_str(), errno);
-        return false;
-    }
-    return true;
-}
-
 bool FirstUseDialog::IsCfgFileValid(void)
 {
     struct stat fstat = {};
@@ -190,23 +257,80 @@ bool FirstUseDialog::ReadCfgContent(std::string& content)
     return true;
 }
 
-void FirstUseDialog::WriteCfgContent(const std::string& content)
+bool FirstUseDialog::WriteFirstUseSnapshot(const std::vector<FirstUseRecordItem>& records)
 {
-    char* canonicalPath = realpath(FIRST_USE_RECORD_JSON.c_str(), nullptr);
-    if (canonicalPath == nullptr) {
-        SC_LOG_ERROR(LABEL, "Cannot get canonical path for %{public}s, errno %{public}d.",
-            FIRST_USE_RECORD_JSON.c_str(), errno);
-        return;
+    if (records.size() > MAX_SNAPSHOT_RECORD_NUM) {
+        SC_LOG_ERROR(LABEL, "too many first use records %{public}zu.", records.size());
+        return false;
     }
-    std::ofstream out(canonicalPath);
-    if (!out.is_open()) {
-        SC_LOG_ERROR(LABEL, "cannot open file %{public}s, errno %{public}d.", canonicalPath, errno);
-        free(canonicalPath);
-        return;
+    // a crash leaves either the old snapshot or the new one, never a partly written file
+    int fd = open(FIRST_USE_RECORD_TMP.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        SC_LOG_ERROR(LABEL, "cannot open file %{public}s, errno %{public}d.", FIRST_USE_RECORD_TMP.c_str(), errno);
+        return false;
     }
-    out << content;
-    free(canonicalPath);
-    out.close();
+    FirstUseSnapshotHeader header = { FIRST_USE_SNAPSHOT_MAGIC, static_cast<uint32_t>(records.size()), 0 };
+    bool isWritten = WriteAll(fd, &header, sizeof(header)) &&
+        WriteAll(fd, records.data(), records.size() * sizeof(FirstUseRecordItem)) && (fsync(fd) == 0);
+    close(fd);
+    if (!isWritten || (rename(FIRST_USE_RECORD_TMP.c_str(), FIRST_USE_RECORD_DAT.c_str()) != 0)) {
+        SC_LOG_ERROR(LABEL, "write file %{public}s failed, errno %{public}d.", FIRST_USE_RECORD_DAT.c_str(), errno);
+        unlink(FIRST_USE_RECORD_TMP.c_str());
+        return false;
+    }
+    SyncCfgDir();
+    return true;
+}
+
+bool FirstUseDialog::MapFirstUseSnapshot(FirstUseSnapshot& snapshot)
+{
+    int fd = open(FIRST_USE_RECORD_DAT.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        SC_LOG_INFO(LABEL, "path %{public}s errno %{public}d.", FIRST_USE_RECORD_DAT.c_str(), errno);
+        return false;
+    }
+    struct stat fstat = {};
+    if ((::fstat(fd, &fstat) != 0) || (fstat.st_size < static_cast<off_t>(sizeof(FirstUseSnapshotHeader))) ||
+        (fstat.st_size > static_cast<off_t>(sizeof(FirstUseSnapshotHeader) +
+        MAX_SNAPSHOT_RECORD_NUM * sizeof(FirstUseRecordItem)))) {
+        SC_LOG_ERROR(LABEL, "path %{public}s size is invalid.", FIRST_USE_RECORD_DAT.c_str());
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(fstat.st_size);
+    void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        SC_LOG_ERROR(LABEL, "map %{public}s failed, errno %{public}d.", FIRST_USE_RECORD_DAT.c_str(), errno);
+        return false;
+    }
+
+    const FirstUseSnapshotHeader* header = static_cast<const FirstUseSnapshotHeader*>(addr);
+    const FirstUseRecordItem* records = reinterpret_cast<const FirstUseRecordItem*>(header + 1);
+    bool isValid = (header->magic == FIRST_USE_SNAPSHOT_MAGIC) &&
+        (size == sizeof(FirstUseSnapshotHeader) + static_cast<size_t>(header->recordNum) * sizeof(FirstUseRecordItem));
+    for (uint32_t i = 0; isValid && (i < header->recordNum); ++i) {
+        isValid = (records[i].magic == FIRST_USE_RECORD_MAGIC) &&
+            ((i == 0) || (records[i - 1].tokenId < records[i].tokenId));
+    }
+    if (!isValid) {
+        SC_LOG_ERROR(LABEL, "path %{public}s content is invalid.", FIRST_USE_RECORD_DAT.c_str());
+        munmap(addr, size);
+        return false;
+    }
+    snapshot.addr = addr;
+    snapshot.size = size;
+    snapshot.records = records;
+    snapshot.recordNum = header->recordNum;
+    return true;
+}
+
+void FirstUseDialog::UnmapFirstUseSnapshot(FirstUseSnapshot& snapshot)
+{
+    if (snapshot.addr != nullptr) {
+        munmap(snapshot.addr, snapshot.size);
+    }
+    snapshot = FirstUseSnapshot();
 }
 
 bool FirstUseDialog::ParseRecord(nlohmann::json& jsonRes,
@@ -253,7 +377,7 @@ void FirstUseDialog::ParseRecords(nlohmann::json& jsonRes)
     }
 }
 
-void FirstUseDialog::LoadFirstUseRecord(void)
+void FirstUseDialog::LoadFirstUseJsonRecord(void)
 {
     if (!IsCfgFileValid()) {
         SC_LOG_INFO(LABEL, "first use record is invalid.");
@@ -274,46 +398,237 @@ void FirstUseDialog::LoadFirstUseRecord(void)
     ParseRecords(jsonRes);
 }
 
-void FirstUseDialog::SaveFirstUseRecord(void)
+void FirstUseDialog::LoadFirstUseSnapshot(void)
+{
+    FirstUseSnapshot snapshot;
+    bool isMapped = MapFirstUseSnapshot(snapshot);
+    {
+        std::unique_lock<std::mutex> lock(useMapMutex_);
+        std::swap(snapshot_, snapshot);
+    }
+    UnmapFirstUseSnapshot(snapshot);
+    if (!isMapped) {
+        // records saved as json by older versions, moved to the snapshot by the next compaction
+        LoadFirstUseJsonRecord();
+    }
+}
+
+void FirstUseDialog::LoadFirstUseJournal(void)
+{
+    int fd = open(FIRST_USE_RECORD_JOURNAL.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        SC_LOG_INFO(LABEL, "path %{public}s errno %{public}d.", FIRST_USE_RECORD_JOURNAL.c_str(), errno);
+        return;
+    }
+    struct stat fstat = {};
+    std::vector<FirstUseRecordItem> records;
+    ssize_t readLen = -1;
+    if (::fstat(fd, &fstat) == 0) {
+        records.resize(std::min<size_t>(static_cast<size_t>(fstat.st_size) / sizeof(FirstUseRecordItem),
+            MAX_JOURNAL_RECORD_NUM));
+        readLen = ReadAll(fd, records.data(), records.size() * sizeof(FirstUseRecordItem));
+    }
+    close(fd);
+    if (readLen < 0) {
+        SC_LOG_ERROR(LABEL, "read %{public}s failed, errno %{public}d.", FIRST_USE_RECORD_JOURNAL.c_str(), errno);
+        return;
+    }
+    if (static_cast<size_t>(fstat.st_size) > MAX_JOURNAL_RECORD_NUM * sizeof(FirstUseRecordItem)) {
+        SC_LOG_ERROR(LABEL, "journal size %{public}lld is over limit.", static_cast<long long>(fstat.st_size));
+    }
+
+    records.resize(static_cast<size_t>(readLen) / sizeof(FirstUseRecordItem));
+    bool isIntact = (fstat.st_size == readLen) && ((readLen % sizeof(FirstUseRecordItem)) == 0);
+    uint32_t recordNum = 0;
+    {
+        std::unique_lock<std::mutex> lock(useMapMutex_);
+        for (const auto& record : records) {
+            if (record.magic != FIRST_USE_RECORD_MAGIC) {
+                SC_LOG_ERROR(LABEL, "journal record %{public}u is broken.", recordNum);
+                isIntact = false;
+                break;
+            }
+            ++recordNum;
+            if (record.tokenId != AccessToken::INVALID_TOKENID) {
+                firstUseMap_[record.tokenId] = record.compTypes;
+            }
+        }
+    }
+    journalRecordNum_ = recordNum;
+    // a torn tail would misalign every later append, fold what is readable into the json and restart
+    if (!isIntact) {
+        CompactFirstUseRecord();
+    }
+}
+
+void FirstUseDialog::LoadFirstUseRecordLocked(void)
+{
+    LoadFirstUseSnapshot();
+    LoadFirstUseJournal();
+    isRecordLoaded_.store(true, std::memory_order_release);
+}
+
+void FirstUseDialog::LoadFirstUseRecord(void)
+{
+    std::unique_lock<std::mutex> fileLock(recordFileMutex_);
+    LoadFirstUseRecordLocked();
+}
+
+void FirstUseDialog::EnsureFirstUseRecordLoaded(void)
 {
-    SC_LOG_INFO(LABEL, "start save first_use_record json");
+    if (isRecordLoaded_.load(std::memory_order_acquire)) {
+        return;
+    }
+    std::unique_lock<std::mutex> fileLock(recordFileMutex_);
+    if (!isRecordLoaded_.load(std::memory_order_relaxed)) {
+        StartupPhaseTimer timer(STARTUP_PHASE_LOAD_FIRST_USE_RECORD);
+        LoadFirstUseRecordLocked();
+    }
+}
+
+uint64_t FirstUseDialog::GetFirstUseCompTypes(AccessToken::AccessTokenID tokenId)
+{
+    auto iter = firstUseMap_.find(tokenId);
+    if (iter != firstUseMap_.end()) {
+        return iter->second;
+    }
+    const FirstUseRecordItem* end = snapshot_.records + snapshot_.recordNum;
+    const FirstUseRecordItem* record = std::lower_bound(snapshot_.records, end, tokenId, CompareRecordTokenId);
+    if ((record != end) && (record->tokenId == tokenId)) {
+        return record->compTypes;
+    }
+    return 0;
+}
+
+bool FirstUseDialog::AppendFirstUseJournal(const std::vector<FirstUseRecordItem>& records)
+{
+    int fd = open(FIRST_USE_RECORD_JOURNAL.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0) {
+        SC_LOG_ERROR(LABEL, "cannot open file %{public}s, errno %{public}d.", FIRST_USE_RECORD_JOURNAL.c_str(), errno);
+        return false;
+    }
+    bool isWritten = WriteAll(fd, records.data(), records.size() * sizeof(FirstUseRecordItem)) &&
+        (fdatasync(fd) == 0);
+    close(fd);
+    if (!isWritten) {
+        SC_LOG_ERROR(LABEL, "append %{public}s failed, errno %{public}d.", FIRST_USE_RECORD_JOURNAL.c_str(), errno);
+        return false;
+    }
+    journalRecordNum_ += static_cast<uint32_t>(records.size());
+    return true;
+}
+
+void FirstUseDialog::CompactFirstUseRecord(void)
+{
+    SC_LOG_INFO(LABEL, "start save first use record snapshot");
     if (!IsCfgDirExist()) {
         SC_LOG_ERROR(LABEL, "dir %{public}s is not exist, errno %{public}d",
             SEC_COMP_SRV_CFG_PATH.c_str(), errno);
         return;
     }
 
-    if (!IsCfgFileExist()) {
-        if (creat(FIRST_USE_RECORD_JSON.c_str(), S_IRUSR | S_IWUSR) == -1) {
-            SC_LOG_ERROR(LABEL, "create %{public}s failed, errno %{public}d",
-                FIRST_USE_RECORD_JSON.c_str(), errno);
-            return;
+    std::map<AccessToken::AccessTokenID, uint64_t> mergedRecords;
+    {
+        std::unique_lock<std::mutex> lock(useMapMutex_);
+        for (uint32_t i = 0; i < snapshot_.recordNum; ++i) {
+            mergedRecords[snapshot_.records[i].tokenId] = snapshot_.records[i].compTypes;
+        }
+        for (const auto& record : firstUseMap_) {
+            mergedRecords[record.first] = record.second;
+        }
+    }
+
+    // tokens of uninstalled apps are only checked here, the journal appending does no ipc
+    std::vector<FirstUseRecordItem> records;
+    std::vector<AccessToken::AccessTokenID> staleTokens;
+    for (const auto& record : mergedRecords) {
+        if (record.first == AccessToken::INVALID_TOKENID) {
+            continue;
+        }
+        AccessToken::HapTokenInfo info;
+        if (AccessToken::AccessTokenKit::GetHapTokenInfo(record.first, info) != AccessToken::RET_SUCCESS) {
+            SC_LOG_INFO(LABEL, "token id %{public}d is not exist, remove it.", record.first);
+            staleTokens.emplace_back(record.first);
+            continue;
         }
+        records.push_back({ FIRST_USE_RECORD_MAGIC, record.first, record.second });
+    }
+    if (!WriteFirstUseSnapshot(records)) {
+        return;
     }
 
-    nlohmann::json jsonRes;
+    FirstUseSnapshot snapshot;
+    bool isMapped = MapFirstUseSnapshot(snapshot);
     {
         std::unique_lock<std::mutex> lock(useMapMutex_);
-        nlohmann::json recordsJson;
-        for (auto iter = firstUseMap_.begin(); iter != firstUseMap_.end(); ++iter) {
-            AccessToken::AccessTokenID id = iter->first;
-            AccessToken::HapTokenInfo info;
-            if (AccessToken::AccessTokenKit::GetHapTokenInfo(id, info) != AccessToken::RET_SUCCESS) {
-                SC_LOG_INFO(LABEL, "token id %{public}d is not exist, do not update it.", id);
-                continue;
+        if (isMapped) {
+            std::swap(snapshot_, snapshot);
+            // records changed while writing stay in firstUseMap_
+            for (const auto& record : records) {
+                auto iter = firstUseMap_.find(record.tokenId);
+                if ((iter != firstUseMap_.end()) && (iter->second == record.compTypes)) {
+                    firstUseMap_.erase(iter);
+                }
             }
-            nlohmann::json recordJson;
-            recordJson[TOKEN_ID_TAG] = id;
-            recordJson[COMP_TYPE_TAG] = iter->second;
-            recordsJson.emplace_back(recordJson);
         }
+        for (AccessToken::AccessTokenID tokenId : staleTokens) {
+            firstUseMap_.erase(tokenId);
+        }
+    }
+    UnmapFirstUseSnapshot(snapshot);
 
-        jsonRes[FIRST_USE_RECORD_TAG] = recordsJson;
+    if (((unlink(FIRST_USE_RECORD_JOURNAL.c_str()) != 0) && (errno != ENOENT)) ||
+        ((unlink(FIRST_USE_RECORD_JSON.c_str()) != 0) && (errno != ENOENT))) {
+        SC_LOG_ERROR(LABEL, "remove merged record failed, errno %{public}d", errno);
+        return;
     }
-    if (!ReportUserData(FIRST_USE_RECORD_JSON, DATA_FOLDER)) {
+    journalRecordNum_ = 0;
+    if (!ReportUserData(FIRST_USE_RECORD_DAT, DATA_FOLDER)) {
         SC_LOG_ERROR(LABEL, "report user data failed.");
     }
-    WriteCfgContent(jsonRes.dump());
+}
+
+void FirstUseDialog::SaveFirstUseRecord(void)
+{
+    EnsureFirstUseRecordLoaded();
+    std::unique_lock<std::mutex> fileLock(recordFileMutex_);
+    CompactFirstUseRecord();
+}
+
+void FirstUseDialog::FlushFirstUseRecord(void)
+{
+    EnsureFirstUseRecordLoaded();
+    std::unique_lock<std::mutex> fileLock(recordFileMutex_);
+    std::vector<FirstUseRecordItem> records;
+    size_t recordNum;
+    {
+        std::unique_lock<std::mutex> lock(useMapMutex_);
+        isFlushPosted_ = false;
+        for (AccessToken::AccessTokenID tokenId : dirtyTokens_) {
+            auto iter = firstUseMap_.find(tokenId);
+            if ((tokenId == AccessToken::INVALID_TOKENID) || (iter == firstUseMap_.end())) {
+                continue;
+            }
+            records.push_back({ FIRST_USE_RECORD_MAGIC, tokenId, iter->second });
+        }
+        dirtyTokens_.clear();
+        recordNum = snapshot_.recordNum + firstUseMap_.size();
+    }
+    if (records.empty()) {
+        return;
+    }
+    if (!IsCfgDirExist()) {
+        SC_LOG_ERROR(LABEL, "dir %{public}s is not exist, errno %{public}d",
+            SEC_COMP_SRV_CFG_PATH.c_str(), errno);
+        return;
+    }
+
+    SC_LOG_INFO(LABEL, "append %{public}zu first use records", records.size());
+    // the records are in memory as well, a batch passing the journal limit goes to the snapshot instead
+    if ((journalRecordNum_ + records.size() > MAX_JOURNAL_RECORD_NUM) || !AppendFirstUseJournal(records) ||
+        (journalRecordNum_ >= std::max<size_t>(MIN_COMPACT_JOURNAL_RECORD_NUM, recordNum))) {
+        CompactFirstUseRecord();
+    }
 }
 
 void FirstUseDialog::RemoveDialogWaitEntitys(int32_t pid)
@@ -345,9 +660,7 @@ int32_t FirstUseDialog::GrantDialogWaitEntity(int32_t scId)
     }
     int32_t res = sc->GrantTempPermission();
     if (res != SC_OK) {
-        OHOS::AppExecFwk::BundleMgrClient bmsClient;
-        std::string bundleName = "";
-        bmsClient.GetNameForUid(sc->uid_, bundleName);
+        std::string bundleName = SecCompBundleInfoCache::GetInstance().GetBundleName(sc->uid_);
         HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "TEMP_GRANT_FAILED",
             HiviewDFX::HiSysEvent::EventType::FAULT, "CALLER_UID", sc->uid_, "CALLER_BUNDLE_NAME", bundleName,
             "CALLER_PID", sc->pid_, "SC_ID", scId, "SC_TYPE", sc->GetType());
@@ -357,31 +670,26 @@ int32_t FirstUseDialog::GrantDialogWaitEntity(int32_t scId)
             "CALLER_PID", sc->pid_, "SC_ID", scId, "SC_TYPE", sc->GetType());
     }
     dialogWaitMap_.erase(scId);
+    lock.unlock();
+    SecCompManager::GetInstance().CommitDialogGrantState(sc);
     return res;
 }
 
 bool FirstUseDialog::SetDisplayInfo(AAFwk::Want& want, const DisplayInfo& displayInfo)
 {
-    sptr<OHOS::Rosen::Display> display =
-        OHOS::Rosen::DisplayManager::GetInstance().GetDisplayById(displayInfo.displayId);
-    if (display == nullptr) {
-        SC_LOG_ERROR(LABEL, "Get display manager failed");
-        return false;
-    }
-
-    auto info = display->GetDisplayInfo();
-    if (info == nullptr) {
-        SC_LOG_ERROR(LABEL, "Get display info failed");
+    DisplayGeometry geometry;
+    if (!DisplayGeometryCache::GetInstance().GetDisplayGeometry(displayInfo.displayId, geometry)) {
+        SC_LOG_ERROR(LABEL, "Get display geometry failed");
         return false;
     }
     /* crossAxisState is INVALID or NO_CROSS */
-    int32_t width = info->GetWidth();
-    int32_t height = info->GetHeight();
+    int32_t width = geometry.width;
+    int32_t height = geometry.height;
     int32_t offset = 0;
     /* crossAxisState is CROSS */
     if (displayInfo.crossAxisState == CrossAxisState::STATE_CROSS) {
-        height = info->GetPhysicalHeight();
-        offset = static_cast<int32_t>(info->GetAvailableHeight()) / DISPLAY_HALF_RATIO;
+        height = geometry.physicalHeight;
+        offset = geometry.availableHeight / DISPLAY_HALF_RATIO;
     }
     SC_LOG_INFO(LABEL, "Display info width %{public}d height %{public}d, dialog offset %{public}d",
         width, height, offset);
@@ -470,8 +778,12 @@ bool FirstUseDialog::StartDialogAbility(std::shared_ptr<SecCompEntity> entity, s
 
 void FirstUseDialog::SendSaveEventHandler(void)
 {
+    // called with useMapMutex_ held, all changes within the delay are written by one flush
+    if (isFlushPosted_) {
+        return;
+    }
     std::function<void()> delayed = ([this]() {
-        this->SaveFirstUseRecord();
+        this->FlushFirstUseRecord();
     });
 
     SC_LOG_INFO(LABEL, "Delay first_use_record json");
@@ -479,7 +791,8 @@ void FirstUseDialog::SendSaveEventHandler(void)
         SC_LOG_ERROR(LABEL, "event handler invalid.");
         return;
     }
-    secHandler_->ProxyPostTask(delayed);
+    isFlushPosted_ = secHandler_->ProxyPostTask(delayed, FLUSH_FIRST_USE_RECORD_TASK,
+        FLUSH_FIRST_USE_RECORD_DELAY_MILLISECONDS);
 }
 
 bool FirstUseDialog::SetFirstUseMap(std::shared_ptr<SecCompEntity> entity)
@@ -502,16 +815,15 @@ bool FirstUseDialog::SetFirstUseMap(std::shared_ptr<SecCompEntity> entity)
         return false;
     }
 
+    EnsureFirstUseRecordLoaded();
     std::unique_lock<std::mutex> lock(useMapMutex_);
     AccessToken::AccessTokenID tokenId = entity->tokenId_;
-    auto iter = firstUseMap_.find(tokenId);
-    if (iter == firstUseMap_.end()) {
-        firstUseMap_[tokenId] = typeMask;
-        SendSaveEventHandler();
+    uint64_t compTypes = GetFirstUseCompTypes(tokenId);
+    if ((compTypes & typeMask) == typeMask) {
         return true;
     }
-
-    firstUseMap_[tokenId] |= typeMask;
+    firstUseMap_[tokenId] = compTypes | typeMask;
+    dirtyTokens_.insert(tokenId);
     SendSaveEventHandler();
     return true;
 }
@@ -519,6 +831,7 @@ bool FirstUseDialog::SetFirstUseMap(std::shared_ptr<SecCompEntity> entity)
 int32_t FirstUseDialog::NotifyFirstUseDialog(std::shared_ptr<SecCompEntity> entity, sptr<IRemoteObject> callerToken,
     sptr<IRemoteObject> dialogCallback, const DisplayInfo& displayInfo)
 {
+    LatencyStageTimer timer(LATENCY_STAGE_NOTIFY_FIRST_USE_DIALOG);
     if (entity == nullptr) {
         SC_LOG_ERROR(LABEL, "Entity is invalid.");
         return SC_SERVICE_ERROR_VALUE_INVALID;
@@ -548,10 +861,10 @@ int32_t FirstUseDialog::NotifyFirstUseDialog(std::shared_ptr<SecCompEntity> enti
         return SC_OK;
     }
 
+    EnsureFirstUseRecordLoaded();
     std::unique_lock<std::mutex> lock(useMapMutex_);
-    AccessToken::AccessTokenID tokenId = entity->tokenId_;
-    auto iter = firstUseMap_.find(tokenId);
-    if (iter == firstUseMap_.end()) {
+    uint64_t compTypes = GetFirstUseCompTypes(entity->tokenId_);
+    if (compTypes == 0) {
         SC_LOG_INFO(LABEL, "has not use record, start dialog");
         if (!StartDialogAbility(entity, callerToken, dialogCallback, displayInfo)) {
             return SC_SERVICE_ERROR_START_FIRST_USE_DIALOG_FAILED;
@@ -559,7 +872,6 @@ int32_t FirstUseDialog::NotifyFirstUseDialog(std::shared_ptr<SecCompEntity> enti
         return SC_SERVICE_ERROR_WAIT_FOR_DIALOG_CLOSE;
     }
 
-    uint64_t compTypes = firstUseMap_[tokenId];
     if ((typeMask == SAVE_BUTTON_FIRST_USE) && ((compTypes & typeMask) == typeMask)) {
         SC_LOG_INFO(LABEL, "no need notify dialog again.");
         StartToastAbility(entity, callerToken, displayInfo);
@@ -575,7 +887,13 @@ void FirstUseDialog::Init(std::shared_ptr<SecEventHandler> secHandler)
 {
     SC_LOG_DEBUG(LABEL, "Init!!");
     secHandler_ = secHandler;
-    LoadFirstUseRecord();
+    // records are loaded off the service start path, the first user waits for it if it has not run yet
+    std::function<void()> loadTask = ([this]() {
+        this->EnsureFirstUseRecordLoaded();
+    });
+    if ((secHandler_ == nullptr) || !secHandler_->ProxyPostTask(loadTask, LOAD_FIRST_USE_RECORD_TASK)) {
+        SC_LOG_ERROR(LABEL, "post load first use record task failed.");
+    }
 }
 }  // namespace SecurityComponent
 }  // namespace Security
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,11 +15,14 @@
 #ifndef FIRST_USE_DIALOG_H
 #define FIRST_USE_DIALOG_H
 
+#include <atomic>
 #include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_set>
+#include <vector>
 #include "access_token.h"
 #include "iremote_object.h"
 #include "nlohmann/json.hpp"
@@ -35,6 +38,27 @@ namespace Security {
 namespace SecurityComponent {
 bool ReportUserData(const std::string& filePath, const std::string& folderPath);
 
+// one record of the first use journal or snapshot, in the journal a later record of the same token wins
+struct FirstUseRecordItem {
+    uint32_t magic;
+    uint32_t tokenId;
+    uint64_t compTypes;
+};
+
+struct FirstUseSnapshotHeader {
+    uint32_t magic;
+    uint32_t recordNum;
+    uint64_t reserved;
+};
+
+// first use snapshot mapped read only, records are sorted by tokenId
+struct FirstUseSnapshot {
+    void* addr = nullptr;
+    size_t size = 0;
+    const FirstUseRecordItem* records = nullptr;
+    uint32_t recordNum = 0;
+};
+
 class SecCompDialogSrvCallback : public SecCompDialogCallbackStub {
 public:
     explicit SecCompDialogSrvCallback(int32_t scId, std::shared_ptr<SecCompEntity> sc,
@@ -63,26 +87,36 @@ struct DisplayInfo {
 
     static FirstUseDialog& GetInstance();
 
-    ~FirstUseDialog() = default;
+    ~FirstUseDialog();
     int32_t NotifyFirstUseDialog(std::shared_ptr<SecCompEntity> entity, sptr<IRemoteObject> callerToken,
         sptr<IRemoteObject> dialogCallback, const DisplayInfo& displayInfo);
     void Init(std::shared_ptr<SecEventHandler> secHandler);
     int32_t GrantDialogWaitEntity(int32_t scId);
     void RemoveDialogWaitEntitys(int32_t pid);
     bool SetFirstUseMap(std::shared_ptr<SecCompEntity> entity);
+    void FlushFirstUseRecord(void);
 
 private:
     FirstUseDialog() {};
     bool IsCfgDirExist(void);
-    bool IsCfgFileExist(void);
     bool IsCfgFileValid(void);
     bool ReadCfgContent(std::string& content);
-    void WriteCfgContent(const std::string& content);
     bool ParseRecord(nlohmann::json& jsonRes,
         AccessToken::AccessTokenID& id, uint64_t& type);
     void ParseRecords(nlohmann::json& jsonRes);
+    static bool MapFirstUseSnapshot(FirstUseSnapshot& snapshot);
+    static void UnmapFirstUseSnapshot(FirstUseSnapshot& snapshot);
+    bool WriteFirstUseSnapshot(const std::vector<FirstUseRecordItem>& records);
+    void LoadFirstUseJsonRecord(void);
+    void LoadFirstUseSnapshot(void);
+    void LoadFirstUseRecordLocked(void);
     void LoadFirstUseRecord(void);
+    void EnsureFirstUseRecordLoaded(void);
+    void LoadFirstUseJournal(void);
+    bool AppendFirstUseJournal(const std::vector<FirstUseRecordItem>& records);
+    uint64_t GetFirstUseCompTypes(AccessToken::AccessTokenID tokenId);
     void SaveFirstUseRecord(void);
+    void CompactFirstUseRecord(void);
     bool StartDialogAbility(std::shared_ptr<SecCompEntity> entity, sptr<IRemoteObject> callerToken,
         sptr<IRemoteObject> dialogCallback, const DisplayInfo& displayInfo);
     void StartToastAbility(const std::shared_ptr<SecCompEntity> entity, const sptr<IRemoteObject> callerToken,
@@ -91,9 +125,19 @@ private:
     void SendSaveEventHandler(void);
 
     std::mutex useMapMutex_;
+    // records changed after snapshot_ was written, looked up before it
     std::unordered_map<AccessToken::AccessTokenID, uint64_t> firstUseMap_;
+    // replaced under both recordFileMutex_ and useMapMutex_, read under either
+    FirstUseSnapshot snapshot_;
     std::unordered_map<int32_t, std::shared_ptr<SecCompEntity>> dialogWaitMap_;
     std::shared_ptr<SecEventHandler> secHandler_;
+    // tokens changed since the last flush, guarded by useMapMutex_
+    std::unordered_set<AccessToken::AccessTokenID> dirtyTokens_;
+    bool isFlushPosted_ = false;
+    // serializes journal appending and compaction, taken before useMapMutex_
+    std::mutex recordFileMutex_;
+    uint32_t journalRecordNum_ = 0;
+    std::atomic<bool> isRecordLoaded_ { false };
 };
 }  // namespace SecurityComponentEnhance
 }  // namespace Security
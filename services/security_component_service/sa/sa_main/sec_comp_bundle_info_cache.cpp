@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sec_comp_bundle_info_cache.h"
+
+#include <algorithm>
+#include "bundle_mgr_client.h"
+#include "sec_comp_err.h"
+#include "sec_comp_log.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
+    LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompBundleInfoCache"};
+static constexpr size_t MAX_BUNDLE_INFO_CACHE_SIZE = 256;
+static std::mutex g_instanceMutex;
+}
+
+SecCompBundleInfoCache& SecCompBundleInfoCache::GetInstance()
+{
+    static SecCompBundleInfoCache* instance = nullptr;
+    if (instance == nullptr) {
+        std::lock_guard<std::mutex> lock(g_instanceMutex);
+        if (instance == nullptr) {
+            instance = new SecCompBundleInfoCache();
+        }
+    }
+    return *instance;
+}
+
+bool SecCompBundleInfoCache::FindBundleInfo(int32_t uid, SecCompBundleInfo& info)
+{
+    std::shared_lock<ffrt::shared_mutex> lk(this->cacheLock_);
+    auto iter = bundleInfoMap_.find(uid);
+    if (iter == bundleInfoMap_.end()) {
+        return false;
+    }
+    info = iter->second;
+    return true;
+}
+
+void SecCompBundleInfoCache::AddBundleInfo(int32_t uid, const SecCompBundleInfo& info)
+{
+    std::unique_lock<ffrt::shared_mutex> lk(this->cacheLock_);
+    auto iter = bundleInfoMap_.find(uid);
+    if (iter != bundleInfoMap_.end()) {
+        if (iter->second.bundleName == info.bundleName) {
+            iter->second.hasVersionName = iter->second.hasVersionName || info.hasVersionName;
+            iter->second.versionName = info.hasVersionName ? info.versionName : iter->second.versionName;
+        } else {
+            iter->second = info;
+        }
+        return;
+    }
+    if (bundleInfoMap_.size() >= MAX_BUNDLE_INFO_CACHE_SIZE) {
+        bundleInfoMap_.erase(insertOrder_.front());
+        insertOrder_.pop_front();
+    }
+    bundleInfoMap_[uid] = info;
+    insertOrder_.emplace_back(uid);
+}
+
+std::string SecCompBundleInfoCache::GetBundleName(int32_t uid)
+{
+    SecCompBundleInfo info;
+    if (FindBundleInfo(uid, info)) {
+        hitCount_++;
+        return info.bundleName;
+    }
+    missCount_++;
+    OHOS::AppExecFwk::BundleMgrClient bmsClient;
+    int32_t ret = bmsClient.GetNameForUid(uid, info.bundleName);
+    if (ret != SC_OK) {
+        SC_LOG_ERROR(LABEL, "Failed to get bundle name, uid=%{public}d, ret=%{public}d", uid, ret);
+        return "";
+    }
+    AddBundleInfo(uid, info);
+    return info.bundleName;
+}
+
+bool SecCompBundleInfoCache::GetBundleInfo(int32_t uid, int32_t userId, SecCompBundleInfo& info)
+{
+    info = SecCompBundleInfo();
+    if (FindBundleInfo(uid, info) && info.hasVersionName) {
+        hitCount_++;
+        return true;
+    }
+    missCount_++;
+    OHOS::AppExecFwk::BundleMgrClient bmsClient;
+    if (info.bundleName.empty()) {
+        int32_t ret = bmsClient.GetNameForUid(uid, info.bundleName);
+        if (ret != SC_OK) {
+            SC_LOG_ERROR(LABEL, "Failed to get bundle name, uid=%{public}d, ret=%{public}d", uid, ret);
+            return false;
+        }
+    }
+
+    AppExecFwk::BundleInfo bundleInfo;
+    if (!bmsClient.GetBundleInfo(info.bundleName, AppExecFwk::BundleFlag::GET_BUNDLE_DEFAULT, bundleInfo, userId)) {
+        SC_LOG_ERROR(LABEL, "Failed to get bundle info for bundle name %{public}s", info.bundleName.c_str());
+        AddBundleInfo(uid, info);
+        return false;
+    }
+    info.versionName = bundleInfo.versionName;
+    info.hasVersionName = true;
+    AddBundleInfo(uid, info);
+    return true;
+}
+
+void SecCompBundleInfoCache::UpdateBundleName(int32_t uid, const std::string& bundleName)
+{
+    if (bundleName.empty()) {
+        return;
+    }
+    SecCompBundleInfo info;
+    info.bundleName = bundleName;
+    AddBundleInfo(uid, info);
+}
+
+void SecCompBundleInfoCache::RemoveBundleInfo(int32_t uid)
+{
+    std::unique_lock<ffrt::shared_mutex> lk(this->cacheLock_);
+    if (bundleInfoMap_.erase(uid) == 0) {
+        return;
+    }
+    auto iter = std::find(insertOrder_.begin(), insertOrder_.end(), uid);
+    if (iter != insertOrder_.end()) {
+        insertOrder_.erase(iter);
+    }
+}
+
+void SecCompBundleInfoCache::DumpBundleInfoCache(std::string& dumpStr)
+{
+    std::shared_lock<ffrt::shared_mutex> lk(this->cacheLock_);
+    dumpStr.append("bundle info cache size:" + std::to_string(bundleInfoMap_.size()) +
+        ", hit:" + std::to_string(hitCount_.load()) + ", miss:" + std::to_string(missCount_.load()) + "\n");
+}
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
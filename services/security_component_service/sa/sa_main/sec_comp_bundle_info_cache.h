@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SECURITY_COMPONENT_BUNDLE_INFO_CACHE_H
+#define SECURITY_COMPONENT_BUNDLE_INFO_CACHE_H
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include "ffrt.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+struct SecCompBundleInfo {
+    std::string bundleName;
+    std::string versionName;
+    bool hasVersionName = false;
+};
+
+class SecCompBundleInfoCache {
+public:
+    static SecCompBundleInfoCache& GetInstance();
+    virtual ~SecCompBundleInfoCache() = default;
+
+    std::string GetBundleName(int32_t uid);
+    bool GetBundleInfo(int32_t uid, int32_t userId, SecCompBundleInfo& info);
+    void UpdateBundleName(int32_t uid, const std::string& bundleName);
+    void RemoveBundleInfo(int32_t uid);
+    void DumpBundleInfoCache(std::string& dumpStr);
+
+private:
+    SecCompBundleInfoCache() = default;
+    bool FindBundleInfo(int32_t uid, SecCompBundleInfo& info);
+    void AddBundleInfo(int32_t uid, const SecCompBundleInfo& info);
+
+    // uid -> bundle info, evicted in insert order when full
+    std::unordered_map<int32_t, SecCompBundleInfo> bundleInfoMap_;
+    std::deque<int32_t> insertOrder_;
+    ffrt::shared_mutex cacheLock_;
+    std::atomic<uint64_t> hitCount_ {0};
+    std::atomic<uint64_t> missCount_ {0};
+    DISALLOW_COPY_AND_MOVE(SecCompBundleInfoCache);
+};
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
+#endif  // SECURITY_COMPONENT_BUNDLE_INFO_CACHE_H
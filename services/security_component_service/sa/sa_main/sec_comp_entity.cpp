@@ -16,15 +16,16 @@
 
 #include <chrono>
 #include <ctime>
-#include "bundle_mgr_client.h"
 #include "datashare_helper.h"
 #include "hisysevent.h"
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
 #include "isec_comp_service.h"
+#include "sec_comp_bundle_info_cache.h"
 #include "sec_comp_err.h"
 #include "sec_comp_enhance_adapter.h"
 #include "sec_comp_info_helper.h"
+#include "sec_comp_latency_stats.h"
 #include "sec_comp_log.h"
 #include "window_info_helper.h"
 
@@ -41,6 +42,7 @@ static constexpr uint32_t FOLD_VIRTUAL_DISPLAY_ID = 999;
 
 int32_t SecCompEntity::GrantTempPermission()
 {
+    LatencyStageTimer timer(LATENCY_STAGE_GRANT_TEMP_PERMISSION);
     isGrant_ = true;
     return SecCompPermManager::GetInstance().GrantTempPermission(tokenId_, componentInfo_);
 }
@@ -156,7 +158,10 @@ int32_t SecCompEntity::CheckClickInfo(SecCompClickEvent& clickInfo, int32_t supe
         return res;
     }
 
-    res = SecCompEnhanceAdapter::CheckAndUpdateExtraInfo(clickInfo);
+    {
+        LatencyStageTimer timer(LATENCY_STAGE_CHECK_EXTRA_INFO);
+        res = SecCompEnhanceAdapter::CheckAndUpdateExtraInfo(clickInfo);
+    }
     if (res == SC_SERVICE_ERROR_CLICK_EVENT_INVALID) {
         SC_LOG_ERROR(LABEL, "Click ExtraInfo is invalid");
         return res;
@@ -165,9 +170,7 @@ int32_t SecCompEntity::CheckClickInfo(SecCompClickEvent& clickInfo, int32_t supe
     if ((res != SC_OK) && (res != SC_ENHANCE_ERROR_NOT_EXIST_ENHANCE)) {
         SC_LOG_ERROR(LABEL, "HMAC checkout failed");
         int32_t uid = IPCSkeleton::GetCallingUid();
-        OHOS::AppExecFwk::BundleMgrClient bmsClient;
-        std::string bundleName = "";
-        bmsClient.GetNameForUid(uid, bundleName);
+        std::string bundleName = SecCompBundleInfoCache::GetInstance().GetBundleName(uid);
         HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "CLICK_INFO_CHECK_FAILED",
             HiviewDFX::HiSysEvent::EventType::SECURITY, "CALLER_UID", uid, "CALLER_BUNDLE_NAME", bundleName,
             "CALLER_PID", IPCSkeleton::GetCallingPid(), "SC_ID", scId_, "SC_TYPE", componentInfo_->type_);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -52,6 +52,11 @@ public:
         return isGrant_;
     }
 
+    void SetGrant(bool isGrant)
+    {
+        isGrant_ = isGrant;
+    }
+
     void SetCustomAuthorizationStatus(bool isCustomAuthorized)
     {
         isCustomAuthorized_ = isCustomAuthorized;
@@ -102,6 +107,8 @@ public:
     int32_t userId_;
     bool isCustomAuthorized_ = false;
     bool bypassSecurityCheck_ = false;
+    // changed whenever componentInfo_ is committed, used to detect concurrent changes
+    uint32_t version_ = 0;
 
 private:
     int32_t CheckKeyEvent(const SecCompClickEvent& clickInfo) const;
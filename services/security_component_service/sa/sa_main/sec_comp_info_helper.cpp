@@ -19,15 +19,14 @@
 #include <sstream>
 
 #include "accesstoken_kit.h"
-#include "display.h"
-#include "display_info.h"
-#include "display_manager.h"
+#include "display_geometry_cache.h"
 #include "ipc_skeleton.h"
 #include "location_button.h"
 #include "paste_button.h"
 #include "save_button.h"
 #include "sec_comp_err.h"
 #include "sec_comp_info.h"
+#include "sec_comp_latency_stats.h"
 #include "sec_comp_log.h"
 #include "sec_comp_tool.h"
 #include "tokenid_kit.h"
@@ -76,20 +75,35 @@ void SecCompInfoHelper::AdjustSecCompRect(SecCompBase* comp, const Scales scales
         comp->rect_.x_, comp->rect_.y_, comp->rect_.width_, comp->rect_.height_);
 }
 
-SecCompBase* SecCompInfoHelper::ParseComponent(SecCompType type, const nlohmann::json& jsonComponent, int32_t userId,
+void SecCompInfoHelper::AdjustSecCompRectByWindow(SecCompBase* comp)
+{
+    comp->rawRect_ = comp->rect_;
+    comp->rawWindowRect_ = comp->windowRect_;
+    bool isCompatScaleMode = false;
+    SecCompRect scaleRect;
+    Scales scales = WindowInfoHelper::GetWindowScale(comp->windowId_, comp->userId_, isCompatScaleMode, scaleRect);
+    if ((!IsEqual(scales.floatingScale, WindowInfoHelper::FULL_SCREEN_SCALE) && !IsEqual(scales.floatingScale, 0.0)) ||
+        (!IsEqual(scales.scaleX, WindowInfoHelper::FULL_SCREEN_SCALE) && !IsEqual(scales.scaleX, 0.0)) ||
+        (!IsEqual(scales.scaleY, WindowInfoHelper::FULL_SCREEN_SCALE) && !IsEqual(scales.scaleY, 0.0)) ||
+        isCompatScaleMode || comp->isSmartEdgeState_) {
+        AdjustSecCompRect(comp, scales, isCompatScaleMode, scaleRect);
+    }
+}
+
+SecCompBase* SecCompInfoHelper::ParseComponent(SecCompType type, const SecCompInfoPayload& info, int32_t userId,
     std::string& message, bool isClicked)
 {
     SecCompBase* comp = nullptr;
     message.clear();
     switch (type) {
         case LOCATION_COMPONENT:
-            comp = ConstructComponent<LocationButton>(jsonComponent, message, isClicked);
+            comp = ConstructComponent<LocationButton>(info, message, isClicked);
             break;
         case PASTE_COMPONENT:
-            comp = ConstructComponent<PasteButton>(jsonComponent, message, isClicked);
+            comp = ConstructComponent<PasteButton>(info, message, isClicked);
             break;
         case SAVE_COMPONENT:
-            comp = ConstructComponent<SaveButton>(jsonComponent, message, isClicked);
+            comp = ConstructComponent<SaveButton>(info, message, isClicked);
             break;
         default:
             SC_LOG_ERROR(LABEL, "Parse component type unknown");
@@ -108,25 +122,18 @@ SecCompBase* SecCompInfoHelper::ParseComponent(SecCompType type, const nlohmann:
 
 static bool GetScreenSize(double& width, double& height, SecCompInfoHelper::ScreenInfo& screenInfo)
 {
-    sptr<OHOS::Rosen::Display> display =
-        OHOS::Rosen::DisplayManager::GetInstance().GetDisplayById(screenInfo.displayId);
-    if (display == nullptr) {
-        SC_LOG_ERROR(LABEL, "Get display manager failed");
+    DisplayGeometry geometry;
+    if (!DisplayGeometryCache::GetInstance().GetDisplayGeometry(screenInfo.displayId, geometry)) {
+        SC_LOG_ERROR(LABEL, "Get display geometry failed");
         return false;
     }
 
-    auto info = display->GetDisplayInfo();
-    if (info == nullptr) {
-        SC_LOG_ERROR(LABEL, "Get display info failed");
-        return false;
-    }
-
-    screenInfo.screenShape = info->GetScreenShape();
-    width = static_cast<double>(info->GetWidth());
+    screenInfo.screenShape = geometry.screenShape;
+    width = static_cast<double>(geometry.width);
     if (screenInfo.crossAxisState == CrossAxisState::STATE_CROSS) {
-        height = static_cast<double>(info->GetPhysicalHeight());
+        height = static_cast<double>(geometry.physicalHeight);
     } else {
-        height = static_cast<double>(info->GetHeight());
+        height = static_cast<double>(geometry.height);
     }
     SC_LOG_DEBUG(LABEL, "display manager Screen width %{public}f height %{public}f",
         width, height);
@@ -332,7 +339,7 @@ static bool CheckSecCompBaseButton(const SecCompBase* comp, std::string& message
     return CheckSecCompBaseButtonColorsimilar(comp, message);
 }
 
-static bool CheckSecCompBase(const SecCompBase* comp, std::string& message)
+static bool CheckParentEffect(const SecCompBase* comp, std::string& message)
 {
     if (comp->parentEffect_) {
         SC_LOG_ERROR(LABEL,
@@ -340,6 +347,14 @@ static bool CheckSecCompBase(const SecCompBase* comp, std::string& message)
         message = "PARENT_HAVE_INVALID_EFFECT";
         return false;
     }
+    return true;
+}
+
+static bool CheckSecCompBase(const SecCompBase* comp, std::string& message)
+{
+    if (!CheckParentEffect(comp, message)) {
+        return false;
+    }
 
     if ((comp->padding_.top < MIN_PADDING_SIZE) || (comp->padding_.right < MIN_PADDING_SIZE) ||
         (comp->padding_.bottom < MIN_PADDING_SIZE) || (comp->padding_.left < MIN_PADDING_SIZE)) {
@@ -377,21 +392,13 @@ static bool CheckSecCompBase(const SecCompBase* comp, std::string& message)
 
 bool SecCompInfoHelper::CheckComponentValid(SecCompBase* comp, std::string& message)
 {
+    LatencyStageTimer timer(LATENCY_STAGE_CHECK_COMPONENT_VALID);
     if ((comp == nullptr) || !IsComponentTypeValid(comp->type_)) {
         SC_LOG_INFO(LABEL, "comp is null or type is invalid.");
         return false;
     }
 
-    bool isCompatScaleMode = false;
-    SecCompRect scaleRect;
-    Scales scales = WindowInfoHelper::GetWindowScale(comp->windowId_, comp->userId_, isCompatScaleMode, scaleRect);
-    if ((!IsEqual(scales.floatingScale, WindowInfoHelper::FULL_SCREEN_SCALE) && !IsEqual(scales.floatingScale, 0.0)) ||
-        (!IsEqual(scales.scaleX, WindowInfoHelper::FULL_SCREEN_SCALE) && !IsEqual(scales.scaleX, 0.0)) ||
-        (!IsEqual(scales.scaleY, WindowInfoHelper::FULL_SCREEN_SCALE) && !IsEqual(scales.scaleY, 0.0)) ||
-        isCompatScaleMode || comp->isSmartEdgeState_) {
-        AdjustSecCompRect(comp, scales, isCompatScaleMode, scaleRect);
-    }
-
+    AdjustSecCompRectByWindow(comp);
     if (!CheckSecCompBase(comp, message)) {
         SC_LOG_INFO(LABEL, "SecComp base is invalid.");
         return false;
@@ -399,6 +406,48 @@ bool SecCompInfoHelper::CheckComponentValid(SecCompBase* comp, std::string& mess
 
     return true;
 }
+SecCompBase* SecCompInfoHelper::PatchComponent(const SecCompBase* base, const nlohmann::json& jsonDelta,
+    std::string& message)
+{
+    SecCompBase* comp = nullptr;
+    bool isRectChanged = false;
+    message.clear();
+    if (base == nullptr) {
+        SC_LOG_ERROR(LABEL, "Patch base component is null");
+        return nullptr;
+    }
+    switch (base->type_) {
+        case LOCATION_COMPONENT:
+            comp = ClonePatchedComponent<LocationButton>(base, jsonDelta, isRectChanged);
+            break;
+        case PASTE_COMPONENT:
+            comp = ClonePatchedComponent<PasteButton>(base, jsonDelta, isRectChanged);
+            break;
+        case SAVE_COMPONENT:
+            comp = ClonePatchedComponent<SaveButton>(base, jsonDelta, isRectChanged);
+            break;
+        default:
+            SC_LOG_ERROR(LABEL, "Patch component type unknown");
+            break;
+    }
+    if (comp == nullptr) {
+        SC_LOG_ERROR(LABEL, "Patch component failed");
+        return comp;
+    }
+
+    // the window scale may change without the rect, so the raw rects are always re-adjusted
+    if (!isRectChanged) {
+        comp->rect_ = base->rawRect_;
+        comp->windowRect_ = base->rawWindowRect_;
+    }
+    comp->scale_ = 1.0f;
+    comp->isCompatScaleMode_ = false;
+    AdjustSecCompRectByWindow(comp);
+    // style is untouched by a delta, a valid component can only be invalidated by its parent
+    comp->SetValid(comp->GetValid() ? CheckParentEffect(comp, message) : CheckSecCompBase(comp, message));
+    comp->isClickEvent_ = false;
+    return comp;
+}
 }  // namespace SecurityComponent
 }  // namespace Security
 }  // namespace OHOS
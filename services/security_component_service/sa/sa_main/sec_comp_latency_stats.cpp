@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sec_comp_latency_stats.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+namespace {
+static constexpr uint64_t MAX_LATENCY_VALUE = UINT32_MAX;
+static constexpr uint32_t PERCENT_BASE = 100;
+static constexpr uint32_t DUMP_PERCENTILES[] = { 50, 90, 99 };
+static const char* const OPERATION_NAMES[LATENCY_OP_BUTT] = {
+    "register", "update", "click", "batchRegister", "unregister", "batchUnregister"
+};
+static const char* const STAGE_NAMES[LATENCY_STAGE_BUTT] = {
+    "total", "parseInfo", "checkComponentValid", "getWindowScale", "checkRectInfo",
+    "checkWindowCover", "checkInfoEnhance", "checkExtraInfo", "grantTempPermission", "notifyFirstUseDialog", "lockWait",
+    "waitDeferredInit"
+};
+static const char* const STARTUP_PHASE_NAMES[STARTUP_PHASE_BUTT] = {
+    "total", "registerAppStateObserver", "startEnhanceService", "createEventRunner", "firstUseDialogInit",
+    "enableInputEnhance", "publish", "loadFirstUseRecord"
+};
+static thread_local LatencyOperation g_currentOperation = LATENCY_OP_BUTT;
+static std::mutex g_instanceMutex;
+
+static uint64_t GetElapsedMicroseconds(const std::chrono::steady_clock::time_point& start)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+}
+
+uint32_t LatencyHistogram::GetBucketIndex(uint64_t value)
+{
+    value = std::min(value, MAX_LATENCY_VALUE);
+    if (value < SUB_BUCKET_NUM) {
+        return static_cast<uint32_t>(value);
+    }
+    uint32_t msb = static_cast<uint32_t>(63 - __builtin_clzll(value)); // 63: highest bit index of uint64_t
+    uint32_t shift = msb - SUB_BUCKET_BITS;
+    return ((shift + 1) << SUB_BUCKET_BITS) + static_cast<uint32_t>((value >> shift) & (SUB_BUCKET_NUM - 1));
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(uint32_t index)
+{
+    if (index < SUB_BUCKET_NUM) {
+        return index;
+    }
+    uint32_t shift = (index >> SUB_BUCKET_BITS) - 1;
+    uint64_t lower = static_cast<uint64_t>(SUB_BUCKET_NUM + (index & (SUB_BUCKET_NUM - 1))) << shift;
+    return lower + (static_cast<uint64_t>(1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t value)
+{
+    buckets_[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    uint64_t curMax = max_.load(std::memory_order_relaxed);
+    while ((value > curMax) && !max_.compare_exchange_weak(curMax, value, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other)
+{
+    for (uint32_t i = 0; i < BUCKET_NUM; ++i) {
+        buckets_[i].fetch_add(other.buckets_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    count_.fetch_add(other.GetCount(), std::memory_order_relaxed);
+    sum_.fetch_add(other.GetSum(), std::memory_order_relaxed);
+    uint64_t otherMax = other.GetMax();
+    uint64_t curMax = max_.load(std::memory_order_relaxed);
+    while ((otherMax > curMax) && !max_.compare_exchange_weak(curMax, otherMax, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::Reset()
+{
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetCount() const
+{
+    return count_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetSum() const
+{
+    return sum_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetMax() const
+{
+    return max_.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetPercentile(uint32_t percent) const
+{
+    // buckets are read one by one while recording goes on, the sum is the count actually seen
+    uint64_t total = 0;
+    for (const auto& bucket : buckets_) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = std::max<uint64_t>((total * percent + PERCENT_BASE - 1) / PERCENT_BASE, 1);
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < BUCKET_NUM; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(GetBucketUpperBound(i), GetMax());
+        }
+    }
+    return GetMax();
+}
+
+SecCompLatencyStats& SecCompLatencyStats::GetInstance()
+{
+    static SecCompLatencyStats* instance = nullptr;
+    if (instance == nullptr) {
+        std::lock_guard<std::mutex> lock(g_instanceMutex);
+        if (instance == nullptr) {
+            instance = new SecCompLatencyStats();
+        }
+    }
+    return *instance;
+}
+
+LatencyOperation SecCompLatencyStats::GetCurrentOperation()
+{
+    return g_currentOperation;
+}
+
+void SecCompLatencyStats::SetCurrentOperation(LatencyOperation op)
+{
+    g_currentOperation = op;
+}
+
+void SecCompLatencyStats::Record(LatencyOperation op, LatencyStage stage, uint64_t value)
+{
+    if ((op >= LATENCY_OP_BUTT) || (stage >= LATENCY_STAGE_BUTT)) {
+        return;
+    }
+    histograms_[op][stage].Record(value);
+}
+
+const LatencyHistogram& SecCompLatencyStats::GetHistogram(LatencyOperation op, LatencyStage stage) const
+{
+    // out of range values fall to the last item instead of reading out of bounds
+    op = std::min(op, static_cast<LatencyOperation>(LATENCY_OP_BUTT - 1));
+    stage = std::min(stage, static_cast<LatencyStage>(LATENCY_STAGE_BUTT - 1));
+    return histograms_[op][stage];
+}
+
+void SecCompLatencyStats::RecordStartupPhase(StartupPhase phase, uint64_t value)
+{
+    if (phase >= STARTUP_PHASE_BUTT) {
+        return;
+    }
+    startupPhases_[phase].store(value, std::memory_order_relaxed);
+}
+
+uint64_t SecCompLatencyStats::GetStartupPhase(StartupPhase phase) const
+{
+    if (phase >= STARTUP_PHASE_BUTT) {
+        return 0;
+    }
+    return startupPhases_[phase].load(std::memory_order_relaxed);
+}
+
+void SecCompLatencyStats::Dump(std::string& dumpStr)
+{
+    dumpStr.append("startup in us:");
+    for (uint32_t phase = 0; phase < STARTUP_PHASE_BUTT; ++phase) {
+        dumpStr.append(std::string(" ") + STARTUP_PHASE_NAMES[phase] + " " +
+            std::to_string(startupPhases_[phase].load(std::memory_order_relaxed)));
+    }
+    dumpStr.append("\n");
+    dumpStr.append("latency in us, percentiles are bucket upper bounds\n");
+    for (uint32_t op = 0; op < LATENCY_OP_BUTT; ++op) {
+        for (uint32_t stage = 0; stage < LATENCY_STAGE_BUTT; ++stage) {
+            const LatencyHistogram& histogram = histograms_[op][stage];
+            if (histogram.GetCount() == 0) {
+                continue;
+            }
+            dumpStr.append(std::string(OPERATION_NAMES[op]) + "." + STAGE_NAMES[stage] +
+                ": count " + std::to_string(histogram.GetCount()));
+            for (uint32_t percent : DUMP_PERCENTILES) {
+                dumpStr.append(", p" + std::to_string(percent) + " " +
+                    std::to_string(histogram.GetPercentile(percent)));
+            }
+            dumpStr.append(", max " + std::to_string(histogram.GetMax()) + "\n");
+        }
+    }
+}
+
+void SecCompLatencyStats::Reset()
+{
+    for (auto& opHistograms : histograms_) {
+        for (auto& histogram : opHistograms) {
+            histogram.Reset();
+        }
+    }
+}
+
+LatencyOperationScope::LatencyOperationScope(LatencyOperation op)
+    : op_(op), prevOp_(SecCompLatencyStats::GetCurrentOperation()), start_(std::chrono::steady_clock::now())
+{
+    SecCompLatencyStats::SetCurrentOperation(op_);
+}
+
+LatencyOperationScope::~LatencyOperationScope()
+{
+    SecCompLatencyStats::GetInstance().Record(op_, LATENCY_STAGE_TOTAL, GetElapsedMicroseconds(start_));
+    SecCompLatencyStats::SetCurrentOperation(prevOp_);
+}
+
+LatencyStageTimer::LatencyStageTimer(LatencyStage stage)
+    : op_(SecCompLatencyStats::GetCurrentOperation()), stage_(stage)
+{
+    if (op_ != LATENCY_OP_BUTT) {
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+LatencyStageTimer::~LatencyStageTimer()
+{
+    if (op_ != LATENCY_OP_BUTT) {
+        SecCompLatencyStats::GetInstance().Record(op_, stage_, GetElapsedMicroseconds(start_));
+    }
+}
+
+StartupPhaseTimer::StartupPhaseTimer(StartupPhase phase)
+    : phase_(phase), start_(std::chrono::steady_clock::now())
+{
+}
+
+StartupPhaseTimer::~StartupPhaseTimer()
+{
+    Finish();
+}
+
+void StartupPhaseTimer::Finish()
+{
+    if (isFinished_) {
+        return;
+    }
+    isFinished_ = true;
+    SecCompLatencyStats::GetInstance().RecordStartupPhase(phase_, GetElapsedMicroseconds(start_));
+}
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
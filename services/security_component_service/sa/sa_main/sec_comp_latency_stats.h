@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SECURITY_COMPONENT_LATENCY_STATS_H
+#define SECURITY_COMPONENT_LATENCY_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+enum LatencyOperation : uint32_t {
+    LATENCY_OP_REGISTER = 0,
+    LATENCY_OP_UPDATE,
+    LATENCY_OP_CLICK,
+    // a whole batch, its items are not measured one by one
+    LATENCY_OP_BATCH_REGISTER,
+    LATENCY_OP_UNREGISTER,
+    LATENCY_OP_BATCH_UNREGISTER,
+    LATENCY_OP_BUTT,
+};
+
+enum LatencyStage : uint32_t {
+    LATENCY_STAGE_TOTAL = 0,
+    LATENCY_STAGE_PARSE_INFO,
+    LATENCY_STAGE_CHECK_COMPONENT_VALID,
+    LATENCY_STAGE_GET_WINDOW_SCALE,
+    LATENCY_STAGE_CHECK_RECT_INFO,
+    LATENCY_STAGE_CHECK_WINDOW_COVER,
+    LATENCY_STAGE_CHECK_INFO_ENHANCE,
+    LATENCY_STAGE_CHECK_EXTRA_INFO,
+    LATENCY_STAGE_GRANT_TEMP_PERMISSION,
+    LATENCY_STAGE_NOTIFY_FIRST_USE_DIALOG,
+    LATENCY_STAGE_LOCK_WAIT,
+    LATENCY_STAGE_WAIT_DEFERRED_INIT,
+    LATENCY_STAGE_BUTT,
+};
+
+// phases of one service start, only the last start is kept
+enum StartupPhase : uint32_t {
+    STARTUP_PHASE_TOTAL = 0,
+    STARTUP_PHASE_REGISTER_APP_STATE_OBSERVER,
+    STARTUP_PHASE_START_ENHANCE_SERVICE,
+    STARTUP_PHASE_CREATE_EVENT_RUNNER,
+    STARTUP_PHASE_FIRST_USE_DIALOG_INIT,
+    STARTUP_PHASE_ENABLE_INPUT_ENHANCE,
+    STARTUP_PHASE_PUBLISH,
+    // runs in background after the service is published
+    STARTUP_PHASE_LOAD_FIRST_USE_RECORD,
+    STARTUP_PHASE_BUTT,
+};
+
+// log-linear buckets of microseconds, each power of two is split into SUB_BUCKET_NUM linear buckets
+class __attribute__((visibility("default"))) LatencyHistogram {
+public:
+    static constexpr uint32_t SUB_BUCKET_BITS = 3;
+    static constexpr uint32_t SUB_BUCKET_NUM = 1 << SUB_BUCKET_BITS;
+    static constexpr uint32_t BUCKET_NUM = (32 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_NUM;
+
+    static uint32_t GetBucketIndex(uint64_t value);
+    static uint64_t GetBucketUpperBound(uint32_t index);
+
+    void Record(uint64_t value);
+    void Merge(const LatencyHistogram& other);
+    void Reset();
+    uint64_t GetCount() const;
+    uint64_t GetSum() const;
+    uint64_t GetMax() const;
+    // upper bound of the bucket holding the percent-th value, never above the max
+    uint64_t GetPercentile(uint32_t percent) const;
+
+private:
+    std::array<std::atomic<uint64_t>, BUCKET_NUM> buckets_ {};
+    std::atomic<uint64_t> count_ {0};
+    std::atomic<uint64_t> sum_ {0};
+    std::atomic<uint64_t> max_ {0};
+};
+
+class __attribute__((visibility("default"))) SecCompLatencyStats {
+public:
+    static SecCompLatencyStats& GetInstance();
+    virtual ~SecCompLatencyStats() = default;
+
+    // operation measured by the calling thread, stages outside an operation are not recorded
+    static LatencyOperation GetCurrentOperation();
+    static void SetCurrentOperation(LatencyOperation op);
+
+    void Record(LatencyOperation op, LatencyStage stage, uint64_t value);
+    const LatencyHistogram& GetHistogram(LatencyOperation op, LatencyStage stage) const;
+    void Dump(std::string& dumpStr);
+    // startup phases are not reset, they only happen once in a process
+    void Reset();
+
+    void RecordStartupPhase(StartupPhase phase, uint64_t value);
+    uint64_t GetStartupPhase(StartupPhase phase) const;
+
+private:
+    SecCompLatencyStats() = default;
+
+    std::array<std::array<LatencyHistogram, LATENCY_STAGE_BUTT>, LATENCY_OP_BUTT> histograms_;
+    std::array<std::atomic<uint64_t>, STARTUP_PHASE_BUTT> startupPhases_ {};
+    DISALLOW_COPY_AND_MOVE(SecCompLatencyStats);
+};
+
+// measures one operation on the calling thread, nested operations are measured on their own
+class __attribute__((visibility("default"))) LatencyOperationScope final {
+public:
+    explicit LatencyOperationScope(LatencyOperation op);
+    ~LatencyOperationScope();
+
+private:
+    LatencyOperation op_;
+    LatencyOperation prevOp_;
+    std::chrono::steady_clock::time_point start_;
+    DISALLOW_COPY_AND_MOVE(LatencyOperationScope);
+};
+
+class __attribute__((visibility("default"))) LatencyStageTimer final {
+public:
+    explicit LatencyStageTimer(LatencyStage stage);
+    ~LatencyStageTimer();
+
+private:
+    LatencyOperation op_;
+    LatencyStage stage_;
+    std::chrono::steady_clock::time_point start_;
+    DISALLOW_COPY_AND_MOVE(LatencyStageTimer);
+};
+
+class __attribute__((visibility("default"))) StartupPhaseTimer final {
+public:
+    explicit StartupPhaseTimer(StartupPhase phase);
+    ~StartupPhaseTimer();
+    // records the phase now instead of at destruction
+    void Finish();
+
+private:
+    StartupPhase phase_;
+    bool isFinished_ = false;
+    std::chrono::steady_clock::time_point start_;
+    DISALLOW_COPY_AND_MOVE(StartupPhaseTimer);
+};
+
+// locks mutex, the time spent waiting for it is recorded as a lock wait stage of the current operation
+template<typename LockType, typename MutexType>
+LockType AcquireLock(MutexType& mutex)
+{
+    LatencyStageTimer timer(LATENCY_STAGE_LOCK_WAIT);
+    return LockType(mutex);
+}
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
+#endif  // SECURITY_COMPONENT_LATENCY_STATS_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,6 +14,8 @@
  */
 #include "sec_comp_malicious_apps.h"
 
+#include <algorithm>
+#include <chrono>
 #include "sec_comp_log.h"
 
 namespace OHOS {
@@ -23,25 +25,92 @@ namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
     LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompMaliciousApps"};
 static constexpr int32_t ROOT_UID = 0;
-static constexpr uint32_t MAX_CONTINUOUS_ENHANCE_FAIL_COUNT = 3;
+static constexpr int64_t MALICIOUS_FAIL_WINDOW_MILLISECONDS = 60 * 1000;
+static constexpr uint32_t FAIL_COUNT_BITS = 16;
+static constexpr uint32_t FAIL_COUNT_MASK = (1U << FAIL_COUNT_BITS) - 1;
+
+static int64_t GetCurrentMilliseconds()
+{
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
 }
 
-bool SecCompMaliciousApps::IsInMaliciousAppList(int32_t pid, int32_t uid)
+// failures counted in the window, the ones older than the window have decayed
+static uint32_t GetWindowFailCount(uint64_t failState, int64_t current)
 {
+    int64_t windowStart = static_cast<int64_t>(failState >> FAIL_COUNT_BITS);
+    if (current - windowStart > MALICIOUS_FAIL_WINDOW_MILLISECONDS) {
+        return 0;
+    }
+    return static_cast<uint32_t>(failState & FAIL_COUNT_MASK);
+}
+}
+
+uint64_t SecCompMaliciousApps::PackFailState(int64_t windowStart, uint32_t failCount)
+{
+    return (static_cast<uint64_t>(windowStart) << FAIL_COUNT_BITS) | std::min(failCount, FAIL_COUNT_MASK);
+}
+
+std::shared_ptr<MaliciousAppRecord> SecCompMaliciousApps::FindRecord(int32_t pid) const
+{
+    auto recordMap = std::atomic_load(&recordMap_);
+    auto iter = recordMap->find(pid);
+    if (iter == recordMap->end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+std::shared_ptr<MaliciousAppRecord> SecCompMaliciousApps::FindOrCreateRecord(int32_t pid)
+{
+    std::shared_ptr<MaliciousAppRecord> record = FindRecord(pid);
+    if (record != nullptr) {
+        return record;
+    }
     std::lock_guard<std::mutex> lock(maliciousMtx_);
-    if (uid == ROOT_UID) {
+    auto recordMap = std::atomic_load(&recordMap_);
+    auto iter = recordMap->find(pid);
+    if (iter != recordMap->end()) {
+        return iter->second;
+    }
+    record = std::make_shared<MaliciousAppRecord>();
+    auto newMap = std::make_shared<MaliciousAppRecordMap>(*recordMap);
+    newMap->emplace(pid, record);
+    std::atomic_store(&recordMap_, std::shared_ptr<const MaliciousAppRecordMap>(std::move(newMap)));
+    return record;
+}
+
+bool SecCompMaliciousApps::IsInMaliciousAppList(int32_t pid, int32_t uid)
+{
+    if ((uid == ROOT_UID) || (maliciousNum_.load(std::memory_order_acquire) == 0)) {
         return false;
     }
-    return (maliciousAppList_.find(pid) != maliciousAppList_.end());
+    std::shared_ptr<MaliciousAppRecord> record = FindRecord(pid);
+    return (record != nullptr) && record->isMalicious.load(std::memory_order_acquire);
 }
 
 void SecCompMaliciousApps::AddAppToMaliciousAppList(int32_t pid)
 {
-    std::lock_guard<std::mutex> lock(maliciousMtx_);
-    uint32_t& failCount = maliciousFailCountMap_[pid];
-    failCount++;
+    std::shared_ptr<MaliciousAppRecord> record = FindOrCreateRecord(pid);
+    int64_t current = GetCurrentMilliseconds();
+    uint64_t oldState = record->failState.load(std::memory_order_relaxed);
+    uint64_t newState;
+    uint32_t failCount;
+    do {
+        failCount = GetWindowFailCount(oldState, current);
+        // the window starts again at the first failure after the old ones decayed
+        int64_t windowStart = (failCount == 0) ? current : static_cast<int64_t>(oldState >> FAIL_COUNT_BITS);
+        failCount = std::min(failCount + 1, FAIL_COUNT_MASK);
+        newState = PackFailState(windowStart, failCount);
+    } while (!record->failState.compare_exchange_weak(oldState, newState, std::memory_order_relaxed));
+    record->totalFailCount.fetch_add(1, std::memory_order_relaxed);
+
     if (failCount > MAX_CONTINUOUS_ENHANCE_FAIL_COUNT) {
-        maliciousAppList_.insert(pid);
+        std::lock_guard<std::mutex> lock(maliciousMtx_);
+        // the record may be removed by process died meanwhile, it must not be counted then
+        if ((FindRecord(pid) == record) && !record->isMalicious.exchange(true, std::memory_order_release)) {
+            maliciousNum_.fetch_add(1, std::memory_order_release);
+        }
         SC_LOG_WARN(LABEL, "Pid %{public}d entered malicious app list, failCount=%{public}u", pid, failCount);
         return;
     }
@@ -51,20 +120,43 @@ void SecCompMaliciousApps::AddAppToMaliciousAppList(int32_t pid)
 void SecCompMaliciousApps::RemoveAppFromMaliciousAppList(int32_t pid)
 {
     std::lock_guard<std::mutex> lock(maliciousMtx_);
-    maliciousAppList_.erase(pid);
-    maliciousFailCountMap_.erase(pid);
+    auto recordMap = std::atomic_load(&recordMap_);
+    auto iter = recordMap->find(pid);
+    if (iter == recordMap->end()) {
+        return;
+    }
+    if (iter->second->isMalicious.exchange(false, std::memory_order_release)) {
+        maliciousNum_.fetch_sub(1, std::memory_order_release);
+    }
+    auto newMap = std::make_shared<MaliciousAppRecordMap>(*recordMap);
+    newMap->erase(pid);
+    std::atomic_store(&recordMap_, std::shared_ptr<const MaliciousAppRecordMap>(std::move(newMap)));
 }
 
 void SecCompMaliciousApps::ResetAppMaliciousFailCount(int32_t pid)
 {
-    std::lock_guard<std::mutex> lock(maliciousMtx_);
-    maliciousFailCountMap_.erase(pid);
+    std::shared_ptr<MaliciousAppRecord> record = FindRecord(pid);
+    if (record != nullptr) {
+        record->failState.store(0, std::memory_order_relaxed);
+    }
 }
 
 bool SecCompMaliciousApps::IsMaliciousAppListEmpty()
 {
-    std::lock_guard<std::mutex> lock(maliciousMtx_);
-    return (maliciousAppList_.size() == 0);
+    return (maliciousNum_.load(std::memory_order_acquire) == 0);
+}
+
+void SecCompMaliciousApps::Dump(std::string& dumpStr)
+{
+    auto recordMap = std::atomic_load(&recordMap_);
+    int64_t current = GetCurrentMilliseconds();
+    for (auto iter = recordMap->begin(); iter != recordMap->end(); ++iter) {
+        const std::shared_ptr<MaliciousAppRecord>& record = iter->second;
+        dumpStr.append("pid:" + std::to_string(iter->first) + ", windowFailCount:" +
+            std::to_string(GetWindowFailCount(record->failState.load(std::memory_order_relaxed), current)) +
+            ", totalFailCount:" + std::to_string(record->totalFailCount.load(std::memory_order_relaxed)) +
+            ", isMalicious:" + std::to_string(record->isMalicious.load(std::memory_order_relaxed)) + "\n");
+    }
 }
 }  // namespace SecurityComponent
 }  // namespace Security
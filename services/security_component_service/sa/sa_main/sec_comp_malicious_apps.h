@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,13 +15,26 @@
 #ifndef SECURITY_COMPONENT_MALICIOUS_APPS_H
 #define SECURITY_COMPONENT_MALICIOUS_APPS_H
 
+#include <atomic>
+#include <memory>
 #include <mutex>
-#include <set>
+#include <string>
 #include <unordered_map>
 
 namespace OHOS {
 namespace Security {
 namespace SecurityComponent {
+// enhance check failures of one process, only updated by atomic operations
+struct MaliciousAppRecord {
+    // window start in steady clock ms and failures counted in the window, packed by PackFailState
+    std::atomic<uint64_t> failState { 0 };
+    std::atomic<uint32_t> totalFailCount { 0 };
+    std::atomic<bool> isMalicious { false };
+};
+
+// published for lock-free reading, a pid is only added or removed by copying the map
+using MaliciousAppRecordMap = std::unordered_map<int32_t, std::shared_ptr<MaliciousAppRecord>>;
+
 class SecCompMaliciousApps {
 public:
     SecCompMaliciousApps() = default;
@@ -31,10 +44,20 @@ public:
     void RemoveAppFromMaliciousAppList(int32_t pid);
     void ResetAppMaliciousFailCount(int32_t pid);
     bool IsMaliciousAppListEmpty();
+    void Dump(std::string& dumpStr);
+
+    // more failures than this within one window put the process into malicious list
+    static constexpr uint32_t MAX_CONTINUOUS_ENHANCE_FAIL_COUNT = 3;
 
 private:
-    std::set<int32_t> maliciousAppList_; // pid set
-    std::unordered_map<int32_t, uint32_t> maliciousFailCountMap_; // pid -> continuous enhance fail count
+    static uint64_t PackFailState(int64_t windowStart, uint32_t failCount);
+    std::shared_ptr<MaliciousAppRecord> FindRecord(int32_t pid) const;
+    std::shared_ptr<MaliciousAppRecord> FindOrCreateRecord(int32_t pid);
+
+    std::shared_ptr<const MaliciousAppRecordMap> recordMap_ = std::make_shared<const MaliciousAppRecordMap>();
+    // number of records marked malicious, the common check is this single load
+    std::atomic<uint32_t> maliciousNum_ { 0 };
+    // serializes writers of recordMap_, readers load it without it
     std::mutex maliciousMtx_;
 };
 }  // namespace SecurityComponent
@@ -14,41 +14,69 @@
  */
 #include "sec_comp_manager.h"
 
-#include "bundle_mgr_client.h"
+#include <algorithm>
 #include "delay_exit_task.h"
-#include "display.h"
-#include "display_info.h"
-#include "display_manager.h"
+#include "display_geometry_cache.h"
 #include "first_use_dialog.h"
 #include "hisysevent.h"
 #include "isec_comp_service.h"
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
+#include "sec_comp_bundle_info_cache.h"
 #include "sec_comp_enhance_adapter.h"
 #include "sec_comp_err.h"
 #include "sec_comp_info.h"
 #include "sec_comp_info_helper.h"
+#include "sec_comp_latency_stats.h"
 #include "sec_comp_log.h"
+#include "sec_comp_update_channel.h"
 
 namespace OHOS {
 namespace Security {
 namespace SecurityComponent {
 namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompManager"};
-static constexpr int32_t SC_ID_START = 1000;
 static constexpr int32_t MAX_INT_NUM = 0x7fffffff;
 static constexpr int32_t MAX_SINGLE_PROC_COMP_SIZE = 500;
+static constexpr int32_t SLOT_INDEX_BITS = 16;
+static constexpr int32_t SLOT_INDEX_MASK = (1 << SLOT_INDEX_BITS) - 1;
+static constexpr size_t MAX_SLOT_SIZE = 1 << SLOT_INDEX_BITS;
+static constexpr int32_t MAX_SLOT_GENERATION = MAX_INT_NUM >> SLOT_INDEX_BITS;
+static constexpr int32_t INVALID_SLOT_INDEX = -1;
 static constexpr unsigned long REPORT_REMOTE_OBJECT_SIZE = 2UL;
+static constexpr int32_t WAIT_DEFERRED_INIT_MILLISECONDS = 1000;
+static const std::string DEFERRED_INIT_TASK = "SecCompDeferredInit";
 static std::mutex g_instanceMutex;
 const std::string START_DIALOG = "start dialog, onclick will be trap after dialog closed.";
 constexpr int32_t SA_ID_SECURITY_COMPONENT_SERVICE = 3506;
 const std::string CUSTOMIZE_SAVE_BUTTON = "ohos.permission.CUSTOMIZE_SAVE_BUTTON";
 const std::string READ_PASTEBOARD_PERMISSION = "ohos.permission.READ_PASTEBOARD";
+
+static int32_t CheckComponentInfoEnhance(int32_t pid, std::shared_ptr<SecCompBase>& compInfo,
+    const nlohmann::json& jsonComponent)
+{
+    LatencyStageTimer timer(LATENCY_STAGE_CHECK_INFO_ENHANCE);
+    return SecCompEnhanceAdapter::CheckComponentInfoEnhance(pid, compInfo, jsonComponent);
+}
+
+static bool IsSameComponentInfo(const std::shared_ptr<SecCompBase>& lhs, const std::shared_ptr<SecCompBase>& rhs)
+{
+    if (lhs == rhs) {
+        return true;
+    }
+    if ((lhs == nullptr) || (rhs == nullptr)) {
+        return false;
+    }
+    nlohmann::json lhsJson;
+    nlohmann::json rhsJson;
+    lhs->ToJson(lhsJson);
+    rhs->ToJson(rhsJson);
+    return lhsJson == rhsJson;
+}
 }
 
 SecCompManager::SecCompManager()
 {
-    scIdStart_ = SC_ID_START;
 }
 
 SecCompManager& SecCompManager::GetInstance()
@@ -62,86 +90,321 @@ SecCompManager& SecCompManager::GetInstance()
     }
     return *instance;
 }
-bool SecCompManager::IsScIdExist(int32_t scId)
+static inline int32_t MakeScId(int32_t index, int32_t generation)
 {
-    std::shared_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
-    for (auto it = componentMap_.begin(); it != componentMap_.end(); ++it) {
-        for (auto iter = it->second.compList.begin(); iter != it->second.compList.end(); ++iter) {
-            std::shared_ptr<SecCompEntity> sc = *iter;
-            if (sc != nullptr && scId == sc->scId_) {
-                return true;
-            }
-        }
+    return (generation << SLOT_INDEX_BITS) | index;
+}
+
+SecCompSlot* SecCompManager::GetSlot(int32_t index)
+{
+    if ((index < 0) || (static_cast<size_t>(index) >= slotCount_.load(std::memory_order_acquire))) {
+        return nullptr;
     }
-    return false;
+    return &slotChunks_[index / SLOT_CHUNK_SIZE][index % SLOT_CHUNK_SIZE];
+}
+
+SecCompSlot* SecCompManager::AppendSlot()
+{
+    size_t count = slotCount_.load(std::memory_order_relaxed);
+    if (count >= MAX_SLOT_SIZE) {
+        SC_LOG_ERROR(LABEL, "Security component slots are exhausted");
+        return nullptr;
+    }
+    if (slotChunks_[count / SLOT_CHUNK_SIZE] == nullptr) {
+        slotChunks_[count / SLOT_CHUNK_SIZE] = std::make_unique<SecCompSlot[]>(SLOT_CHUNK_SIZE);
+    }
+    slotCount_.store(count + 1, std::memory_order_release);
+    return &slotChunks_[count / SLOT_CHUNK_SIZE][count % SLOT_CHUNK_SIZE];
+}
+
+void SecCompManager::ResetSlots()
+{
+    std::lock_guard<std::mutex> lock(slotLock_);
+    slotCount_.store(0, std::memory_order_release);
+    freeSlots_.clear();
+    for (auto& chunk : slotChunks_) {
+        chunk = nullptr;
+    }
+}
+
+int32_t SecCompManager::GetSlotIndex(int32_t pid, int32_t scId)
+{
+    SecCompSlot* slot = GetSlot(scId & SLOT_INDEX_MASK);
+    if ((scId < 0) || (slot == nullptr)) {
+        return INVALID_SLOT_INDEX;
+    }
+    // pid of a slot is only changed under the owner process lock held by caller
+    if ((slot->pid.load(std::memory_order_acquire) != pid) ||
+        (slot->scId.load(std::memory_order_acquire) != scId)) {
+        return INVALID_SLOT_INDEX;
+    }
+    return scId & SLOT_INDEX_MASK;
+}
+
+void SecCompManager::ReleaseSlot(int32_t index)
+{
+    SecCompSlot* slot = GetSlot(index);
+    if (slot == nullptr) {
+        return;
+    }
+    slot->entity = nullptr;
+    slot->prev = INVALID_SLOT_INDEX;
+    slot->next = INVALID_SLOT_INDEX;
+    slot->scId.store(INVALID_SC_ID, std::memory_order_release);
+    slot->pid.store(0, std::memory_order_release);
+
+    auto lock = AcquireLock<std::lock_guard<std::mutex>>(slotLock_);
+    slot->state = SlotState::SLOT_FREE;
+    slot->generation = (slot->generation >= MAX_SLOT_GENERATION) ? 1 : (slot->generation + 1);
+    freeSlots_.emplace_back(index);
+}
+
+void SecCompManager::ReleaseProcessComponents(ProcessCompInfos& info)
+{
+    int32_t index = info.compHead;
+    while (index != INVALID_SLOT_INDEX) {
+        int32_t next = GetSlot(index)->next;
+        ReleaseSlot(index);
+        index = next;
+    }
+    info.compHead = INVALID_SLOT_INDEX;
+    info.compCount = 0;
 }
 
 int32_t SecCompManager::CreateScId()
 {
-    std::lock_guard<std::mutex> lock(scIdMtx_);
-    do {
-        if (scIdStart_ == MAX_INT_NUM) {
-            scIdStart_ = SC_ID_START;
-        } else {
-            scIdStart_++;
+    auto lock = AcquireLock<std::lock_guard<std::mutex>>(slotLock_);
+    int32_t index = INVALID_SLOT_INDEX;
+    SecCompSlot* slot = nullptr;
+    while (!freeSlots_.empty()) {
+        int32_t candidate = freeSlots_.back();
+        freeSlots_.pop_back();
+        // a free slot may have been taken by an entity carrying its own scId
+        slot = GetSlot(candidate);
+        if ((slot != nullptr) && (slot->state == SlotState::SLOT_FREE)) {
+            index = candidate;
+            break;
+        }
+    }
+    if (index == INVALID_SLOT_INDEX) {
+        slot = AppendSlot();
+        if (slot == nullptr) {
+            return INVALID_SC_ID;
+        }
+        index = static_cast<int32_t>(slotCount_.load(std::memory_order_relaxed) - 1);
+    }
+    slot->state = SlotState::SLOT_RESERVED;
+    return MakeScId(index, slot->generation);
+}
+
+void SecCompManager::ReleaseScId(int32_t scId)
+{
+    if (scId < 0) {
+        return;
+    }
+    auto lock = AcquireLock<std::lock_guard<std::mutex>>(slotLock_);
+    int32_t index = scId & SLOT_INDEX_MASK;
+    SecCompSlot* slot = GetSlot(index);
+    if ((slot == nullptr) || (slot->state != SlotState::SLOT_RESERVED) ||
+        (slot->generation != (scId >> SLOT_INDEX_BITS))) {
+        return;
+    }
+    slot->state = SlotState::SLOT_FREE;
+    slot->generation = (slot->generation >= MAX_SLOT_GENERATION) ? 1 : (slot->generation + 1);
+    freeSlots_.emplace_back(index);
+}
+
+int32_t SecCompManager::BindSlot(int32_t scId)
+{
+    int32_t index = scId & SLOT_INDEX_MASK;
+    int32_t generation = scId >> SLOT_INDEX_BITS;
+    auto lock = AcquireLock<std::lock_guard<std::mutex>>(slotLock_);
+    while (slotCount_.load(std::memory_order_relaxed) <= static_cast<size_t>(index)) {
+        if (AppendSlot() == nullptr) {
+            return INVALID_SLOT_INDEX;
+        }
+        freeSlots_.emplace_back(static_cast<int32_t>(slotCount_.load(std::memory_order_relaxed) - 1));
+    }
+    SecCompSlot* slot = GetSlot(index);
+    if ((slot->state == SlotState::SLOT_BOUND) ||
+        ((slot->state == SlotState::SLOT_RESERVED) && (slot->generation != generation))) {
+        SC_LOG_ERROR(LABEL, "scId %{public}d is already in use", scId);
+        return INVALID_SLOT_INDEX;
+    }
+    slot->state = SlotState::SLOT_BOUND;
+    slot->generation = generation;
+    return index;
+}
+
+std::shared_ptr<ProcessCompInfos> SecCompManager::GetProcessCompInfos(int32_t pid)
+{
+    auto lk = AcquireLock<std::shared_lock<ffrt::shared_mutex>>(componentInfoLock_);
+    auto iter = componentMap_.find(pid);
+    if (iter == componentMap_.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+// info.compLock must be held exclusively
+int32_t SecCompManager::BindSecurityComponentToProcess(ProcessCompInfos& info, int32_t pid,
+    const std::shared_ptr<SecCompEntity>& newEntity)
+{
+    if (info.compCount > MAX_SINGLE_PROC_COMP_SIZE) {
+        SC_LOG_ERROR(LABEL, "single proccess has too many component.");
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+    int32_t index = BindSlot(newEntity->scId_);
+    if (index == INVALID_SLOT_INDEX) {
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+
+    SecCompSlot* slot = GetSlot(index);
+    slot->entity = newEntity;
+    slot->prev = INVALID_SLOT_INDEX;
+    slot->next = info.compHead;
+    slot->scId.store(newEntity->scId_, std::memory_order_release);
+    slot->pid.store(pid, std::memory_order_release);
+    if (info.compHead != INVALID_SLOT_INDEX) {
+        GetSlot(info.compHead)->prev = index;
+    }
+    info.compHead = index;
+    info.compCount++;
+    info.isForeground = true;
+    return SC_OK;
+}
+
+int32_t SecCompManager::AddSecurityComponentToProcess(ProcessCompInfos& info, int32_t pid,
+    const std::shared_ptr<SecCompEntity>& newEntity)
+{
+    auto compLk = AcquireLock<std::unique_lock<ffrt::shared_mutex>>(info.compLock);
+    return BindSecurityComponentToProcess(info, pid, newEntity);
+}
+
+void SecCompManager::AddSecurityComponentsToProcess(ProcessCompInfos& info, int32_t pid,
+    const std::vector<std::shared_ptr<SecCompEntity>>& entities, std::vector<SecCompRegisterItem>& items)
+{
+    auto compLk = AcquireLock<std::unique_lock<ffrt::shared_mutex>>(info.compLock);
+    for (size_t i = 0; i < entities.size(); ++i) {
+        if (entities[i] != nullptr) {
+            items[i].result = BindSecurityComponentToProcess(info, pid, entities[i]);
         }
-    } while (IsScIdExist(scIdStart_));
-    return scIdStart_;
+    }
 }
 
 int32_t SecCompManager::AddSecurityComponentToList(int32_t pid,
     AccessToken::AccessTokenID tokenId, std::shared_ptr<SecCompEntity> newEntity)
 {
-    std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
-    if (isSaExit_) {
-        SC_LOG_ERROR(LABEL, "SA is exiting, retry...");
-        return SC_SERVICE_ERROR_SERVICE_NOT_EXIST;
+    if ((newEntity == nullptr) || (newEntity->scId_ < 0)) {
+        SC_LOG_ERROR(LABEL, "Secomp entity is invalid");
+        return SC_SERVICE_ERROR_VALUE_INVALID;
     }
-
-    auto iter = componentMap_.find(pid);
-    if (iter != componentMap_.end()) {
-        if (iter->second.compList.size() > MAX_SINGLE_PROC_COMP_SIZE) {
-            SC_LOG_ERROR(LABEL, "single proccess has too many component.");
-            return SC_SERVICE_ERROR_VALUE_INVALID;
+    int32_t res;
+    {
+        // SA exit checks components under the exclusive lock, so hold the shared lock while adding.
+        auto lk = AcquireLock<std::shared_lock<ffrt::shared_mutex>>(componentInfoLock_);
+        if (isSaExit_) {
+            SC_LOG_ERROR(LABEL, "SA is exiting, retry...");
+            return SC_SERVICE_ERROR_SERVICE_NOT_EXIST;
+        }
+        auto iter = componentMap_.find(pid);
+        res = (iter != componentMap_.end()) ?
+            AddSecurityComponentToProcess(*iter->second, pid, newEntity) : SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
+    }
+    if (res == SC_SERVICE_ERROR_COMPONENT_NOT_EXIST) {
+        auto lk = AcquireLock<std::unique_lock<ffrt::shared_mutex>>(componentInfoLock_);
+        if (isSaExit_) {
+            SC_LOG_ERROR(LABEL, "SA is exiting, retry...");
+            return SC_SERVICE_ERROR_SERVICE_NOT_EXIST;
+        }
+        auto& info = componentMap_[pid];
+        if (info == nullptr) {
+            info = std::make_shared<ProcessCompInfos>();
+            info->tokenId = tokenId;
         }
-        iter->second.isForeground = true;
-        iter->second.compList.emplace_back(newEntity);
+        res = AddSecurityComponentToProcess(*info, pid, newEntity);
+    }
+    if (res == SC_OK) {
         DelayExitTask::GetInstance().Stop();
-        return SC_OK;
     }
+    return res;
+}
 
-    ProcessCompInfos newProcess;
-    newProcess.isForeground = true;
-    newProcess.tokenId = tokenId;
-    newProcess.compList.emplace_back(newEntity);
-    componentMap_[pid] = newProcess;
+int32_t SecCompManager::AddSecurityComponentsToList(int32_t pid, AccessToken::AccessTokenID tokenId,
+    const std::vector<std::shared_ptr<SecCompEntity>>& entities, std::vector<SecCompRegisterItem>& items)
+{
+    if (std::none_of(entities.begin(), entities.end(), [](const auto& entity) { return entity != nullptr; })) {
+        return SC_OK;
+    }
+    bool isAdded = false;
+    {
+        std::shared_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
+        if (isSaExit_) {
+            SC_LOG_ERROR(LABEL, "SA is exiting, retry...");
+            return SC_SERVICE_ERROR_SERVICE_NOT_EXIST;
+        }
+        auto iter = componentMap_.find(pid);
+        if (iter != componentMap_.end()) {
+            AddSecurityComponentsToProcess(*iter->second, pid, entities, items);
+            isAdded = true;
+        }
+    }
+    if (!isAdded) {
+        std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
+        if (isSaExit_) {
+            SC_LOG_ERROR(LABEL, "SA is exiting, retry...");
+            return SC_SERVICE_ERROR_SERVICE_NOT_EXIST;
+        }
+        auto& info = componentMap_[pid];
+        if (info == nullptr) {
+            info = std::make_shared<ProcessCompInfos>();
+            info->tokenId = tokenId;
+        }
+        AddSecurityComponentsToProcess(*info, pid, entities, items);
+    }
     DelayExitTask::GetInstance().Stop();
     return SC_OK;
 }
 
+// info.compLock must be held exclusively
+int32_t SecCompManager::UnlinkSecurityComponent(ProcessCompInfos& info, int32_t pid, int32_t scId)
+{
+    int32_t index = info.isRemoved ? INVALID_SLOT_INDEX : GetSlotIndex(pid, scId);
+    if (index == INVALID_SLOT_INDEX) {
+        SC_LOG_ERROR(LABEL, "Can not find component");
+        return SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
+    }
+
+    SecCompSlot* slot = GetSlot(index);
+    if (slot->prev != INVALID_SLOT_INDEX) {
+        GetSlot(slot->prev)->next = slot->next;
+    } else {
+        info.compHead = slot->next;
+    }
+    if (slot->next != INVALID_SLOT_INDEX) {
+        GetSlot(slot->next)->prev = slot->prev;
+    }
+    info.compCount--;
+    ReleaseSlot(index);
+    return SC_OK;
+}
+
 int32_t SecCompManager::DeleteSecurityComponentFromList(int32_t pid, int32_t scId)
 {
-    std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
-    auto iter = componentMap_.find(pid);
-    if (iter == componentMap_.end()) {
+    std::shared_ptr<ProcessCompInfos> info = GetProcessCompInfos(pid);
+    if (info == nullptr) {
         SC_LOG_ERROR(LABEL, "Can not find registered process");
         return SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
     }
-    auto& list = iter->second.compList;
-    for (auto it = list.begin(); it != list.end(); ++it) {
-        std::shared_ptr<SecCompEntity> sc = *it;
-        if (sc == nullptr) {
-            SC_LOG_ERROR(LABEL, "Secomp entity is nullptr");
-            continue;
-        }
-        if (sc->scId_ == scId) {
-            list.erase(it);
-            DelayExitTask::GetInstance().Start();
-            return SC_OK;
+    {
+        auto compLk = AcquireLock<std::unique_lock<ffrt::shared_mutex>>(info->compLock);
+        int32_t res = UnlinkSecurityComponent(*info, pid, scId);
+        if (res != SC_OK) {
+            return res;
         }
     }
-    SC_LOG_ERROR(LABEL, "Can not find component");
-    return SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
+    DelayExitTask::GetInstance().Start();
+    return SC_OK;
 }
 
 static std::string TransformCallBackResult(enum SCErrCode error)
@@ -175,52 +438,48 @@ static std::string TransformCallBackResult(enum SCErrCode error)
 
 std::shared_ptr<SecCompEntity> SecCompManager::GetSecurityComponentFromList(int32_t pid, int32_t scId)
 {
-    auto iter = componentMap_.find(pid);
-    if (iter == componentMap_.end()) {
+    int32_t index = GetSlotIndex(pid, scId);
+    if (index == INVALID_SLOT_INDEX) {
         return nullptr;
     }
-    auto& list = iter->second.compList;
-    for (auto it = list.begin(); it != list.end(); ++it) {
-        std::shared_ptr<SecCompEntity> sc = *it;
-        if (sc == nullptr) {
-            SC_LOG_ERROR(LABEL, "Secomp entity is nullptr");
-            continue;
-        }
-        if (sc->scId_ == scId) {
-            return *it;
-        }
-    }
-    return nullptr;
+    return GetSlot(index)->entity;
 }
 
 bool SecCompManager::IsCompExist()
 {
     return std::any_of(componentMap_.begin(), componentMap_.end(), [](const auto & iter) {
-        return (iter.second.compList.size() > 0);
+        std::shared_lock<ffrt::shared_mutex> compLk(iter.second->compLock);
+        return (iter.second->compCount > 0);
     });
 }
 
 void SecCompManager::NotifyProcessForeground(int32_t pid)
 {
-    std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
-    auto iter = componentMap_.find(pid);
-    if (iter == componentMap_.end()) {
+    std::shared_ptr<ProcessCompInfos> info = GetProcessCompInfos(pid);
+    if (info == nullptr) {
+        return;
+    }
+    std::unique_lock<ffrt::shared_mutex> compLk(info->compLock);
+    if (info->isRemoved) {
         return;
     }
-    SecCompPermManager::GetInstance().CancelAppRevokingPermisions(iter->second.tokenId);
-    iter->second.isForeground = true;
+    SecCompPermManager::GetInstance().CancelAppRevokingPermisions(info->tokenId);
+    info->isForeground = true;
 }
 
 void SecCompManager::NotifyProcessBackground(int32_t pid)
 {
-    std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
-    auto iter = componentMap_.find(pid);
-    if (iter == componentMap_.end()) {
+    std::shared_ptr<ProcessCompInfos> info = GetProcessCompInfos(pid);
+    if (info == nullptr) {
+        return;
+    }
+    std::unique_lock<ffrt::shared_mutex> compLk(info->compLock);
+    if (info->isRemoved) {
         return;
     }
 
-    SecCompPermManager::GetInstance().RevokeAppPermisionsDelayed(iter->second.tokenId);
-    iter->second.isForeground = false;
+    SecCompPermManager::GetInstance().RevokeAppPermisionsDelayed(info->tokenId);
+    info->isForeground = false;
     SC_LOG_INFO(LABEL, "App pid %{public}d to background", pid);
 }
 
@@ -230,20 +489,30 @@ void SecCompManager::NotifyProcessDied(int32_t pid, bool isProcessCached)
         // notify enhance process died.
         SecCompEnhanceAdapter::NotifyProcessDied(pid);
         malicious_.RemoveAppFromMaliciousAppList(pid);
+        SecCompUpdateChannel::GetInstance().Close(pid);
     }
-    std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
-    auto iter = componentMap_.find(pid);
-    if (iter == componentMap_.end()) {
-        return;
+    AccessToken::AccessTokenID tokenId;
+    {
+        // keep the exclusive lock until slots are released, a reused pid can not bind them before.
+        std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
+        auto iter = componentMap_.find(pid);
+        if (iter == componentMap_.end()) {
+            return;
+        }
+        std::shared_ptr<ProcessCompInfos> info = iter->second;
+        componentMap_.erase(iter);
+
+        std::unique_lock<ffrt::shared_mutex> compLk(info->compLock);
+        info->isRemoved = true;
+        ReleaseProcessComponents(*info);
+        tokenId = info->tokenId;
     }
 
     FirstUseDialog::GetInstance().RemoveDialogWaitEntitys(pid);
 
     SC_LOG_INFO(LABEL, "App pid %{public}d died", pid);
-    iter->second.compList.clear();
-    SecCompPermManager::GetInstance().RevokeAppPermissions(iter->second.tokenId);
-    SecCompPermManager::GetInstance().RevokeTempSavePermission(iter->second.tokenId);
-    componentMap_.erase(pid);
+    SecCompPermManager::GetInstance().RevokeAppPermissions(tokenId);
+    SecCompPermManager::GetInstance().RevokeTempSavePermission(tokenId);
 
     DelayExitTask::GetInstance().Start();
 }
@@ -278,9 +547,11 @@ void SecCompManager::ExitWhenAppMgrDied()
 {
     std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
     for (auto iter = componentMap_.begin(); iter != componentMap_.end(); ++iter) {
-        iter->second.compList.clear();
-        SecCompPermManager::GetInstance().RevokeAppPermissions(iter->second.tokenId);
-        SecCompPermManager::GetInstance().RevokeTempSavePermission(iter->second.tokenId);
+        std::unique_lock<ffrt::shared_mutex> compLk(iter->second->compLock);
+        iter->second->isRemoved = true;
+        ReleaseProcessComponents(*iter->second);
+        SecCompPermManager::GetInstance().RevokeAppPermissions(iter->second->tokenId);
+        SecCompPermManager::GetInstance().RevokeTempSavePermission(iter->second->tokenId);
     }
     componentMap_.clear();
 
@@ -305,9 +576,7 @@ void SecCompManager::SendCheckInfoEnhanceSysEvent(int32_t scId,
     SecCompType type, const std::string& scene, int32_t res)
 {
     int32_t uid = IPCSkeleton::GetCallingUid();
-    OHOS::AppExecFwk::BundleMgrClient bmsClient;
-    std::string bundleName = "";
-    bmsClient.GetNameForUid(uid, bundleName);
+    std::string bundleName = SecCompBundleInfoCache::GetInstance().GetBundleName(uid);
     if (res == SC_ENHANCE_ERROR_CHALLENGE_CHECK_FAIL) {
         HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "CHALLENGE_CHECK_FAILED",
             HiviewDFX::HiSysEvent::EventType::SECURITY, "CALLER_UID", uid, "CALLER_BUNDLE_NAME", bundleName,
@@ -331,69 +600,138 @@ int32_t SecCompManager::AddSecurityComponentProcess(const SecCompCallerInfo& cal
             return SC_SERVICE_ERROR_SERVICE_NOT_EXIST;
         }
 
-        auto iter = componentMap_.find(caller.pid);
-        if (iter == componentMap_.end()) {
-            ProcessCompInfos newProcess;
-            newProcess.isForeground = true;
-            newProcess.tokenId = caller.tokenId;
-            componentMap_[caller.pid] = newProcess;
+        auto& info = componentMap_[caller.pid];
+        if (info == nullptr) {
+            info = std::make_shared<ProcessCompInfos>();
+            info->isForeground = true;
+            info->tokenId = caller.tokenId;
         }
     }
     SecCompEnhanceAdapter::AddSecurityComponentProcess(caller.pid);
     return SC_OK;
 }
 
-int32_t SecCompManager::RegisterSecurityComponent(SecCompType type,
-    const nlohmann::json& jsonComponent, const SecCompCallerInfo& caller, int32_t& scId)
+std::shared_ptr<SecCompEntity> SecCompManager::CreateSecCompEntity(SecCompType type,
+    const SecCompInfoPayload& info, const SecCompCallerInfo& caller, int32_t& res)
 {
-    SC_LOG_DEBUG(LABEL, "PID: %{public}d, register security component", caller.pid);
-    if (malicious_.IsInMaliciousAppList(caller.pid, caller.uid)) {
-        SC_LOG_ERROR(LABEL, "app is in MaliciousAppList, never allow it");
-        return SC_ENHANCE_ERROR_IN_MALICIOUS_LIST;
-    }
-
     std::string message;
-    SecCompBase* componentPtr = SecCompInfoHelper::ParseComponent(type, jsonComponent, caller.userId, message);
+    SecCompBase* componentPtr = SecCompInfoHelper::ParseComponent(type, info, caller.userId, message);
     std::shared_ptr<SecCompBase> component(componentPtr);
     if (component == nullptr) {
         SC_LOG_ERROR(LABEL, "Parse component info invalid");
         int32_t uid = IPCSkeleton::GetCallingUid();
-        OHOS::AppExecFwk::BundleMgrClient bmsClient;
-        std::string bundleName = "";
-        bmsClient.GetNameForUid(uid, bundleName);
+        std::string bundleName = SecCompBundleInfoCache::GetInstance().GetBundleName(uid);
         HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "COMPONENT_INFO_CHECK_FAILED",
             HiviewDFX::HiSysEvent::EventType::SECURITY, "CALLER_UID", uid, "CALLER_BUNDLE_NAME", bundleName,
-            "CALLER_PID", IPCSkeleton::GetCallingPid(), "SC_ID", scId, "CALL_SCENE", "REGITSTER", "SC_TYPE", type);
-        return SC_SERVICE_ERROR_COMPONENT_INFO_INVALID;
+            "CALLER_PID", IPCSkeleton::GetCallingPid(), "SC_ID", INVALID_SC_ID, "CALL_SCENE", "REGITSTER",
+            "SC_TYPE", type);
+        res = SC_SERVICE_ERROR_COMPONENT_INFO_INVALID;
+        return nullptr;
     }
 
-    int32_t enhanceRes =
-        SecCompEnhanceAdapter::CheckComponentInfoEnhance(caller.pid, component, jsonComponent);
+    int32_t enhanceRes = CheckComponentInfoEnhance(caller.pid, component, info.json);
     if (enhanceRes != SC_OK) {
         SendCheckInfoEnhanceSysEvent(INVALID_SC_ID, type, "REGISTER", enhanceRes);
         SC_LOG_ERROR(LABEL, "enhance check failed");
         malicious_.AddAppToMaliciousAppList(caller.pid);
-        return enhanceRes;
+        res = enhanceRes;
+        return nullptr;
     }
     malicious_.ResetAppMaliciousFailCount(caller.pid);
 
     int32_t registerId = CreateScId();
+    if (registerId == INVALID_SC_ID) {
+        SC_LOG_ERROR(LABEL, "Create scId failed");
+        res = SC_SERVICE_ERROR_VALUE_INVALID;
+        return nullptr;
+    }
     SecCompOwnerInfo owner = { caller.tokenId, caller.pid, caller.uid, caller.userId };
     std::shared_ptr<SecCompEntity> entity = std::make_shared<SecCompEntity>(component, registerId, owner);
     bool isCustomAuthorized = SecCompManager::GetInstance().HasCustomPermissionForSecComp();
     entity->SetCustomAuthorizationStatus(isCustomAuthorized);
+    res = SC_OK;
+    return entity;
+}
+
+int32_t SecCompManager::RegisterSecurityComponent(SecCompType type,
+    const SecCompInfoPayload& info, const SecCompCallerInfo& caller, int32_t& scId)
+{
+    SC_LOG_DEBUG(LABEL, "PID: %{public}d, register security component", caller.pid);
+    if (malicious_.IsInMaliciousAppList(caller.pid, caller.uid)) {
+        SC_LOG_ERROR(LABEL, "app is in MaliciousAppList, never allow it");
+        return SC_ENHANCE_ERROR_IN_MALICIOUS_LIST;
+    }
+
+    int32_t res = SC_OK;
+    std::shared_ptr<SecCompEntity> entity = CreateSecCompEntity(type, info, caller, res);
+    if (entity == nullptr) {
+        return res;
+    }
     int32_t ret = AddSecurityComponentToList(caller.pid, caller.tokenId, entity);
     if (ret == SC_OK) {
-        scId = registerId;
+        scId = entity->scId_;
     } else {
         SC_LOG_ERROR(LABEL, "Register security component failed");
+        ReleaseScId(entity->scId_);
         scId = INVALID_SC_ID;
     }
     return ret;
 }
 
-int32_t SecCompManager::UpdateSecurityComponent(int32_t scId, const nlohmann::json& jsonComponent,
-    const SecCompCallerInfo& caller)
+int32_t SecCompManager::RegisterSecurityComponents(std::vector<SecCompRegisterItem>& items,
+    const std::vector<SecCompInfoPayload>& infos, const SecCompCallerInfo& caller)
+{
+    SC_LOG_DEBUG(LABEL, "PID: %{public}d, register %{public}zu security components", caller.pid, items.size());
+    if (items.size() != infos.size()) {
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+
+    bool isMalicious = malicious_.IsInMaliciousAppList(caller.pid, caller.uid);
+    if (isMalicious) {
+        SC_LOG_ERROR(LABEL, "app is in MaliciousAppList, never allow it");
+    }
+    // components are checked one by one on the binder thread, the enhance check and its sys events need the
+    // calling identity; all of them are added with one registry lock
+    std::vector<std::shared_ptr<SecCompEntity>> entities(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (items[i].result != SC_OK) {
+            continue;
+        }
+        if (isMalicious) {
+            items[i].result = SC_ENHANCE_ERROR_IN_MALICIOUS_LIST;
+            continue;
+        }
+        entities[i] = CreateSecCompEntity(items[i].type, infos[i], caller, items[i].result);
+    }
+    int32_t res = AddSecurityComponentsToList(caller.pid, caller.tokenId, entities, items);
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (entities[i] == nullptr) {
+            items[i].scId = INVALID_SC_ID;
+            continue;
+        }
+        if (res != SC_OK) {
+            items[i].result = res;
+        }
+        items[i].scId = (items[i].result == SC_OK) ? entities[i]->scId_ : INVALID_SC_ID;
+        if (items[i].result != SC_OK) {
+            ReleaseScId(entities[i]->scId_);
+        }
+    }
+    return SC_OK;
+}
+
+// updates from the update channel run out of the caller's binder call, the caller is passed in
+void SecCompManager::SendUpdateInfoInvalidSysEvent(int32_t scId, SecCompType type, const SecCompCallerInfo& caller)
+{
+    std::string bundleName = SecCompBundleInfoCache::GetInstance().GetBundleName(caller.uid);
+    HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "COMPONENT_INFO_CHECK_FAILED",
+        HiviewDFX::HiSysEvent::EventType::SECURITY, "CALLER_UID", caller.uid, "CALLER_BUNDLE_NAME", bundleName,
+        "CALLER_PID", caller.pid, "SC_ID", scId, "CALL_SCENE", "UPDATE",
+        "SC_TYPE", type);
+}
+
+int32_t SecCompManager::UpdateSecurityComponent(int32_t scId, const SecCompInfoPayload& info,
+    const SecCompCallerInfo& caller, uint32_t& version)
 {
     SC_LOG_DEBUG(LABEL, "PID: %{public}d, update security component", caller.pid);
     if (malicious_.IsInMaliciousAppList(caller.pid, caller.uid)) {
@@ -401,30 +739,23 @@ int32_t SecCompManager::UpdateSecurityComponent(int32_t scId, const nlohmann::js
         return SC_ENHANCE_ERROR_IN_MALICIOUS_LIST;
     }
 
-    std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
-    std::shared_ptr<SecCompEntity> sc = GetSecurityComponentFromList(caller.pid, scId);
+    std::shared_ptr<ProcessCompInfos> procInfo = GetProcessCompInfos(caller.pid);
+    std::shared_ptr<SecCompEntity> sc =
+        (procInfo != nullptr) ? SnapshotSecurityComponent(*procInfo, caller.pid, scId) : nullptr;
     if (sc == nullptr) {
         SC_LOG_ERROR(LABEL, "Can not find target component");
         return SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
     }
     std::string message;
-    SecCompBase* report = SecCompInfoHelper::ParseComponent(sc->GetType(), jsonComponent, sc->userId_, message);
+    SecCompBase* report = SecCompInfoHelper::ParseComponent(sc->GetType(), info, sc->userId_, message);
     std::shared_ptr<SecCompBase> reportComponentInfo(report);
     if (reportComponentInfo == nullptr) {
         SC_LOG_ERROR(LABEL, "Update component info invalid");
-        int32_t uid = IPCSkeleton::GetCallingUid();
-        OHOS::AppExecFwk::BundleMgrClient bmsClient;
-        std::string bundleName = "";
-        bmsClient.GetNameForUid(uid, bundleName);
-        HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "COMPONENT_INFO_CHECK_FAILED",
-            HiviewDFX::HiSysEvent::EventType::SECURITY, "CALLER_UID", uid, "CALLER_BUNDLE_NAME", bundleName,
-            "CALLER_PID", IPCSkeleton::GetCallingPid(), "SC_ID", scId, "CALL_SCENE", "UPDATE",
-            "SC_TYPE", sc->GetType());
+        SendUpdateInfoInvalidSysEvent(scId, sc->GetType(), caller);
         return SC_SERVICE_ERROR_COMPONENT_INFO_INVALID;
     }
 
-    int32_t enhanceRes =
-        SecCompEnhanceAdapter::CheckComponentInfoEnhance(caller.pid, reportComponentInfo, jsonComponent);
+    int32_t enhanceRes = CheckComponentInfoEnhance(caller.pid, reportComponentInfo, info.json);
     if (enhanceRes != SC_OK) {
         SendCheckInfoEnhanceSysEvent(scId, sc->GetType(), "UPDATE", enhanceRes);
         SC_LOG_ERROR(LABEL, "enhance check failed");
@@ -433,8 +764,57 @@ int32_t SecCompManager::UpdateSecurityComponent(int32_t scId, const nlohmann::js
     }
 
     malicious_.ResetAppMaliciousFailCount(caller.pid);
+    std::shared_ptr<SecCompBase> baseInfo = sc->componentInfo_;
     sc->componentInfo_ = reportComponentInfo;
-    return SC_OK;
+    int32_t res = CommitSecurityComponent(*procInfo, caller.pid, sc, baseInfo, false);
+    if (res == SC_OK) {
+        version = sc->version_;
+    }
+    return res;
+}
+
+int32_t SecCompManager::UpdateSecurityComponentDelta(int32_t scId, const nlohmann::json& jsonDelta,
+    const SecCompCallerInfo& caller, uint32_t& version)
+{
+    if (malicious_.IsInMaliciousAppList(caller.pid, caller.uid)) {
+        SC_LOG_ERROR(LABEL, "app is in MaliciousAppList, never allow it");
+        return SC_ENHANCE_ERROR_IN_MALICIOUS_LIST;
+    }
+
+    std::shared_ptr<ProcessCompInfos> procInfo = GetProcessCompInfos(caller.pid);
+    std::shared_ptr<SecCompEntity> sc =
+        (procInfo != nullptr) ? SnapshotSecurityComponent(*procInfo, caller.pid, scId) : nullptr;
+    if (sc == nullptr) {
+        SC_LOG_ERROR(LABEL, "Can not find target component");
+        return SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
+    }
+    auto baseVersion = jsonDelta.find(JsonTagConstants::JSON_BASE_VERSION_TAG);
+    if ((baseVersion == jsonDelta.end()) || !baseVersion->is_number_unsigned()) {
+        SC_LOG_ERROR(LABEL, "Update delta base version invalid");
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+    // client falls back to a full update when its base is stale
+    if (baseVersion->get<uint32_t>() != sc->version_) {
+        SC_LOG_INFO(LABEL, "Update delta base version %{public}u is stale", baseVersion->get<uint32_t>());
+        return SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL;
+    }
+
+    std::string message;
+    std::shared_ptr<SecCompBase> patchedInfo(
+        SecCompInfoHelper::PatchComponent(sc->componentInfo_.get(), jsonDelta, message));
+    if (patchedInfo == nullptr) {
+        SC_LOG_ERROR(LABEL, "Update delta component info invalid");
+        SendUpdateInfoInvalidSysEvent(scId, sc->GetType(), caller);
+        return SC_SERVICE_ERROR_COMPONENT_INFO_INVALID;
+    }
+
+    std::shared_ptr<SecCompBase> baseInfo = sc->componentInfo_;
+    sc->componentInfo_ = patchedInfo;
+    int32_t res = CommitSecurityComponent(*procInfo, caller.pid, sc, baseInfo, true);
+    if (res == SC_OK) {
+        version = sc->version_;
+    }
+    return res;
 }
 
 int32_t SecCompManager::UnregisterSecurityComponent(int32_t scId, const SecCompCallerInfo& caller)
@@ -444,19 +824,52 @@ int32_t SecCompManager::UnregisterSecurityComponent(int32_t scId, const SecCompC
         SC_LOG_ERROR(LABEL, "ScId is invalid");
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
-    return DeleteSecurityComponentFromList(caller.pid, scId);
+    int32_t res = DeleteSecurityComponentFromList(caller.pid, scId);
+    if (res == SC_OK) {
+        SecCompUpdateChannel::GetInstance().RemoveComponent(caller.pid, scId);
+    }
+    return res;
+}
+
+void SecCompManager::UnregisterSecurityComponents(const std::vector<int32_t>& scIds,
+    const SecCompCallerInfo& caller, std::vector<int32_t>& results)
+{
+    SC_LOG_DEBUG(LABEL, "PID: %{public}d, unregister %{public}zu security components", caller.pid, scIds.size());
+    results.assign(scIds.size(), SC_SERVICE_ERROR_COMPONENT_NOT_EXIST);
+    std::shared_ptr<ProcessCompInfos> info = GetProcessCompInfos(caller.pid);
+    if (info == nullptr) {
+        SC_LOG_ERROR(LABEL, "Can not find registered process");
+        return;
+    }
+    bool isDeleted = false;
+    {
+        std::unique_lock<ffrt::shared_mutex> compLk(info->compLock);
+        for (size_t i = 0; i < scIds.size(); ++i) {
+            results[i] = (scIds[i] < 0) ? SC_SERVICE_ERROR_VALUE_INVALID :
+                UnlinkSecurityComponent(*info, caller.pid, scIds[i]);
+            isDeleted = isDeleted || (results[i] == SC_OK);
+        }
+    }
+    if (!isDeleted) {
+        return;
+    }
+    // out of compLock, the update channel applies records under its own lock and then takes compLock
+    for (size_t i = 0; i < scIds.size(); ++i) {
+        if (results[i] == SC_OK) {
+            SecCompUpdateChannel::GetInstance().RemoveComponent(caller.pid, scIds[i]);
+        }
+    }
+    DelayExitTask::GetInstance().Start();
 }
 
 int32_t SecCompManager::CheckClickSecurityComponentInfo(std::shared_ptr<SecCompEntity> sc, int32_t scId,
-    const nlohmann::json& jsonComponent, const SecCompCallerInfo& caller, std::string& message)
+    const SecCompInfoPayload& compInfo, const SecCompCallerInfo& caller, std::string& message)
 {
     SC_LOG_DEBUG(LABEL, "PID: %{public}d, Check security component", caller.pid);
-    SecCompBase* report = SecCompInfoHelper::ParseComponent(sc->GetType(), jsonComponent, sc->userId_, message, true);
+    SecCompBase* report = SecCompInfoHelper::ParseComponent(sc->GetType(), compInfo, sc->userId_, message, true);
     std::shared_ptr<SecCompBase> reportComponentInfo(report);
     int32_t uid = IPCSkeleton::GetCallingUid();
-    OHOS::AppExecFwk::BundleMgrClient bmsClient;
-    std::string bundleName = "";
-    bmsClient.GetNameForUid(uid, bundleName);
+    std::string bundleName = SecCompBundleInfoCache::GetInstance().GetBundleName(uid);
 
     ComponentCheckParams checkParams;
     checkParams.sc = sc;
@@ -475,7 +888,7 @@ int32_t SecCompManager::CheckClickSecurityComponentInfo(std::shared_ptr<SecCompE
     if (report && (report->isClipped_ || report->hasNonCompatibleChange_)) {
         HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "CLIP_CHECK_FAILED",
             HiviewDFX::HiSysEvent::EventType::SECURITY,
-            "CALLER_BUNDLE_NAME", bundleName, "COMPONENT_INFO", jsonComponent.dump().c_str());
+            "CALLER_BUNDLE_NAME", bundleName, "COMPONENT_INFO", report->ToJsonStr().c_str());
     }
 
     res = CheckRectInfo(checkParams);
@@ -483,8 +896,7 @@ int32_t SecCompManager::CheckClickSecurityComponentInfo(std::shared_ptr<SecCompE
         return res;
     }
 
-    int32_t enhanceRes =
-        SecCompEnhanceAdapter::CheckComponentInfoEnhance(caller.pid, reportComponentInfo, jsonComponent);
+    int32_t enhanceRes = CheckComponentInfoEnhance(caller.pid, reportComponentInfo, compInfo.json);
     if (enhanceRes != SC_OK) {
         SendCheckInfoEnhanceSysEvent(scId, sc->GetType(), "CLICK", enhanceRes);
         SC_LOG_ERROR(LABEL, "enhance check failed");
@@ -515,13 +927,12 @@ int32_t SecCompManager::CheckComponentInfoValid(const ComponentCheckParams& para
 
 int32_t SecCompManager::CheckRectInfo(const ComponentCheckParams& params)
 {
-    GetFoldOffsetY(params.report->crossAxisState_);
-
+    LatencyStageTimer timer(LATENCY_STAGE_CHECK_RECT_INFO);
     SecCompInfoHelper::ScreenInfo screenInfo = {
         params.rawReport->displayId_,
         params.rawReport->crossAxisState_,
         params.rawReport->isWearableDevice_,
-        superFoldOffsetY_,
+        GetFoldOffsetY(params.report->crossAxisState_),
         params.report->isCompatScaleMode_};
     if ((!SecCompInfoHelper::CheckRectValid(params.report->rect_, params.report->windowRect_,
         screenInfo, *params.message, params.report->scale_))) {
@@ -540,12 +951,7 @@ int32_t SecCompManager::CheckRectInfo(const ComponentCheckParams& params)
 
 bool SecCompManager::AllowToBypassArkuiCheck(const SecCompCallerInfo& caller)
 {
-    std::string bundleName = "";
-    OHOS::AppExecFwk::BundleMgrClient bmsClient;
-    int32_t ret = bmsClient.GetNameForUid(caller.uid, bundleName);
-    if (ret != SC_OK) {
-        SC_LOG_ERROR(LABEL, "Failed to get bundle name, uid=%{public}d, ret=%{public}d", caller.uid, ret);
-    }
+    std::string bundleName = SecCompBundleInfoCache::GetInstance().GetBundleName(caller.uid);
     if (SecCompEnhanceAdapter::IsBypassPermitted(bundleName)) {
         return true;
     }
@@ -566,35 +972,18 @@ static void ReportEvent(std::string eventName, HiviewDFX::HiSysEvent::EventType
     SecCompType scType)
 {
     int32_t uid = IPCSkeleton::GetCallingUid();
-    OHOS::AppExecFwk::BundleMgrClient bmsClient;
-    std::string bundleName = "";
-    bmsClient.GetNameForUid(uid, bundleName);
+    std::string bundleName = SecCompBundleInfoCache::GetInstance().GetBundleName(uid);
     HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, eventName,
         eventType, "CALLER_UID", uid, "CALLER_BUNDLE_NAME", bundleName,
         "CALLER_PID", IPCSkeleton::GetCallingPid(), "SC_ID", scId, "SC_TYPE", scType);
 }
 
-void SecCompManager::GetFoldOffsetY(const CrossAxisState crossAxisState)
+int32_t SecCompManager::GetFoldOffsetY(const CrossAxisState crossAxisState)
 {
     if (crossAxisState == CrossAxisState::STATE_INVALID) {
-        return;
-    }
-    if (superFoldOffsetY_ != 0) {
-        return;
-    }
-    auto foldCreaseRegion = OHOS::Rosen::DisplayManager::GetInstance().GetCurrentFoldCreaseRegion();
-    if (foldCreaseRegion == nullptr) {
-        SC_LOG_ERROR(LABEL, "foldCreaseRegion is nullptr");
-        return;
+        return 0;
     }
-    const auto& creaseRects = foldCreaseRegion->GetCreaseRects();
-    if (creaseRects.empty()) {
-        SC_LOG_ERROR(LABEL, "creaseRects is empty");
-        return;
-    }
-    const auto& rect = creaseRects.front();
-    superFoldOffsetY_ = rect.height_ + rect.posY_;
-    SC_LOG_INFO(LABEL, "height: %{public}d, posY: %{public}d", rect.height_, rect.posY_);
+    return DisplayGeometryCache::GetInstance().GetFoldOffsetY();
 }
 
 int32_t SecCompManager::CheckClickEventParams(const SecCompCallerInfo& caller,
@@ -617,7 +1006,8 @@ int32_t SecCompManager::StartDialog(const SecCompInfo& info, std::shared_ptr<Sec
     int32_t res = SC_SERVICE_ERROR_VALUE_INVALID;
 #ifndef DIALOG_TDD_MACRO
     const FirstUseDialog::DisplayInfo displayInfo = {sc->componentInfo_->displayId_,
-        sc->componentInfo_->crossAxisState_, sc->componentInfo_->windowId_, superFoldOffsetY_};
+        sc->componentInfo_->crossAxisState_, sc->componentInfo_->windowId_,
+        GetFoldOffsetY(sc->componentInfo_->crossAxisState_)};
 
     res = FirstUseDialog::GetInstance().NotifyFirstUseDialog(sc, remote[0], remote[1], displayInfo);
     if (res == SC_SERVICE_ERROR_WAIT_FOR_DIALOG_CLOSE) {
@@ -641,35 +1031,72 @@ int32_t SecCompManager::StartDialog(const SecCompInfo& info, std::shared_ptr<Sec
     return res;
 }
 
-int32_t SecCompManager::ReportSecurityComponentClickEvent(SecCompInfo& info, const nlohmann::json& compJson,
-    const SecCompCallerInfo& caller, const std::vector<sptr<IRemoteObject>>& remote, std::string& message)
+std::shared_ptr<SecCompEntity> SecCompManager::SnapshotSecurityComponent(ProcessCompInfos& procInfo,
+    int32_t pid, int32_t scId)
 {
-    int32_t res = CheckClickEventParams(caller, remote);
-    if (res != SC_OK) {
-        return res;
+    auto compLk = AcquireLock<std::shared_lock<ffrt::shared_mutex>>(procInfo.compLock);
+    std::shared_ptr<SecCompEntity> sc = procInfo.isRemoved ? nullptr : GetSecurityComponentFromList(pid, scId);
+    if (sc == nullptr) {
+        return nullptr;
     }
-    std::unique_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
-    std::shared_ptr<SecCompEntity> sc = GetSecurityComponentFromList(caller.pid, info.scId);
+    return std::make_shared<SecCompEntity>(*sc);
+}
+
+int32_t SecCompManager::CommitSecurityComponent(ProcessCompInfos& procInfo, int32_t pid,
+    const std::shared_ptr<SecCompEntity>& staged, const std::shared_ptr<SecCompBase>& baseInfo, bool isVersionCheck)
+{
+    // compared with the info the snapshot was taken with out of compLock, only the identity is checked under it
+    bool isInfoChanged = !IsSameComponentInfo(baseInfo, staged->componentInfo_);
+    auto compLk = AcquireLock<std::unique_lock<ffrt::shared_mutex>>(procInfo.compLock);
+    std::shared_ptr<SecCompEntity> sc =
+        procInfo.isRemoved ? nullptr : GetSecurityComponentFromList(pid, staged->scId_);
     if (sc == nullptr) {
-        SC_LOG_ERROR(LABEL, "Can not find target component");
+        SC_LOG_ERROR(LABEL, "Security component %{public}d has been unregistered", staged->scId_);
         return SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
     }
-    if (IsPasteboardPermissionGranted(caller, sc)) {
-        SC_LOG_INFO(LABEL, "Caller already has %{public}s, skip paste component click check and grant.",
-            READ_PASTEBOARD_PERMISSION.c_str());
-        return SC_OK;
+    if (isVersionCheck && (sc->version_ != staged->version_)) {
+        SC_LOG_WARN(LABEL, "Security component %{public}d changed during check", staged->scId_);
+        return SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL;
     }
+    // a click mostly reports the info of the last update, keep the version so update deltas stay valid
+    if (isInfoChanged || (sc->componentInfo_ != baseInfo)) {
+        sc->componentInfo_ = staged->componentInfo_;
+        sc->version_++;
+    }
+    sc->bypassSecurityCheck_ = sc->bypassSecurityCheck_ || staged->bypassSecurityCheck_;
+    staged->version_ = sc->version_;
+    return SC_OK;
+}
+
+void SecCompManager::CommitGrantState(ProcessCompInfos& procInfo, int32_t pid,
+    const std::shared_ptr<SecCompEntity>& staged)
+{
+    if (!staged->IsGrant()) {
+        return;
+    }
+    auto compLk = AcquireLock<std::unique_lock<ffrt::shared_mutex>>(procInfo.compLock);
+    std::shared_ptr<SecCompEntity> sc =
+        procInfo.isRemoved ? nullptr : GetSecurityComponentFromList(pid, staged->scId_);
+    if (sc != nullptr) {
+        sc->SetGrant(true);
+    }
+}
+
+int32_t SecCompManager::VerifyClickEvent(SecCompInfo& info, std::shared_ptr<SecCompEntity>& sc,
+    const SecCompInfoPayload& compInfo, const SecCompCallerInfo& caller, std::string& message)
+{
     if (!message.empty()) {
         if (!sc->AllowToBypassSecurityCheck(message) && !AllowToBypassArkuiCheck(caller)) {
             return SC_SERVICE_ERROR_CLICK_EVENT_INVALID;
         }
     }
-    res = CheckClickSecurityComponentInfo(sc, info.scId, compJson, caller, message);
+    int32_t res = CheckClickSecurityComponentInfo(sc, info.scId, compInfo, caller, message);
     if (res != SC_OK) {
         return res;
     }
 
-    res = sc->CheckClickInfo(info.clickInfo, superFoldOffsetY_, sc->componentInfo_->crossAxisState_, message);
+    CrossAxisState crossAxisState = sc->componentInfo_->crossAxisState_;
+    res = sc->CheckClickInfo(info.clickInfo, GetFoldOffsetY(crossAxisState), crossAxisState, message);
     if (res != SC_OK) {
         ReportEvent("CLICK_INFO_CHECK_FAILED", HiviewDFX::HiSysEvent::EventType::SECURITY,
             info.scId, sc->GetType());
@@ -681,23 +1108,77 @@ int32_t SecCompManager::ReportSecurityComponentClickEvent(SecCompInfo& info, con
     }
 
     malicious_.ResetAppMaliciousFailCount(caller.pid);
-    return StartDialog(info, sc, remote);
+    return SC_OK;
+}
+
+int32_t SecCompManager::ReportSecurityComponentClickEvent(SecCompInfo& info, const SecCompInfoPayload& compInfo,
+    const SecCompCallerInfo& caller, const std::vector<sptr<IRemoteObject>>& remote, std::string& message)
+{
+    int32_t res = CheckClickEventParams(caller, remote);
+    if (res != SC_OK) {
+        return res;
+    }
+    std::shared_ptr<ProcessCompInfos> procInfo = GetProcessCompInfos(caller.pid);
+    if (procInfo == nullptr) {
+        SC_LOG_ERROR(LABEL, "Can not find target component");
+        return SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
+    }
+
+    // click extra info is signed by input enhance, which is enabled after the service is published
+    if (!WaitForDeferredInit()) {
+        return SC_SERVICE_ERROR_SERVICE_NOT_EXIST;
+    }
+
+    // verify a snapshot without holding any lock. the checks verify the reported info and only read fields
+    // of the snapshot an update can not change, so the click is checked once and committed after any update
+    // made meanwhile, as if it came second. the extra info is consumed by its check and never checked twice.
+    std::shared_ptr<SecCompEntity> sc = SnapshotSecurityComponent(*procInfo, caller.pid, info.scId);
+    if (sc == nullptr) {
+        SC_LOG_ERROR(LABEL, "Can not find target component");
+        return SC_SERVICE_ERROR_COMPONENT_NOT_EXIST;
+    }
+    std::shared_ptr<SecCompBase> baseInfo = sc->componentInfo_;
+    if (IsPasteboardPermissionGranted(caller, sc)) {
+        SC_LOG_INFO(LABEL, "Caller already has %{public}s, skip paste component click check and grant.",
+            READ_PASTEBOARD_PERMISSION.c_str());
+        return SC_OK;
+    }
+    res = VerifyClickEvent(info, sc, compInfo, caller, message);
+    if (res != SC_OK) {
+        return res;
+    }
+    res = CommitSecurityComponent(*procInfo, caller.pid, sc, baseInfo, false);
+    if (res != SC_OK) {
+        return res;
+    }
+    res = StartDialog(info, sc, remote);
+    CommitGrantState(*procInfo, caller.pid, sc);
+    return res;
+}
+
+void SecCompManager::CommitDialogGrantState(const std::shared_ptr<SecCompEntity>& staged)
+{
+    std::shared_ptr<ProcessCompInfos> procInfo = GetProcessCompInfos(staged->pid_);
+    if (procInfo != nullptr) {
+        CommitGrantState(*procInfo, staged->pid_, staged);
+    }
 }
 
 void SecCompManager::DumpSecComp(std::string& dumpStr)
 {
     std::shared_lock<ffrt::shared_mutex> lk(this->componentInfoLock_);
     for (auto iter = componentMap_.begin(); iter != componentMap_.end(); ++iter) {
-        AccessToken::AccessTokenID tokenId = iter->second.tokenId;
+        std::shared_lock<ffrt::shared_mutex> compLk(iter->second->compLock);
+        AccessToken::AccessTokenID tokenId = iter->second->tokenId;
         bool locationPerm = SecCompPermManager::GetInstance().VerifyPermission(tokenId, LOCATION_COMPONENT);
         bool pastePerm = SecCompPermManager::GetInstance().VerifyPermission(tokenId, PASTE_COMPONENT);
         bool savePerm = SecCompPermManager::GetInstance().VerifyPermission(tokenId, SAVE_COMPONENT);
         dumpStr.append("pid:" + std::to_string(iter->first) + ", tokenId:" + std::to_string(pastePerm) +
             ", locationPerm:" + std::to_string(locationPerm) + ", pastePerm:" + std::to_string(pastePerm) +
             ", savePerm:" + std::to_string(savePerm) + " \n");
-        for (auto compIter = iter->second.compList.begin(); compIter != iter->second.compList.end(); ++compIter) {
+        for (int32_t index = iter->second->compHead; index != INVALID_SLOT_INDEX; index = GetSlot(index)->next) {
             nlohmann::json json;
-            std::shared_ptr<SecCompEntity> sc = *compIter;
+            const std::shared_ptr<SecCompEntity>& sc = GetSlot(index)->entity;
             if (sc == nullptr || sc->componentInfo_ == nullptr) {
                 continue;
             }
@@ -707,16 +1188,27 @@ void SecCompManager::DumpSecComp(std::string& dumpStr)
                 ", isGrant:" + std::to_string(sc->IsGrant()) + ", " + json.dump() + "\n");
         }
     }
+    lk.unlock();
+    dumpStr.append("enhance check failures:\n");
+    malicious_.Dump(dumpStr);
 }
 
 bool SecCompManager::Initialize()
 {
     SC_LOG_DEBUG(LABEL, "Initialize!!");
-    SecCompEnhanceAdapter::StartEnhanceService();
+    // enhance service does not depend on the runner, start it while the runner and handlers are set up
+    ffrt::task_handle enhanceTask = ffrt::submit_h([]() {
+        StartupPhaseTimer timer(STARTUP_PHASE_START_ENHANCE_SERVICE);
+        SecCompEnhanceAdapter::StartEnhanceService();
+    }, {}, {}, ffrt::task_attr().name("SecCompStartEnhance"));
 
-    secRunner_ = AppExecFwk::EventRunner::Create(true, AppExecFwk::ThreadMode::FFRT);
+    {
+        StartupPhaseTimer timer(STARTUP_PHASE_CREATE_EVENT_RUNNER);
+        secRunner_ = AppExecFwk::EventRunner::Create(true, AppExecFwk::ThreadMode::FFRT);
+    }
     if (!secRunner_) {
         SC_LOG_ERROR(LABEL, "failed to create a recvRunner.");
+        ffrt::wait({enhanceTask});
         return false;
     }
 
@@ -725,14 +1217,87 @@ bool SecCompManager::Initialize()
         SecCompManager::GetInstance().ExitSaProcess();
     };
     DelayExitTask::GetInstance().Init(secHandler_, exitSaProcessFunc_);
-    FirstUseDialog::GetInstance().Init(secHandler_);
-    SecCompEnhanceAdapter::EnableInputEnhance();
+    {
+        StartupPhaseTimer timer(STARTUP_PHASE_FIRST_USE_DIALOG_INIT);
+        FirstUseDialog::GetInstance().Init(secHandler_);
+    }
+    if (!DisplayGeometryCache::GetInstance().RegisterListeners()) {
+        SC_LOG_WARN(LABEL, "display listeners are not registered, display geometry is queried every time.");
+    }
     SecCompPermManager::GetInstance().InitEventHandler(secHandler_);
+    SecCompPermManager::GetInstance().RegisterPermStateCallback();
+    SecCompUpdateChannel::GetInstance().InitEventHandler(secHandler_);
     DelayExitTask::GetInstance().Start();
 
+    ffrt::wait({enhanceTask});
     return true;
 }
 
+void SecCompManager::PrepareDeferredInit()
+{
+    std::lock_guard<std::mutex> lock(deferredInitLock_);
+    if (deferredInitState_ == DEFERRED_INIT_NOT_START) {
+        deferredInitState_ = DEFERRED_INIT_RUNNING;
+    }
+}
+
+void SecCompManager::StartDeferredInit(const std::function<void ()>& finishFunc)
+{
+    {
+        std::lock_guard<std::mutex> lock(deferredInitLock_);
+        if ((deferredInitState_ == DEFERRED_INIT_DONE) || isDeferredInitPosted_) {
+            return;
+        }
+        deferredInitState_ = DEFERRED_INIT_RUNNING;
+        isDeferredInitPosted_ = true;
+    }
+    std::function<void()> deferredTask = ([this, finishFunc]() {
+        this->RunDeferredInit(finishFunc);
+    });
+    if ((secHandler_ == nullptr) || !secHandler_->ProxyPostTask(deferredTask, DEFERRED_INIT_TASK)) {
+        SC_LOG_WARN(LABEL, "post deferred init task failed, run it directly.");
+        RunDeferredInit(finishFunc);
+    }
+}
+
+void SecCompManager::RunDeferredInit(const std::function<void ()>& finishFunc)
+{
+    {
+        StartupPhaseTimer timer(STARTUP_PHASE_ENABLE_INPUT_ENHANCE);
+        EnableInputEnhance();
+    }
+    {
+        std::lock_guard<std::mutex> lock(deferredInitLock_);
+        deferredInitState_ = DEFERRED_INIT_DONE;
+    }
+    deferredInitCond_.notify_all();
+    if (finishFunc != nullptr) {
+        finishFunc();
+    }
+}
+
+bool SecCompManager::WaitForDeferredInit()
+{
+    std::unique_lock<std::mutex> lock(deferredInitLock_);
+    // service started without deferred steps has nothing to wait for
+    if (deferredInitState_ != DEFERRED_INIT_RUNNING) {
+        return true;
+    }
+    LatencyStageTimer timer(LATENCY_STAGE_WAIT_DEFERRED_INIT);
+    if (!deferredInitCond_.wait_for(lock, std::chrono::milliseconds(WAIT_DEFERRED_INIT_MILLISECONDS),
+        [this]() { return deferredInitState_ == DEFERRED_INIT_DONE; })) {
+        SC_LOG_ERROR(LABEL, "Wait for deferred init timeout.");
+        return false;
+    }
+    return true;
+}
+
+void SecCompManager::EnableInputEnhance()
+{
+    std::lock_guard<std::mutex> lock(inputEnhanceLock_);
+    SecCompEnhanceAdapter::EnableInputEnhance();
+}
+
 bool SecCompManager::HasCustomPermissionForSecComp()
 {
     uint32_t callingTokenID = IPCSkeleton::GetCallingTokenID();
@@ -15,6 +15,9 @@
 #ifndef SECURITY_COMPONENT_MANAGER_H
 #define SECURITY_COMPONENT_MANAGER_H
 
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <map>
 #include <memory>
@@ -29,6 +32,7 @@
 #include "sec_comp_base.h"
 #include "sec_comp_entity.h"
 #include "sec_comp_info.h"
+#include "sec_comp_info_helper.h"
 #include "sec_comp_malicious_apps.h"
 #include "sec_event_handler.h"
 
@@ -42,12 +46,34 @@ struct SecCompCallerInfo {
     int32_t userId;
 };
 
+// fields except compLock are guarded by compLock
 struct ProcessCompInfos {
-    std::vector<std::shared_ptr<SecCompEntity>> compList;
+    ffrt::shared_mutex compLock;
+    int32_t compHead = -1;
+    size_t compCount = 0;
     bool isForeground = false;
+    bool isRemoved = false;
     AccessToken::AccessTokenID tokenId;
 };
 
+enum class SlotState : int32_t {
+    SLOT_FREE = 0,
+    SLOT_RESERVED,
+    SLOT_BOUND,
+};
+
+// scId encodes slot index and slot generation, stale ids never match a reused slot.
+// state and generation are guarded by slotLock_, the others by the owner process compLock.
+struct SecCompSlot {
+    std::shared_ptr<SecCompEntity> entity;
+    std::atomic<int32_t> pid {0};
+    std::atomic<int32_t> scId {INVALID_SC_ID};
+    int32_t prev = -1;
+    int32_t next = -1;
+    int32_t generation = 1;
+    SlotState state = SlotState::SLOT_FREE;
+};
+
 struct ComponentCheckParams {
     std::shared_ptr<SecCompEntity> sc;
     std::shared_ptr<SecCompBase> report;
@@ -64,21 +90,34 @@ public:
     static SecCompManager& GetInstance();
     virtual ~SecCompManager() = default;
 
-    int32_t RegisterSecurityComponent(SecCompType type, const nlohmann::json& jsonComponent,
+    int32_t RegisterSecurityComponent(SecCompType type, const SecCompInfoPayload& info,
         const SecCompCallerInfo& caller, int32_t& scId);
-    int32_t UpdateSecurityComponent(int32_t scId, const nlohmann::json& jsonComponent,
-        const SecCompCallerInfo& caller);
+    int32_t UpdateSecurityComponent(int32_t scId, const SecCompInfoPayload& info,
+        const SecCompCallerInfo& caller, uint32_t& version);
+    int32_t UpdateSecurityComponentDelta(int32_t scId, const nlohmann::json& jsonDelta,
+        const SecCompCallerInfo& caller, uint32_t& version);
     int32_t UnregisterSecurityComponent(int32_t scId, const SecCompCallerInfo& caller);
+    // items failed already are skipped, infos[i] is the parsed info of items[i]
+    int32_t RegisterSecurityComponents(std::vector<SecCompRegisterItem>& items,
+        const std::vector<SecCompInfoPayload>& infos, const SecCompCallerInfo& caller);
+    void UnregisterSecurityComponents(const std::vector<int32_t>& scIds, const SecCompCallerInfo& caller,
+        std::vector<int32_t>& results);
     int32_t StartDialog(const SecCompInfo& info, std::shared_ptr<SecCompEntity>& sc,
         const std::vector<sptr<IRemoteObject>>& remote);
-    int32_t ReportSecurityComponentClickEvent(SecCompInfo& secCompInfo, const nlohmann::json& jsonComponent,
+    int32_t ReportSecurityComponentClickEvent(SecCompInfo& secCompInfo, const SecCompInfoPayload& info,
         const SecCompCallerInfo& caller, const std::vector<sptr<IRemoteObject>>& remote, std::string& message);
+    // the dialog grants a snapshot of the component, the grant state is copied back to the registered one
+    void CommitDialogGrantState(const std::shared_ptr<SecCompEntity>& staged);
     int32_t CheckClickEventParams(const SecCompCallerInfo& caller, const std::vector<sptr<IRemoteObject>>& remote);
     void NotifyProcessForeground(int32_t pid);
     void NotifyProcessBackground(int32_t pid);
     void NotifyProcessDied(int32_t pid, bool isProcessCached);
     void DumpSecComp(std::string& dumpStr);
     bool Initialize();
+    void PrepareDeferredInit();
+    void StartDeferredInit(const std::function<void ()>& finishFunc);
+    bool WaitForDeferredInit();
+    void EnableInputEnhance();
     void ExitSaProcess();
     void ExitWhenAppMgrDied();
     int32_t AddSecurityComponentProcess(const SecCompCallerInfo& caller);
@@ -86,34 +125,81 @@ public:
 
 private:
     SecCompManager();
+    static constexpr size_t SLOT_CHUNK_SIZE = 256;
+    static constexpr size_t MAX_SLOT_CHUNK_NUM = 256;
+
     bool IsCompExist();
-    bool IsScIdExist(int32_t scId);
+    std::shared_ptr<ProcessCompInfos> GetProcessCompInfos(int32_t pid);
+    int32_t BindSecurityComponentToProcess(ProcessCompInfos& info, int32_t pid,
+        const std::shared_ptr<SecCompEntity>& newEntity);
+    int32_t AddSecurityComponentToProcess(ProcessCompInfos& info, int32_t pid,
+        const std::shared_ptr<SecCompEntity>& newEntity);
+    void AddSecurityComponentsToProcess(ProcessCompInfos& info, int32_t pid,
+        const std::vector<std::shared_ptr<SecCompEntity>>& entities, std::vector<SecCompRegisterItem>& items);
     int32_t AddSecurityComponentToList(int32_t pid,
         AccessToken::AccessTokenID tokenId, std::shared_ptr<SecCompEntity> newEntity);
+    int32_t AddSecurityComponentsToList(int32_t pid, AccessToken::AccessTokenID tokenId,
+        const std::vector<std::shared_ptr<SecCompEntity>>& entities, std::vector<SecCompRegisterItem>& items);
+    int32_t UnlinkSecurityComponent(ProcessCompInfos& info, int32_t pid, int32_t scId);
     int32_t DeleteSecurityComponentFromList(int32_t pid, int32_t scId);
+    std::shared_ptr<SecCompEntity> CreateSecCompEntity(SecCompType type, const SecCompInfoPayload& info,
+        const SecCompCallerInfo& caller, int32_t& res);
     std::shared_ptr<SecCompEntity> GetSecurityComponentFromList(int32_t pid, int32_t scId);
+    std::shared_ptr<SecCompEntity> SnapshotSecurityComponent(ProcessCompInfos& procInfo, int32_t pid, int32_t scId);
+    int32_t CommitSecurityComponent(ProcessCompInfos& procInfo, int32_t pid,
+        const std::shared_ptr<SecCompEntity>& staged, const std::shared_ptr<SecCompBase>& baseInfo,
+        bool isVersionCheck);
+    void CommitGrantState(ProcessCompInfos& procInfo, int32_t pid, const std::shared_ptr<SecCompEntity>& staged);
+    int32_t VerifyClickEvent(SecCompInfo& info, std::shared_ptr<SecCompEntity>& sc,
+        const SecCompInfoPayload& compInfo, const SecCompCallerInfo& caller, std::string& message);
     int32_t CheckClickSecurityComponentInfo(std::shared_ptr<SecCompEntity> sc, int32_t scId,
-        const nlohmann::json& jsonComponent,  const SecCompCallerInfo& caller, std::string& message);
+        const SecCompInfoPayload& compInfo,  const SecCompCallerInfo& caller, std::string& message);
+    void SendUpdateInfoInvalidSysEvent(int32_t scId, SecCompType type, const SecCompCallerInfo& caller);
     void SendCheckInfoEnhanceSysEvent(int32_t scId,
         SecCompType type, const std::string& scene, int32_t res);
     int32_t CreateScId();
-    void GetFoldOffsetY(const CrossAxisState crossAxisState);
+    void ReleaseScId(int32_t scId);
+    SecCompSlot* GetSlot(int32_t index);
+    SecCompSlot* AppendSlot();
+    int32_t BindSlot(int32_t scId);
+    int32_t GetSlotIndex(int32_t pid, int32_t scId);
+    void ReleaseSlot(int32_t index);
+    void ReleaseProcessComponents(ProcessCompInfos& info);
+    void ResetSlots();
+    int32_t GetFoldOffsetY(const CrossAxisState crossAxisState);
     int32_t CheckComponentInfoValid(const ComponentCheckParams& params);
     int32_t CheckRectInfo(const ComponentCheckParams& params);
     bool AllowToBypassArkuiCheck(const SecCompCallerInfo& caller);
     bool IsPasteboardPermissionGranted(const SecCompCallerInfo& caller, const std::shared_ptr<SecCompEntity>& sc);
+    void RunDeferredInit(const std::function<void ()>& finishFunc);
 
+    // guards componentMap_ and isSaExit_, held shortly, each process has its own compLock.
     ffrt::shared_mutex componentInfoLock_;
-    std::mutex scIdMtx_;
-    std::unordered_map<int32_t, ProcessCompInfos> componentMap_;
-    int32_t scIdStart_;
+    std::unordered_map<int32_t, std::shared_ptr<ProcessCompInfos>> componentMap_;
+    std::mutex slotLock_;
+    std::array<std::unique_ptr<SecCompSlot[]>, MAX_SLOT_CHUNK_NUM> slotChunks_;
+    std::atomic<size_t> slotCount_ {0};
+    std::vector<int32_t> freeSlots_;
     bool isSaExit_ = false;
-    int32_t superFoldOffsetY_ = 0;
 
     std::shared_ptr<AppExecFwk::EventRunner> secRunner_;
     std::shared_ptr<SecEventHandler> secHandler_;
     SecCompMaliciousApps malicious_;
 
+    // init steps not needed to publish the service, run once on secHandler_ after it.
+    // the state is RUNNING from before publish until the steps are done, clicks wait for it
+    enum DeferredInitState {
+        DEFERRED_INIT_NOT_START = 0,
+        DEFERRED_INIT_RUNNING,
+        DEFERRED_INIT_DONE,
+    };
+    std::mutex deferredInitLock_;
+    std::condition_variable deferredInitCond_;
+    DeferredInitState deferredInitState_ = DEFERRED_INIT_NOT_START;
+    bool isDeferredInitPosted_ = false;
+    // input enhance is enabled by deferred init and again when accessibility service starts
+    std::mutex inputEnhanceLock_;
+
     std::function<void ()> exitSaProcessFunc_ = []() { return; };
     DISALLOW_COPY_AND_MOVE(SecCompManager);
 };
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,6 +14,7 @@
  */
 #include "sec_comp_perm_manager.h"
 
+#include <chrono>
 #include "sec_comp_err.h"
 #include "sec_comp_log.h"
 
@@ -27,6 +28,29 @@ static constexpr int32_t DELAY_SAVE_REVOKE_MILLISECONDS = 60 * 1000;
 static const std::string REVOKE_TASK_PREFIX = "RevokeAll";
 static const std::string REVOKE_SAVE_PERM_TASK_PREFIX = "RevokeSavePerm";
 static std::mutex g_instanceMutex;
+// PermStateChangeInfo::permStateChangeType of a revoke
+static constexpr int32_t PERM_STATE_REVOKED = 0;
+static const std::pair<uint32_t, std::string> PERMISSION_BITS[] = {
+    { PERMISSION_BIT_APPROXIMATELY_LOCATION, "ohos.permission.APPROXIMATELY_LOCATION" },
+    { PERMISSION_BIT_LOCATION, "ohos.permission.LOCATION" },
+    { PERMISSION_BIT_SECURE_PASTE, "ohos.permission.SECURE_PASTE" },
+};
+
+static int64_t GetCurrentMilliseconds()
+{
+    return static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static uint32_t GetPermissionBit(const std::string& permissionName)
+{
+    for (const auto& permission : PERMISSION_BITS) {
+        if (permission.second == permissionName) {
+            return permission.first;
+        }
+    }
+    return 0;
+}
 }
 
 SecCompPermManager& SecCompPermManager::GetInstance()
@@ -41,7 +65,7 @@ SecCompPermManager& SecCompPermManager::GetInstance()
     return *instance;
 }
 
-bool SecCompPermManager::DelaySaveRevokePermission(AccessToken::AccessTokenID tokenId, const std::string& taskName)
+bool SecCompPermManager::DelaySaveRevokePermission(AccessToken::AccessTokenID tokenId, int64_t delayTime)
 {
     if (secHandler_ == nullptr) {
         SC_LOG_ERROR(LABEL, "fail to get EventHandler");
@@ -53,84 +77,123 @@ bool SecCompPermManager::DelaySaveRevokePermission(AccessToken::AccessTokenID to
         SecCompPermManager::GetInstance().RevokeTempSavePermissionCount(tokenId);
     });
 
-    SC_LOG_DEBUG(LABEL, "revoke save permission after %{public}d ms", DELAY_SAVE_REVOKE_MILLISECONDS);
-    secHandler_->ProxyPostTask(delayed, taskName, DELAY_SAVE_REVOKE_MILLISECONDS);
+    SC_LOG_DEBUG(LABEL, "revoke save permission after %{public}lld ms", static_cast<long long>(delayTime));
+    secHandler_->ProxyPostTask(delayed, REVOKE_SAVE_PERM_TASK_PREFIX + std::to_string(tokenId), delayTime);
     return true;
 }
 
-bool SecCompPermManager::RevokeSavePermissionTask(const std::string& taskName)
+bool SecCompPermManager::RevokeSavePermissionTask(AccessToken::AccessTokenID tokenId)
 {
     if (secHandler_ == nullptr) {
         SC_LOG_ERROR(LABEL, "fail to get EventHandler");
         return false;
     }
 
-    SC_LOG_DEBUG(LABEL, "revoke save permission task name:%{public}s", taskName.c_str());
-    secHandler_->ProxyRemoveTask(taskName);
+    SC_LOG_DEBUG(LABEL, "revoke save permission task of tokenId: %{public}d", tokenId);
+    secHandler_->ProxyRemoveTask(REVOKE_SAVE_PERM_TASK_PREFIX + std::to_string(tokenId));
     return true;
 }
 
-int32_t SecCompPermManager::GrantTempSavePermission(AccessToken::AccessTokenID tokenId)
+void SecCompPermManager::PublishSaveExpiry(AccessToken::AccessTokenID tokenId, int64_t expiry)
 {
-    auto current = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-    std::string taskName = std::to_string(tokenId) + std::to_string(current);
-    if (!DelaySaveRevokePermission(tokenId, taskName)) {
-        return SC_SERVICE_ERROR_PERMISSION_OPER_FAIL;
+    auto expiryMap = std::atomic_load(&saveExpiryMap_);
+    auto iter = expiryMap->find(tokenId);
+    if (iter != expiryMap->end()) {
+        iter->second->store(expiry, std::memory_order_release);
+        return;
     }
+    auto newMap = std::make_shared<SaveExpiryMap>(*expiryMap);
+    newMap->emplace(tokenId, std::make_shared<std::atomic<int64_t>>(expiry));
+    std::atomic_store(&saveExpiryMap_, std::shared_ptr<const SaveExpiryMap>(std::move(newMap)));
+}
+
+void SecCompPermManager::UnpublishSaveExpiry(AccessToken::AccessTokenID tokenId)
+{
+    auto expiryMap = std::atomic_load(&saveExpiryMap_);
+    auto iter = expiryMap->find(tokenId);
+    if (iter == expiryMap->end()) {
+        return;
+    }
+    // readers still holding the old map must see it revoked as well
+    iter->second->store(0, std::memory_order_release);
+    auto newMap = std::make_shared<SaveExpiryMap>(*expiryMap);
+    newMap->erase(tokenId);
+    std::atomic_store(&saveExpiryMap_, std::shared_ptr<const SaveExpiryMap>(std::move(newMap)));
+}
+
+int32_t SecCompPermManager::GrantTempSavePermission(AccessToken::AccessTokenID tokenId)
+{
+    int64_t current = GetCurrentMilliseconds();
     std::lock_guard<std::mutex> lock(mutex_);
-    saveTaskDequeMap_[tokenId].push_back(taskName);
-    applySaveCountMap_[tokenId]++;
-    SC_LOG_DEBUG(LABEL, "tokenId: %{public}d current permission apply counts is: %{public}d.",
-        tokenId, applySaveCountMap_[tokenId]);
+    SaveLease& lease = saveLeaseMap_[tokenId];
+    // one timer per token, it is posted again on expiry if later grants are still valid
+    if (!lease.isTimerPosted) {
+        if (!DelaySaveRevokePermission(tokenId, DELAY_SAVE_REVOKE_MILLISECONDS)) {
+            if (lease.expiries.empty()) {
+                saveLeaseMap_.erase(tokenId);
+            }
+            return SC_SERVICE_ERROR_PERMISSION_OPER_FAIL;
+        }
+        lease.isTimerPosted = true;
+    }
+    while (!lease.expiries.empty() && (lease.expiries.front() <= current)) {
+        lease.expiries.pop_front();
+    }
+    int64_t expiry = current + DELAY_SAVE_REVOKE_MILLISECONDS;
+    lease.expiries.push_back(expiry);
+    PublishSaveExpiry(tokenId, expiry);
+    SC_LOG_DEBUG(LABEL, "tokenId: %{public}d current permission apply counts is: %{public}zu.",
+        tokenId, lease.expiries.size());
     return SC_OK;
 }
 
 void SecCompPermManager::RevokeTempSavePermissionCount(AccessToken::AccessTokenID tokenId)
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    auto iter = applySaveCountMap_.find(tokenId);
-    if (iter == applySaveCountMap_.end()) {
+    auto iter = saveLeaseMap_.find(tokenId);
+    if (iter == saveLeaseMap_.end()) {
         SC_LOG_ERROR(LABEL, "This hap has no permissions to save files.");
         return;
     }
-    if (saveTaskDequeMap_[tokenId].size() == 0) {
-        SC_LOG_ERROR(LABEL, "Current no task need to be revoke.");
-        return;
-    }
-    std::string taskName = saveTaskDequeMap_[tokenId].front();
-    if (!RevokeSavePermissionTask(taskName)) {
-        return;
+    SaveLease& lease = iter->second;
+    lease.isTimerPosted = false;
+    int64_t current = GetCurrentMilliseconds();
+    while (!lease.expiries.empty() && (lease.expiries.front() <= current)) {
+        lease.expiries.pop_front();
     }
-    saveTaskDequeMap_[tokenId].pop_front();
-    SC_LOG_DEBUG(LABEL, "tokenId: %{public}d current permission apply counts is: %{public}d.",
-        tokenId, applySaveCountMap_[tokenId]);
-    if ((--applySaveCountMap_[tokenId]) == 0) {
-        applySaveCountMap_.erase(tokenId);
+    SC_LOG_DEBUG(LABEL, "tokenId: %{public}d current permission apply counts is: %{public}zu.",
+        tokenId, lease.expiries.size());
+    if (lease.expiries.empty()) {
+        saveLeaseMap_.erase(iter);
+        UnpublishSaveExpiry(tokenId);
         SC_LOG_INFO(LABEL, "tokenId: %{public}d save permission count is 0, revoke it.", tokenId);
+        return;
     }
-    return;
+    // grants made while the timer was pending are all covered by waking up at the latest expiry
+    lease.isTimerPosted = DelaySaveRevokePermission(tokenId, lease.expiries.back() - current);
 }
 
 void SecCompPermManager::RevokeTempSavePermission(AccessToken::AccessTokenID tokenId)
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    applySaveCountMap_.erase(tokenId);
-    auto& taskDeque = saveTaskDequeMap_[tokenId];
-    for (auto iter = taskDeque.begin(); iter != taskDeque.end(); ++iter) {
-        if (!RevokeSavePermissionTask(*iter)) {
-            continue;
+    auto iter = saveLeaseMap_.find(tokenId);
+    if (iter != saveLeaseMap_.end()) {
+        if (iter->second.isTimerPosted) {
+            RevokeSavePermissionTask(tokenId);
         }
+        saveLeaseMap_.erase(iter);
     }
-    taskDeque.clear();
+    UnpublishSaveExpiry(tokenId);
     SC_LOG_INFO(LABEL, "tokenId: %{public}d revoke save permission.", tokenId);
-    return;
 }
 
 bool SecCompPermManager::VerifySavePermission(AccessToken::AccessTokenID tokenId)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto iter = applySaveCountMap_.find(tokenId);
-    if (iter == applySaveCountMap_.end() || applySaveCountMap_[tokenId] == 0) {
+    // called by media library for every file saved, only read the published expiry
+    auto expiryMap = std::atomic_load(&saveExpiryMap_);
+    auto iter = expiryMap->find(tokenId);
+    if ((iter == expiryMap->end()) ||
+        (iter->second->load(std::memory_order_acquire) <= GetCurrentMilliseconds())) {
         SC_LOG_ERROR(LABEL, "This hap has no permissions to save files.");
         return false;
     }
@@ -160,43 +223,63 @@ bool SecCompPermManager::VerifyPermission(AccessToken::AccessTokenID tokenId, Se
     return false;
 }
 
-void SecCompPermManager::AddAppGrantPermissionRecord(AccessToken::AccessTokenID tokenId,
-    const std::string& permissionName)
+void SecCompPermManager::AddAppGrantPermissionRecord(AccessToken::AccessTokenID tokenId, uint32_t permissionBit)
 {
-    auto iter = grantMap_.find(tokenId);
-    if (iter != grantMap_.end()) {
-        iter->second.insert(permissionName);
-        return;
-    }
-    std::set<std::string> permSet;
-    permSet.insert(permissionName);
-    grantMap_[tokenId] = permSet;
+    grantMap_[tokenId] |= permissionBit;
 }
 
-void SecCompPermManager::RemoveAppGrantPermissionRecord(AccessToken::AccessTokenID tokenId,
-    const std::string& permissionName)
+void SecCompPermManager::RemoveAppGrantPermissionRecord(AccessToken::AccessTokenID tokenId, uint32_t permissionBit)
 {
     auto iter = grantMap_.find(tokenId);
     if (iter == grantMap_.end()) {
         return;
     }
 
-    grantMap_[tokenId].erase(permissionName);
+    iter->second &= ~permissionBit;
+    if (iter->second == 0) {
+        grantMap_.erase(iter);
+    }
 }
 
-int32_t SecCompPermManager::GrantAppPermission(AccessToken::AccessTokenID tokenId,
-    const std::string& permissionName)
+int32_t SecCompPermManager::GrantAppPermissionOnce(AccessToken::AccessTokenID tokenId,
+    const std::string& permissionName, bool& isGranted)
 {
+    isGranted = false;
+    uint32_t permissionBit = GetPermissionBit(permissionName);
     std::lock_guard<std::mutex> lock(grantMtx_);
+    auto iter = grantMap_.find(tokenId);
+    // a revoke made outside clears the record by the state callback. it may arrive just after a click, which then
+    // fails as if it came first. without the callback the record is confirmed by access token, one more ipc.
+    if ((permissionBit != 0) && (iter != grantMap_.end()) && ((iter->second & permissionBit) != 0) &&
+        (isPermStateWatched_.load(std::memory_order_acquire) ||
+        (AccessToken::AccessTokenKit::VerifyAccessToken(tokenId, permissionName) ==
+        AccessToken::TypePermissionState::PERMISSION_GRANTED))) {
+        // still held from an earlier click, only the pending revoke has to be dropped. it is dropped under
+        // grantMtx_ so that a revoke task can not run between the check and the cancel.
+        SC_LOG_DEBUG(LABEL, "permission %{public}s is held by tokenId:%{public}d, skip granting",
+            permissionName.c_str(), tokenId);
+        CancelAppRevokingPermisions(tokenId);
+        return SC_OK;
+    }
+
     int32_t res = AccessToken::AccessTokenKit::GrantPermission(tokenId, permissionName,
         AccessToken::PermissionFlag::PERMISSION_COMPONENT_SET);
     SC_LOG_INFO(LABEL, "grant permission res: %{public}d, permission: %{public}s, tokenId:%{public}d",
         res, permissionName.c_str(), tokenId);
-
-    AddAppGrantPermissionRecord(tokenId, permissionName);
+    if (res == SC_OK) {
+        AddAppGrantPermissionRecord(tokenId, permissionBit);
+        isGranted = true;
+    }
     return res;
 }
 
+int32_t SecCompPermManager::GrantAppPermission(AccessToken::AccessTokenID tokenId,
+    const std::string& permissionName)
+{
+    bool isGranted = false;
+    return GrantAppPermissionOnce(tokenId, permissionName, isGranted);
+}
+
 int32_t SecCompPermManager::RevokeAppPermission(AccessToken::AccessTokenID tokenId,
     const std::string& permissionName)
 {
@@ -206,7 +289,7 @@ int32_t SecCompPermManager::RevokeAppPermission(AccessToken::AccessTokenID token
     SC_LOG_INFO(LABEL, "revoke permission res: %{public}d, permission: %{public}s, tokenId:%{public}d",
         res, permissionName.c_str(), tokenId);
 
-    RemoveAppGrantPermissionRecord(tokenId, permissionName);
+    RemoveAppGrantPermissionRecord(tokenId, GetPermissionBit(permissionName));
     return res;
 }
 
@@ -242,14 +325,17 @@ void SecCompPermManager::RevokeAppPermisionsImmediately(AccessToken::AccessToken
         return;
     }
 
-    auto& grantSet = grantMap_[tokenId];
-    for (auto iter = grantSet.begin(); iter != grantSet.end(); ++iter) {
-        int32_t res = AccessToken::AccessTokenKit::RevokePermission(tokenId, *iter,
+    uint32_t grantMask = it->second;
+    grantMap_.erase(it);
+    for (const auto& permission : PERMISSION_BITS) {
+        if ((grantMask & permission.first) == 0) {
+            continue;
+        }
+        int32_t res = AccessToken::AccessTokenKit::RevokePermission(tokenId, permission.second,
             AccessToken::PermissionFlag::PERMISSION_COMPONENT_SET);
         SC_LOG_INFO(LABEL, "revoke token id %{public}d permission %{public}s res %{public}d",
-            tokenId, iter->c_str(), res);
+            tokenId, permission.second.c_str(), res);
     }
-    grantSet.clear();
 }
 
 void SecCompPermManager::CancelAppRevokingPermisions(AccessToken::AccessTokenID tokenId)
@@ -269,6 +355,44 @@ void SecCompPermManager::InitEventHandler(const std::shared_ptr<SecEventHandler>
     secHandler_ = secHandler;
 }
 
+void SecCompPermStateCallback::PermStateChangeCallback(AccessToken::PermStateChangeInfo& result)
+{
+    if (result.permStateChangeType != PERM_STATE_REVOKED) {
+        return;
+    }
+    SecCompPermManager::GetInstance().OnPermissionRevoked(result.tokenID, result.permissionName);
+}
+
+void SecCompPermManager::RegisterPermStateCallback()
+{
+    if (isPermStateWatched_.load()) {
+        return;
+    }
+    AccessToken::PermStateChangeScope scope;
+    for (const auto& permission : PERMISSION_BITS) {
+        scope.permList.emplace_back(permission.second);
+    }
+    auto callback = std::make_shared<SecCompPermStateCallback>(scope);
+    int32_t res = AccessToken::AccessTokenKit::RegisterPermStateChangeCallback(callback);
+    if (res != SC_OK) {
+        SC_LOG_WARN(LABEL, "register perm state callback failed, res %{public}d, grants are verified", res);
+        return;
+    }
+    permStateCallback_ = callback;
+    isPermStateWatched_.store(true, std::memory_order_release);
+}
+
+void SecCompPermManager::OnPermissionRevoked(AccessToken::AccessTokenID tokenId, const std::string& permissionName)
+{
+    uint32_t permissionBit = GetPermissionBit(permissionName);
+    if (permissionBit == 0) {
+        return;
+    }
+    SC_LOG_DEBUG(LABEL, "permission %{public}s of tokenId:%{public}d is revoked", permissionName.c_str(), tokenId);
+    std::lock_guard<std::mutex> lock(grantMtx_);
+    RemoveAppGrantPermissionRecord(tokenId, permissionBit);
+}
+
 namespace {
 inline bool IsDlpSandboxCalling(AccessToken::AccessTokenID tokenId)
 {
@@ -289,13 +413,17 @@ int32_t SecCompPermManager::GrantTempPermission(AccessToken::AccessTokenID token
     switch (type) {
         case LOCATION_COMPONENT:
             {
-                res = GrantAppPermission(tokenId, "ohos.permission.APPROXIMATELY_LOCATION");
+                bool isApproxGranted = false;
+                res = GrantAppPermissionOnce(tokenId, "ohos.permission.APPROXIMATELY_LOCATION", isApproxGranted);
                 if (res != SC_OK) {
                     return SC_SERVICE_ERROR_PERMISSION_OPER_FAIL;
                 }
                 res = GrantAppPermission(tokenId, "ohos.permission.LOCATION");
                 if (res != SC_OK) {
-                    RevokeAppPermission(tokenId, "ohos.permission.APPROXIMATELY_LOCATION");
+                    // a permission held from an earlier click is left to its own delayed revoke
+                    if (isApproxGranted) {
+                        RevokeAppPermission(tokenId, "ohos.permission.APPROXIMATELY_LOCATION");
+                    }
                     return SC_SERVICE_ERROR_PERMISSION_OPER_FAIL;
                 }
                 SC_LOG_INFO(LABEL, "Grant location permission, scid = %{public}d.", componentInfo->nodeId_);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,17 +15,47 @@
 #ifndef SECURITY_COMPONENT_PERMISSION_MANAGER_H
 #define SECURITY_COMPONENT_PERMISSION_MANAGER_H
 
+#include <atomic>
 #include <deque>
 #include <map>
-#include <set>
+#include <memory>
+#include <unordered_map>
 #include "accesstoken_kit.h"
 #include "ffrt.h"
+#include "perm_state_change_callback_customize.h"
 #include "sec_comp_base.h"
 #include "sec_event_handler.h"
 
 namespace OHOS {
 namespace Security {
 namespace SecurityComponent {
+// permissions granted by components are recorded per token as a bitmask
+enum SecCompPermissionBit : uint32_t {
+    PERMISSION_BIT_APPROXIMATELY_LOCATION = 1U << 0,
+    PERMISSION_BIT_LOCATION = 1U << 1,
+    PERMISSION_BIT_SECURE_PASTE = 1U << 2,
+};
+
+// save grants of a token that are not expired yet, guarded by SecCompPermManager::mutex_
+struct SaveLease {
+    // steady clock milliseconds in ascending order, one per grant
+    std::deque<int64_t> expiries;
+    bool isTimerPosted = false;
+};
+
+// published for lock-free reading, a token is only added or removed by copying the map
+using SaveExpiryMap = std::unordered_map<AccessToken::AccessTokenID, std::shared_ptr<std::atomic<int64_t>>>;
+
+// permissions revoked outside the service, e.g. by the user in settings, clear their grant records
+class SecCompPermStateCallback : public AccessToken::PermStateChangeCallbackCustomize {
+public:
+    explicit SecCompPermStateCallback(const AccessToken::PermStateChangeScope& scope)
+        : AccessToken::PermStateChangeCallbackCustomize(scope) {}
+    ~SecCompPermStateCallback() override = default;
+
+    void PermStateChangeCallback(AccessToken::PermStateChangeInfo& result) override;
+};
+
 class SecCompPermManager {
 public:
     SecCompPermManager() = default;
@@ -45,28 +75,37 @@ public:
 
     void InitEventHandler(const std::shared_ptr<SecEventHandler>& secHandler);
     std::shared_ptr<SecEventHandler> GetSecEventHandler() const;
+    void RegisterPermStateCallback();
+    void OnPermissionRevoked(AccessToken::AccessTokenID tokenId, const std::string& permissionName);
 
     void RevokeAppPermisionsDelayed(AccessToken::AccessTokenID tokenId);
     void CancelAppRevokingPermisions(AccessToken::AccessTokenID tokenId);
 
 private:
-    bool DelaySaveRevokePermission(AccessToken::AccessTokenID tokenId, const std::string& taskName);
-    bool RevokeSavePermissionTask(const std::string& taskName);
+    bool DelaySaveRevokePermission(AccessToken::AccessTokenID tokenId, int64_t delayTime);
+    bool RevokeSavePermissionTask(AccessToken::AccessTokenID tokenId);
     void RevokeTempSavePermissionCount(AccessToken::AccessTokenID tokenId);
+    void PublishSaveExpiry(AccessToken::AccessTokenID tokenId, int64_t expiry);
+    void UnpublishSaveExpiry(AccessToken::AccessTokenID tokenId);
     void RevokeAppPermisionsImmediately(AccessToken::AccessTokenID tokenId);
 
-    void AddAppGrantPermissionRecord(AccessToken::AccessTokenID tokenId,
-        const std::string& permissionName);
-    void RemoveAppGrantPermissionRecord(AccessToken::AccessTokenID tokenId,
-        const std::string& permissionName);
+    int32_t GrantAppPermissionOnce(AccessToken::AccessTokenID tokenId, const std::string& permissionName,
+        bool& isGranted);
+    void AddAppGrantPermissionRecord(AccessToken::AccessTokenID tokenId, uint32_t permissionBit);
+    void RemoveAppGrantPermissionRecord(AccessToken::AccessTokenID tokenId, uint32_t permissionBit);
 
-    std::unordered_map<AccessToken::AccessTokenID, int32_t> applySaveCountMap_;
-    std::unordered_map<AccessToken::AccessTokenID, std::deque<std::string>> saveTaskDequeMap_;
+    std::unordered_map<AccessToken::AccessTokenID, SaveLease> saveLeaseMap_;
+    // latest save expiry of every token in saveLeaseMap_, VerifySavePermission reads it without mutex_
+    std::shared_ptr<const SaveExpiryMap> saveExpiryMap_ = std::make_shared<const SaveExpiryMap>();
     std::mutex mutex_;
     std::shared_ptr<SecEventHandler> secHandler_;
 
     std::mutex grantMtx_;
-    std::unordered_map<int32_t, std::set<std::string>> grantMap_;
+    // tokenId -> SecCompPermissionBit of permissions granted and not revoked yet
+    std::unordered_map<AccessToken::AccessTokenID, uint32_t> grantMap_;
+    std::shared_ptr<SecCompPermStateCallback> permStateCallback_;
+    // grantMap_ follows revokes made outside, a held grant is trusted without asking access token
+    std::atomic<bool> isPermStateWatched_ {false};
 };
 }  // namespace SecurityComponent
 }  // namespace Security
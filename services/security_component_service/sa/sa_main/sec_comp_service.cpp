@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,21 +14,27 @@
  */
 #include "sec_comp_service.h"
 
+#include <algorithm>
 #include <unistd.h>
 
 #include "app_mgr_death_recipient.h"
-#include "bundle_info.h"
-#include "bundle_mgr_client.h"
+#include "display_geometry_cache.h"
+#include "ffrt.h"
+#include "first_use_dialog.h"
 #include "hisysevent.h"
 #include "hitrace_meter.h"
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
+#include "sec_comp_bundle_info_cache.h"
 #include "sec_comp_click_event_parcel.h"
 #include "sec_comp_enhance_adapter.h"
 #include "sec_comp_err.h"
+#include "sec_comp_latency_stats.h"
 #include "sec_comp_manager.h"
 #include "sec_comp_log.h"
+#include "sec_comp_update_channel.h"
 #include "system_ability_definition.h"
+#include "window_scale_cache.h"
 
 namespace OHOS {
 namespace Security {
@@ -40,6 +46,32 @@ static constexpr int32_t BASE_USER_RANGE = 200000;
 #ifndef SA_ID_SECURITY_COMPONENT_SERVICE
 constexpr int32_t SA_ID_SECURITY_COMPONENT_SERVICE = 3506;
 #endif
+
+// enhance service checks the original json text, binary info and delta are only accepted without it
+static uint32_t NegotiateInfoVersion(uint32_t clientVersion)
+{
+    if ((clientVersion < SC_INFO_VERSION_BINARY) || SecCompEnhanceAdapter::IsSrvEnhanceEnabled()) {
+        return SC_INFO_VERSION_JSON;
+    }
+    return std::min(clientVersion, SC_INFO_VERSION_DELTA);
+}
+
+// enhance service pairs every request with its own session, updates can not bypass it through the ring
+static uint32_t NegotiateUpdateChannel()
+{
+    if (SecCompEnhanceAdapter::IsSrvEnhanceEnabled()) {
+        return 0;
+    }
+    return SC_CHANNEL_UPDATE_RING;
+}
+
+// cheap framing check, the text itself is validated by the sax parser
+static bool IsJsonObjectText(const std::string& componentInfo)
+{
+    size_t first = componentInfo.find_first_not_of(" \t\r\n");
+    size_t last = componentInfo.find_last_not_of(" \t\r\n");
+    return (first != std::string::npos) && (componentInfo[first] == '{') && (componentInfo[last] == '}');
+}
 }
 
 REGISTER_SYSTEM_ABILITY_BY_ID(SecCompService, SA_ID_SECURITY_COMPONENT_SERVICE, true);
@@ -62,27 +94,42 @@ void SecCompService::OnStart()
         return;
     }
     SC_LOG_INFO(LABEL, "SecCompService is starting");
-    if (!RegisterAppStateObserver()) {
+    StartupPhaseTimer totalTimer(STARTUP_PHASE_TOTAL);
+    // registering to app manager waits on its ipc, the manager is initialized meanwhile
+    bool isObserverRegistered = false;
+    ffrt::task_handle registerTask = ffrt::submit_h([this, &isObserverRegistered]() {
+        StartupPhaseTimer registerTimer(STARTUP_PHASE_REGISTER_APP_STATE_OBSERVER);
+        isObserverRegistered = this->RegisterAppStateObserver();
+    }, {}, {}, ffrt::task_attr().name("SecCompRegisterObserver"));
+    bool isInitialized = Initialize();
+    ffrt::wait({registerTask});
+    if (!isObserverRegistered) {
         SC_LOG_ERROR(LABEL, "Failed to register app state observer!");
         FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
         return;
     }
-    if (!Initialize()) {
+    if (!isInitialized) {
         SC_LOG_ERROR(LABEL, "Failed to initialize");
         FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
         return;
     }
 
     state_ = ServiceRunningState::STATE_RUNNING;
+    // input enhance is not needed to publish, clicks arriving before it is enabled wait for it
+    SecCompManager::GetInstance().PrepareDeferredInit();
+    StartupPhaseTimer publishTimer(STARTUP_PHASE_PUBLISH);
     bool ret = Publish(this);
     if (!ret) {
         SC_LOG_ERROR(LABEL, "Failed to publish service!");
         FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
         return;
     }
-    HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "SERVICE_INIT_SUCCESS",
-        HiviewDFX::HiSysEvent::EventType::BEHAVIOR, "PID", getpid());
+    publishTimer.Finish();
+    totalTimer.Finish();
     SC_LOG_INFO(LABEL, "Congratulations, SecCompService start successfully!");
+    SecCompManager::GetInstance().StartDeferredInit([this]() {
+        this->ReportServiceInitSuccess();
+    });
 #if (!defined (TDD_ENABLE)) && (!defined (FUZZ_ENABLE))
     SC_LOG_INFO(LABEL, "Start to listen accessibility service.");
     AddSystemAbilityListener(ACCESSIBILITY_MANAGER_SERVICE_ID);
@@ -90,11 +137,28 @@ void SecCompService::OnStart()
     FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
 }
 
+void SecCompService::ReportServiceInitSuccess() const
+{
+    SecCompLatencyStats& stats = SecCompLatencyStats::GetInstance();
+    HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "SERVICE_INIT_SUCCESS",
+        HiviewDFX::HiSysEvent::EventType::BEHAVIOR, "PID", getpid(),
+        "TOTAL_TIME", stats.GetStartupPhase(STARTUP_PHASE_TOTAL),
+        "REGISTER_OBSERVER_TIME", stats.GetStartupPhase(STARTUP_PHASE_REGISTER_APP_STATE_OBSERVER),
+        "START_ENHANCE_TIME", stats.GetStartupPhase(STARTUP_PHASE_START_ENHANCE_SERVICE),
+        "CREATE_RUNNER_TIME", stats.GetStartupPhase(STARTUP_PHASE_CREATE_EVENT_RUNNER),
+        "FIRST_USE_INIT_TIME", stats.GetStartupPhase(STARTUP_PHASE_FIRST_USE_DIALOG_INIT),
+        "INPUT_ENHANCE_TIME", stats.GetStartupPhase(STARTUP_PHASE_ENABLE_INPUT_ENHANCE),
+        "PUBLISH_TIME", stats.GetStartupPhase(STARTUP_PHASE_PUBLISH));
+}
+
 void SecCompService::OnStop()
 {
     SC_LOG_INFO(LABEL, "Stop service");
     state_ = ServiceRunningState::STATE_NOT_START;
     UnregisterAppStateObserver();
+    DisplayGeometryCache::GetInstance().UnregisterListeners();
+    WindowScaleCache::GetInstance().UnregisterListeners();
+    FirstUseDialog::GetInstance().FlushFirstUseRecord();
 }
 
 bool SecCompService::RegisterAppStateObserver()
@@ -168,7 +232,7 @@ bool SecCompService::GetCallerInfo(SecCompCallerInfo& caller)
         SC_LOG_ERROR(LABEL, "Get caller tokenId invalid");
         return false;
     }
-    std::unique_lock<std::mutex> lock(secCompSrvMutex_);
+    // appStateObserver_ is set before the service is published, the observer locks its own table
     if ((uid != ROOT_UID) && (!appStateObserver_->IsProcessForeground(pid, uid))) {
         SC_LOG_ERROR(LABEL, "caller pid is not in foreground");
         return false;
@@ -181,15 +245,58 @@ bool SecCompService::GetCallerInfo(SecCompCallerInfo& caller)
 }
 
 int32_t SecCompService::ParseParams(const std::string& componentInfo,
-    SecCompCallerInfo& caller, nlohmann::json& jsonRes)
+    SecCompCallerInfo& caller, SecCompInfoPayload& infoRes)
 {
     if (!GetCallerInfo(caller)) {
         SC_LOG_ERROR(LABEL, "Check caller failed");
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
 
-    jsonRes = nlohmann::json::parse(componentInfo, nullptr, false);
-    if (jsonRes.is_discarded()) {
+    return ParseComponentInfo(componentInfo, infoRes);
+}
+
+int32_t SecCompService::ParseComponentInfo(const std::string& componentInfo, SecCompInfoPayload& infoRes)
+{
+    LatencyStageTimer timer(LATENCY_STAGE_PARSE_INFO);
+    infoRes = SecCompInfoPayload();
+    if (SecCompBase::IsBinaryInfo(componentInfo)) {
+        if ((componentInfo.size() > SC_BINARY_MAX_SIZE) ||
+            (NegotiateInfoVersion(SC_INFO_VERSION_BINARY) < SC_INFO_VERSION_BINARY)) {
+            SC_LOG_ERROR(LABEL, "binary component info is not accepted");
+            return SC_SERVICE_ERROR_VALUE_INVALID;
+        }
+        // decoded by SecCompBase::FromBinary in place, neither copied nor parsed as json
+        infoRes.binary = reinterpret_cast<const uint8_t*>(componentInfo.data());
+        infoRes.binaryLen = componentInfo.size();
+        return SC_OK;
+    }
+
+    if (SecCompBase::IsDeltaInfo(componentInfo)) {
+        // delta is patched by tags on the dom
+        if (componentInfo.size() <= SC_JSON_MAX_SIZE) {
+            infoRes.json = nlohmann::json::parse(componentInfo.begin() + 1, componentInfo.end(), nullptr, false);
+        }
+        if (!infoRes.json.is_object()) {
+            SC_LOG_ERROR(LABEL, "delta component info invalid");
+            return SC_SERVICE_ERROR_VALUE_INVALID;
+        }
+        infoRes.isDelta = true;
+        return SC_OK;
+    }
+
+    // enhance service checks the dom, the others are filled in one pass later
+    if (!SecCompEnhanceAdapter::IsSrvEnhanceEnabled()) {
+        if ((componentInfo.size() > SC_JSON_MAX_SIZE) || !IsJsonObjectText(componentInfo)) {
+            SC_LOG_ERROR(LABEL, "component info invalid %{public}s", componentInfo.c_str());
+            return SC_SERVICE_ERROR_VALUE_INVALID;
+        }
+        // carried as json string, parsed by SecCompBase::FromJsonText once the component type is known
+        infoRes.json = componentInfo;
+        return SC_OK;
+    }
+
+    infoRes.json = nlohmann::json::parse(componentInfo, nullptr, false);
+    if (infoRes.json.is_discarded()) {
         SC_LOG_ERROR(LABEL, "component info invalid %{public}s", componentInfo.c_str());
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
@@ -198,8 +305,8 @@ int32_t SecCompService::ParseParams(const std::string& componentInfo,
 
 int32_t SecCompService::WriteError(int32_t res, SecCompRawdata& rawReply)
 {
-    MessageParcel replyParcel;
-    if (!replyParcel.WriteInt32(res)) {
+    std::shared_ptr<MessageParcel> replyParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!replyParcel->WriteInt32(res)) {
         SC_LOG_ERROR(LABEL, "Write error res failed.");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
@@ -238,11 +345,8 @@ int32_t SecCompService::RegisterReadFromRawdata(SecCompRawdata& rawData, SecComp
     return SC_OK;
 }
 
-int32_t SecCompService::RegisterSecurityComponentBody(SecCompType type,
-    const std::string& componentInfo, int32_t& scId)
+bool SecCompService::GetRegisterCallerInfo(SecCompCallerInfo& caller)
 {
-    StartTrace(HITRACE_TAG_ACCESS_CONTROL, "SecurityComponentRegister");
-    SecCompCallerInfo caller;
     caller.tokenId = IPCSkeleton::GetCallingTokenID();
     caller.pid = IPCSkeleton::GetCallingPid();
     caller.uid = IPCSkeleton::GetCallingUid();
@@ -250,53 +354,57 @@ int32_t SecCompService::RegisterSecurityComponentBody(SecCompType type,
     if ((caller.uid != ROOT_UID)
         && (AccessToken::AccessTokenKit::GetTokenTypeFlag(caller.tokenId) != AccessToken::TOKEN_HAP)) {
         SC_LOG_ERROR(LABEL, "Get caller tokenId invalid");
+        return false;
+    }
+    return true;
+}
+
+void SecCompService::ReportRegisterSuccess(const SecCompCallerInfo& caller, int32_t scId, SecCompType type)
+{
+    SecCompBundleInfo bundleInfo;
+    if (!SecCompBundleInfoCache::GetInstance().GetBundleInfo(caller.uid, caller.userId, bundleInfo)) {
+        return;
+    }
+
+    HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "REGISTER_SUCCESS",
+        HiviewDFX::HiSysEvent::EventType::BEHAVIOR, "CALLER_UID", caller.uid,
+        "CALLER_PID", IPCSkeleton::GetCallingRealPid(), "CALLER_BUNDLE_NAME", bundleInfo.bundleName,
+        "CALLER_BUNDLE_VERSION", bundleInfo.versionName, "SC_ID", scId, "SC_TYPE", type);
+}
+
+int32_t SecCompService::RegisterSecurityComponentBody(SecCompType type,
+    const std::string& componentInfo, int32_t& scId)
+{
+    StartTrace(HITRACE_TAG_ACCESS_CONTROL, "SecurityComponentRegister");
+    SecCompCallerInfo caller;
+    if (!GetRegisterCallerInfo(caller)) {
         FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
-    nlohmann::json jsonRes = nlohmann::json::parse(componentInfo, nullptr, false);
-    if (jsonRes.is_discarded()) {
-        SC_LOG_ERROR(LABEL, "component info invalid %{public}s", componentInfo.c_str());
+    SecCompInfoPayload infoRes;
+    if (ParseComponentInfo(componentInfo, infoRes) != SC_OK) {
         FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
 
-    int32_t res = SecCompManager::GetInstance().RegisterSecurityComponent(type, jsonRes, caller, scId);
+    int32_t res = SecCompManager::GetInstance().RegisterSecurityComponent(type, infoRes, caller, scId);
     FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
     if (res != SC_OK) {
         return res;
     }
-
-    OHOS::AppExecFwk::BundleMgrClient bmsClient;
-    std::string bundleName = "";
-    int32_t ret = bmsClient.GetNameForUid(caller.uid, bundleName);
-    if (ret != SC_OK) {
-        SC_LOG_ERROR(LABEL, "Failed to get bundle name, uid=%{public}d, ret=%{public}d", caller.uid, ret);
-        return res;
-    }
-
-    AppExecFwk::BundleInfo bundleInfo;
-    if (bmsClient.GetBundleInfo(
-        bundleName, AppExecFwk::BundleFlag::GET_BUNDLE_DEFAULT, bundleInfo, caller.userId) != SC_OK) {
-        SC_LOG_ERROR(LABEL, "Failed to get bundle info for bundle name %{public}s", bundleName.c_str());
-        return res;
-    }
-
-    HiSysEventWrite(HiviewDFX::HiSysEvent::Domain::SEC_COMPONENT, "REGISTER_SUCCESS",
-        HiviewDFX::HiSysEvent::EventType::BEHAVIOR, "CALLER_UID", caller.uid,
-        "CALLER_PID", IPCSkeleton::GetCallingRealPid(), "CALLER_BUNDLE_NAME", bundleName, "CALLER_BUNDLE_VERSION",
-        bundleInfo.versionName, "SC_ID", scId, "SC_TYPE", type);
+    ReportRegisterSuccess(caller, scId, type);
     return res;
 }
 
 int32_t SecCompService::RegisterWriteToRawdata(int32_t res, int32_t scId, SecCompRawdata& rawReply)
 {
-    MessageParcel replyParcel;
-    if (!replyParcel.WriteInt32(res)) {
+    std::shared_ptr<MessageParcel> replyParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!replyParcel->WriteInt32(res)) {
         SC_LOG_ERROR(LABEL, "Register security component result failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
-    if (!replyParcel.WriteInt32(scId)) {
+    if (!replyParcel->WriteInt32(scId)) {
         SC_LOG_ERROR(LABEL, "Register security component result failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
@@ -310,6 +418,8 @@ int32_t SecCompService::RegisterWriteToRawdata(int32_t res, int32_t scId, SecCom
 
 int32_t SecCompService::RegisterSecurityComponent(const SecCompRawdata& rawData, SecCompRawdata& rawReply)
 {
+    DrainUpdateChannel();
+    LatencyOperationScope latencyScope(LATENCY_OP_REGISTER);
     SecCompType type;
     std::string componentInfo;
     int32_t res;
@@ -335,6 +445,117 @@ int32_t SecCompService::RegisterSecurityComponent(const SecCompRawdata& rawData,
     return SC_OK;
 }
 
+int32_t SecCompService::RegisterBatchReadFromRawdata(SecCompRawdata& rawData,
+    std::vector<SecCompRegisterItem>& items)
+{
+    MessageParcel deserializedData;
+    if (!SecCompEnhanceAdapter::EnhanceSrvDeserialize(rawData, deserializedData)) {
+        SC_LOG_ERROR(LABEL, "Batch register deserialize session info failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    uint32_t num = 0;
+    if (!deserializedData.ReadUint32(num)) {
+        SC_LOG_ERROR(LABEL, "Batch register read component num failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    if ((num == 0) || (num > SC_BATCH_MAX_NUM)) {
+        SC_LOG_ERROR(LABEL, "Batch register component num %{public}u invalid", num);
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+
+    items.resize(num);
+    for (auto& item : items) {
+        uint32_t uintType;
+        if (!deserializedData.ReadUint32(uintType) || !deserializedData.ReadString(item.componentInfo)) {
+            SC_LOG_ERROR(LABEL, "Batch register read component failed");
+            return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+        }
+        // an invalid item only fails itself
+        item.type = static_cast<SecCompType>(uintType);
+        item.result = IsComponentTypeValid(static_cast<int32_t>(uintType)) ? SC_OK : SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+    return SC_OK;
+}
+
+int32_t SecCompService::RegisterSecurityComponentsBody(std::vector<SecCompRegisterItem>& items)
+{
+    StartTrace(HITRACE_TAG_ACCESS_CONTROL, "SecurityComponentBatchRegister");
+    SecCompCallerInfo caller;
+    if (!GetRegisterCallerInfo(caller)) {
+        FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+    std::vector<SecCompInfoPayload> infos(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        if ((items[i].result == SC_OK) && (ParseComponentInfo(items[i].componentInfo, infos[i]) != SC_OK)) {
+            items[i].result = SC_SERVICE_ERROR_VALUE_INVALID;
+        }
+    }
+
+    int32_t res = SecCompManager::GetInstance().RegisterSecurityComponents(items, infos, caller);
+    FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
+    if (res != SC_OK) {
+        return res;
+    }
+    for (const auto& item : items) {
+        if (item.result == SC_OK) {
+            ReportRegisterSuccess(caller, item.scId, item.type);
+        }
+    }
+    return res;
+}
+
+int32_t SecCompService::RegisterBatchWriteToRawdata(int32_t res, const std::vector<SecCompRegisterItem>& items,
+    SecCompRawdata& rawReply)
+{
+    std::shared_ptr<MessageParcel> replyParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!replyParcel->WriteInt32(res) || !replyParcel->WriteUint32(static_cast<uint32_t>(items.size()))) {
+        SC_LOG_ERROR(LABEL, "Batch register security component result failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    for (const auto& item : items) {
+        if (!replyParcel->WriteInt32(item.result) || !replyParcel->WriteInt32(item.scId)) {
+            SC_LOG_ERROR(LABEL, "Batch register security component item failed");
+            return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+        }
+    }
+
+    if (!SecCompEnhanceAdapter::EnhanceSrvSerialize(replyParcel, rawReply)) {
+        SC_LOG_ERROR(LABEL, "Batch register serialize session info failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    return SC_OK;
+}
+
+int32_t SecCompService::RegisterSecurityComponents(const SecCompRawdata& rawData, SecCompRawdata& rawReply)
+{
+    DrainUpdateChannel();
+    LatencyOperationScope latencyScope(LATENCY_OP_BATCH_REGISTER);
+    std::vector<SecCompRegisterItem> items;
+    int32_t res;
+    do {
+        res = RegisterBatchReadFromRawdata(const_cast<SecCompRawdata&>(rawData), items);
+        if (res != SC_OK) {
+            break;
+        }
+
+        res = RegisterSecurityComponentsBody(items);
+        if (res != SC_OK) {
+            break;
+        }
+        res = RegisterBatchWriteToRawdata(res, items, rawReply);
+    } while (0);
+    if (res != SC_OK) {
+        if (WriteError(res, rawReply) != SC_OK) {
+            SC_LOG_ERROR(LABEL, "Write rawReply error.");
+            return res;
+        }
+    }
+    return SC_OK;
+}
+
 int32_t SecCompService::UpdateReadFromRawdata(SecCompRawdata& rawData, int32_t& scId, std::string& componentInfo)
 {
     MessageParcel deserializedData;
@@ -360,24 +581,44 @@ int32_t SecCompService::UpdateReadFromRawdata(SecCompRawdata& rawData, int32_t&
     return SC_OK;
 }
 
-int32_t SecCompService::UpdateSecurityComponentBody(int32_t scId, const std::string& componentInfo)
+int32_t SecCompService::UpdateSecurityComponentBody(int32_t scId, const std::string& componentInfo,
+    uint32_t& version)
 {
     SecCompCallerInfo caller;
-    nlohmann::json jsonRes;
-    if (ParseParams(componentInfo, caller, jsonRes) != SC_OK) {
+    SecCompInfoPayload infoRes;
+    if (ParseParams(componentInfo, caller, infoRes) != SC_OK) {
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+    return UpdateParsedComponent(scId, infoRes, caller, version);
+}
+
+int32_t SecCompService::UpdateParsedComponent(int32_t scId, const SecCompInfoPayload& info,
+    const SecCompCallerInfo& caller, uint32_t& version)
+{
+    if (!info.isDelta) {
+        return SecCompManager::GetInstance().UpdateSecurityComponent(scId, info, caller, version);
+    }
+    if (NegotiateInfoVersion(SC_INFO_VERSION_DELTA) != SC_INFO_VERSION_DELTA) {
+        SC_LOG_ERROR(LABEL, "delta component info is not accepted");
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
-    return SecCompManager::GetInstance().UpdateSecurityComponent(scId, jsonRes, caller);
+    return SecCompManager::GetInstance().UpdateSecurityComponentDelta(scId, info.json, caller, version);
 }
 
-int32_t SecCompService::UpdateWriteToRawdata(int32_t res, SecCompRawdata& rawReply)
+int32_t SecCompService::UpdateWriteToRawdata(int32_t res, uint32_t version, SecCompRawdata& rawReply)
 {
-    MessageParcel replyParcel;
-    if (!replyParcel.WriteInt32(res)) {
+    std::shared_ptr<MessageParcel> replyParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!replyParcel->WriteInt32(res)) {
         SC_LOG_ERROR(LABEL, "Update security component result failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
+    // base version of the next delta, old clients stop reading after the result
+    if (!replyParcel->WriteUint32(version)) {
+        SC_LOG_ERROR(LABEL, "Update security component version failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
     if (!SecCompEnhanceAdapter::EnhanceSrvSerialize(replyParcel, rawReply)) {
         SC_LOG_ERROR(LABEL, "Update serialize session info failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
@@ -387,19 +628,26 @@ int32_t SecCompService::UpdateWriteToRawdata(int32_t res, SecCompRawdata& rawRep
 
 int32_t SecCompService::UpdateSecurityComponent(const SecCompRawdata& rawData, SecCompRawdata& rawReply)
 {
+    DrainUpdateChannel();
+    LatencyOperationScope latencyScope(LATENCY_OP_UPDATE);
     int32_t scId;
     std::string componentInfo;
+    uint32_t version = 0;
     int32_t res;
     do {
         res = UpdateReadFromRawdata(const_cast<SecCompRawdata&>(rawData), scId, componentInfo);
         if (res != SC_OK) {
             break;
         }
-        res = UpdateSecurityComponentBody(scId, componentInfo);
+        res = TakeUpdateChannelResult(scId);
         if (res != SC_OK) {
             break;
         }
-        res = UpdateWriteToRawdata(res, rawReply);
+        res = UpdateSecurityComponentBody(scId, componentInfo, version);
+        if (res != SC_OK) {
+            break;
+        }
+        res = UpdateWriteToRawdata(res, version, rawReply);
     } while (0);
     if (res != SC_OK) {
         if (WriteError(res, rawReply) != SC_OK) {
@@ -442,8 +690,8 @@ int32_t SecCompService::UnregisterSecurityComponentBody(int32_t scId)
 
 int32_t SecCompService::UnregisterWriteToRawdata(int32_t res, SecCompRawdata& rawReply)
 {
-    MessageParcel replyParcel;
-    if (!replyParcel.WriteInt32(res)) {
+    std::shared_ptr<MessageParcel> replyParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!replyParcel->WriteInt32(res)) {
         SC_LOG_ERROR(LABEL, "Unregister security component result failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
@@ -457,6 +705,8 @@ int32_t SecCompService::UnregisterWriteToRawdata(int32_t res, SecCompRawdata& ra
 
 int32_t SecCompService::UnregisterSecurityComponent(const SecCompRawdata& rawData, SecCompRawdata& rawReply)
 {
+    DrainUpdateChannel();
+    LatencyOperationScope latencyScope(LATENCY_OP_UNREGISTER);
     int32_t scId;
     int32_t res;
     do {
@@ -480,19 +730,111 @@ int32_t SecCompService::UnregisterSecurityComponent(const SecCompRawdata& rawDat
     return SC_OK;
 }
 
+int32_t SecCompService::UnregisterBatchReadFromRawdata(SecCompRawdata& rawData, std::vector<int32_t>& scIds)
+{
+    MessageParcel deserializedData;
+    if (!SecCompEnhanceAdapter::EnhanceSrvDeserialize(rawData, deserializedData)) {
+        SC_LOG_ERROR(LABEL, "Batch unregister deserialize session info failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    uint32_t num = 0;
+    if (!deserializedData.ReadUint32(num)) {
+        SC_LOG_ERROR(LABEL, "Batch unregister read component num failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    if ((num == 0) || (num > SC_BATCH_MAX_NUM)) {
+        SC_LOG_ERROR(LABEL, "Batch unregister component num %{public}u invalid", num);
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+
+    scIds.resize(num);
+    for (auto& scId : scIds) {
+        if (!deserializedData.ReadInt32(scId)) {
+            SC_LOG_ERROR(LABEL, "Batch unregister read component id failed");
+            return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+        }
+    }
+    return SC_OK;
+}
+
+int32_t SecCompService::UnregisterSecurityComponentsBody(const std::vector<int32_t>& scIds,
+    std::vector<int32_t>& results)
+{
+    SecCompCallerInfo caller;
+    caller.tokenId = IPCSkeleton::GetCallingTokenID();
+    caller.pid = IPCSkeleton::GetCallingPid();
+    caller.uid = IPCSkeleton::GetCallingUid();
+    caller.userId = caller.uid / BASE_USER_RANGE;
+
+    SecCompManager::GetInstance().UnregisterSecurityComponents(scIds, caller, results);
+    return SC_OK;
+}
+
+int32_t SecCompService::UnregisterBatchWriteToRawdata(int32_t res, const std::vector<int32_t>& results,
+    SecCompRawdata& rawReply)
+{
+    std::shared_ptr<MessageParcel> replyParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!replyParcel->WriteInt32(res) || !replyParcel->WriteUint32(static_cast<uint32_t>(results.size()))) {
+        SC_LOG_ERROR(LABEL, "Batch unregister security component result failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    for (int32_t result : results) {
+        if (!replyParcel->WriteInt32(result)) {
+            SC_LOG_ERROR(LABEL, "Batch unregister security component item failed");
+            return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+        }
+    }
+
+    if (!SecCompEnhanceAdapter::EnhanceSrvSerialize(replyParcel, rawReply)) {
+        SC_LOG_ERROR(LABEL, "Batch unregister serialize session info failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+    return SC_OK;
+}
+
+int32_t SecCompService::UnregisterSecurityComponents(const SecCompRawdata& rawData, SecCompRawdata& rawReply)
+{
+    DrainUpdateChannel();
+    LatencyOperationScope latencyScope(LATENCY_OP_BATCH_UNREGISTER);
+    std::vector<int32_t> scIds;
+    std::vector<int32_t> results;
+    int32_t res;
+    do {
+        res = UnregisterBatchReadFromRawdata(const_cast<SecCompRawdata&>(rawData), scIds);
+        if (res != SC_OK) {
+            break;
+        }
+
+        res = UnregisterSecurityComponentsBody(scIds, results);
+        if (res != SC_OK) {
+            break;
+        }
+        res = UnregisterBatchWriteToRawdata(res, results, rawReply);
+    } while (0);
+    if (res != SC_OK) {
+        if (WriteError(res, rawReply) != SC_OK) {
+            SC_LOG_ERROR(LABEL, "Write rawReply error.");
+            return res;
+        }
+    }
+    return SC_OK;
+}
+
 int32_t SecCompService::ReportSecurityComponentClickEventBody(SecCompInfo& secCompInfo,
     sptr<IRemoteObject> callerToken, sptr<IRemoteObject> dialogCallback, std::string& message)
 {
     StartTrace(HITRACE_TAG_ACCESS_CONTROL, "SecurityComponentClick");
     SecCompCallerInfo caller;
-    nlohmann::json jsonRes;
-    if (ParseParams(secCompInfo.componentInfo, caller, jsonRes) != SC_OK) {
+    SecCompInfoPayload infoRes;
+    if (ParseParams(secCompInfo.componentInfo, caller, infoRes) != SC_OK) {
         FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
         return SC_SERVICE_ERROR_VALUE_INVALID;
     }
     std::vector<sptr<IRemoteObject>> remoteArr = { callerToken, dialogCallback };
     int32_t res =
-        SecCompManager::GetInstance().ReportSecurityComponentClickEvent(secCompInfo, jsonRes, caller, remoteArr,
+        SecCompManager::GetInstance().ReportSecurityComponentClickEvent(secCompInfo, infoRes, caller, remoteArr,
         message);
     FinishTrace(HITRACE_TAG_ACCESS_CONTROL);
     return res;
@@ -500,13 +842,13 @@ int32_t SecCompService::ReportSecurityComponentClickEventBody(SecCompInfo& secCo
 
 int32_t SecCompService::ReportWriteToRawdata(int32_t res, std::string message, SecCompRawdata& rawReply)
 {
-    MessageParcel replyParcel;
-    if (!replyParcel.WriteInt32(res)) {
+    std::shared_ptr<MessageParcel> replyParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!replyParcel->WriteInt32(res)) {
         SC_LOG_ERROR(LABEL, "Report security component result failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
-    if (!replyParcel.WriteString(message)) {
+    if (!replyParcel->WriteString(message)) {
         SC_LOG_ERROR(LABEL, "Report security component error message failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
@@ -522,6 +864,9 @@ int32_t SecCompService::ReportWriteToRawdata(int32_t res, std::string message, S
 int32_t SecCompService::ReportSecurityComponentClickEvent(const sptr<IRemoteObject>& callerToken,
     const sptr<IRemoteObject>& dialogCallback, const SecCompRawdata& rawData, SecCompRawdata& rawReply)
 {
+    // the click is checked against the latest info, including updates still pending in the ring
+    DrainUpdateChannel();
+    LatencyOperationScope latencyScope(LATENCY_OP_CLICK);
     int32_t res;
     do {
         MessageParcel deserializedData;
@@ -564,7 +909,10 @@ int32_t SecCompService::ReportSecurityComponentClickEvent(const sptr<IRemoteObje
         }
 
         SecCompInfo secCompInfo{ scId, componentInfo, clickInfoParcel->clickInfoParams_ };
-        res = ReportSecurityComponentClickEventBody(secCompInfo, callerToken, dialogCallback, message);
+        res = TakeUpdateChannelResult(scId);
+        if (res == SC_OK) {
+            res = ReportSecurityComponentClickEventBody(secCompInfo, callerToken, dialogCallback, message);
+        }
         res = ReportWriteToRawdata(res, message, rawReply);
     } while (0);
     if (res != SC_OK) {
@@ -576,13 +924,18 @@ int32_t SecCompService::ReportSecurityComponentClickEvent(const sptr<IRemoteObje
     return SC_OK;
 }
 
-int32_t SecCompService::PreRegisterReadFromRawdata(SecCompRawdata& rawData)
+int32_t SecCompService::PreRegisterReadFromRawdata(SecCompRawdata& rawData, uint32_t& infoVersion)
 {
     MessageParcel deserializedData;
     if (!SecCompEnhanceAdapter::EnhanceSrvDeserialize(rawData, deserializedData)) {
         SC_LOG_ERROR(LABEL, "preRegister deserialize session info failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
+
+    // old clients send nothing and only know json
+    if (!deserializedData.ReadUint32(infoVersion)) {
+        infoVersion = SC_INFO_VERSION_JSON;
+    }
     return SC_OK;
 }
 
@@ -596,14 +949,24 @@ int32_t SecCompService::PreRegisterSecCompProcessBody()
     return SecCompManager::GetInstance().AddSecurityComponentProcess(caller);
 }
 
-int32_t SecCompService::PreRegisterWriteToRawdata(int32_t res, SecCompRawdata& rawReply)
+int32_t SecCompService::PreRegisterWriteToRawdata(int32_t res, uint32_t infoVersion, SecCompRawdata& rawReply)
 {
-    MessageParcel replyParcel;
-    if (!replyParcel.WriteInt32(res)) {
+    std::shared_ptr<MessageParcel> replyParcel = SecCompEnhanceAdapter::AcquireParcel();
+    if (!replyParcel->WriteInt32(res)) {
         SC_LOG_ERROR(LABEL, "preRegister write result failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
     }
 
+    if (!replyParcel->WriteUint32(infoVersion)) {
+        SC_LOG_ERROR(LABEL, "preRegister write info version failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
+    if (!replyParcel->WriteUint32(NegotiateUpdateChannel())) {
+        SC_LOG_ERROR(LABEL, "preRegister write update channel failed");
+        return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
+    }
+
     if (!SecCompEnhanceAdapter::EnhanceSrvSerialize(replyParcel, rawReply)) {
         SC_LOG_ERROR(LABEL, "preRegister serialize session info failed");
         return SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL;
@@ -614,8 +977,9 @@ int32_t SecCompService::PreRegisterWriteToRawdata(int32_t res, SecCompRawdata& r
 int32_t SecCompService::PreRegisterSecCompProcess(const SecCompRawdata& rawData, SecCompRawdata& rawReply)
 {
     int32_t res;
+    uint32_t infoVersion = SC_INFO_VERSION_JSON;
     do {
-        res = PreRegisterReadFromRawdata(const_cast<SecCompRawdata&>(rawData));
+        res = PreRegisterReadFromRawdata(const_cast<SecCompRawdata&>(rawData), infoVersion);
         if (res != SC_OK) {
             break;
         }
@@ -624,7 +988,7 @@ int32_t SecCompService::PreRegisterSecCompProcess(const SecCompRawdata& rawData,
         if (res != SC_OK) {
             break;
         }
-        res = PreRegisterWriteToRawdata(res, rawReply);
+        res = PreRegisterWriteToRawdata(res, NegotiateInfoVersion(infoVersion), rawReply);
     } while (0);
     if (res != SC_OK) {
         if (WriteError(res, rawReply) != SC_OK) {
@@ -635,6 +999,69 @@ int32_t SecCompService::PreRegisterSecCompProcess(const SecCompRawdata& rawData,
     return SC_OK;
 }
 
+int32_t SecCompService::SetupUpdateChannel(int fd)
+{
+    int32_t res = SC_SERVICE_ERROR_VALUE_INVALID;
+    SecCompCallerInfo caller;
+    if ((NegotiateUpdateChannel() & SC_CHANNEL_UPDATE_RING) == 0) {
+        SC_LOG_ERROR(LABEL, "Update channel is not offered");
+    } else if (!GetCallerInfo(caller)) {
+        SC_LOG_ERROR(LABEL, "Check caller failed");
+    } else {
+        res = SecCompUpdateChannel::GetInstance().Setup(caller, fd);
+    }
+    // the region stays mapped after fd is closed
+    if (fd >= 0) {
+        close(fd);
+    }
+    return res;
+}
+
+int32_t SecCompService::NotifyUpdateChannel()
+{
+    // oneway call carries no pid, channels of the calling uid are drained with the caller kept at setup
+    SecCompUpdateChannel::GetInstance().Notify(IPCSkeleton::GetCallingUid());
+    return SC_OK;
+}
+
+void SecCompService::DrainUpdateChannel()
+{
+    SecCompUpdateChannel::GetInstance().Drain(IPCSkeleton::GetCallingPid());
+}
+
+int32_t SecCompService::TakeUpdateChannelResult(int32_t scId)
+{
+    int32_t res = SecCompUpdateChannel::GetInstance().TakeFailedResult(IPCSkeleton::GetCallingPid(), scId);
+    if (res != SC_OK) {
+        SC_LOG_ERROR(LABEL, "Last update of %{public}d from channel failed, result: %{public}d", scId, res);
+    }
+    return res;
+}
+
+int32_t SecCompService::ApplyUpdateRecord(const SecCompCallerInfo& caller, const SecCompUpdateRecord& record,
+    const UpdateRecordBase* base, uint32_t& version)
+{
+    LatencyOperationScope latencyScope(LATENCY_OP_UPDATE);
+    if ((caller.uid != ROOT_UID) && (!appStateObserver_->IsProcessForeground(caller.pid, caller.uid))) {
+        SC_LOG_ERROR(LABEL, "caller pid is not in foreground");
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+    SecCompInfoPayload infoRes;
+    if (ParseComponentInfo(record.payload, infoRes) != SC_OK) {
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+    // a delta in the ring is built on the last ring record of the component, it names that record by seq
+    if (infoRes.isDelta) {
+        nlohmann::json& baseSeq = infoRes.json[JsonTagConstants::JSON_BASE_VERSION_TAG];
+        if ((base == nullptr) || !baseSeq.is_number_unsigned() || (baseSeq.get<uint32_t>() != base->seq)) {
+            SC_LOG_ERROR(LABEL, "Update delta from channel has no base");
+            return SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL;
+        }
+        baseSeq = base->version;
+    }
+    return UpdateParsedComponent(record.scId, infoRes, caller, version);
+}
+
 int32_t SecCompService::VerifySavePermission(AccessToken::AccessTokenID tokenId, bool& isGranted)
 {
     if (!IsMediaLibraryCalling()) {
@@ -679,14 +1106,25 @@ int SecCompService::Dump(int fd, const std::vector<std::u16string>& args)
         dprintf(fd, "       -h: command help\n");
         dprintf(fd, "       -a: dump all sec component\n");
         dprintf(fd, "       -p: dump foreground processes\n");
+        dprintf(fd, "       -t: dump startup phases and latency of each stage of register, update, click, "
+            "unregister and batch register/unregister\n");
+        dprintf(fd, "       -r: reset latency statistics\n");
     } else if (arg0.compare("-p") == 0) {
         std::string dumpStr;
         std::unique_lock<std::mutex> lock(secCompSrvMutex_);
         appStateObserver_->DumpProcess(dumpStr);
         dprintf(fd, "%s\n", dumpStr.c_str());
+    } else if (arg0.compare("-t") == 0) {
+        std::string dumpStr;
+        SecCompLatencyStats::GetInstance().Dump(dumpStr);
+        dprintf(fd, "%s\n", dumpStr.c_str());
+    } else if (arg0.compare("-r") == 0) {
+        SecCompLatencyStats::GetInstance().Reset();
+        dprintf(fd, "latency statistics reset\n");
     }  else if (arg0.compare("-a") == 0 || arg0 == "") {
         std::string dumpStr;
         SecCompManager::GetInstance().DumpSecComp(dumpStr);
+        SecCompBundleInfoCache::GetInstance().DumpBundleInfoCache(dumpStr);
         dprintf(fd, "%s\n", dumpStr.c_str());
     }
     return ERR_OK;
@@ -696,12 +1134,16 @@ int SecCompService::Dump(int fd, const std::vector<std::u16string>& args)
 void SecCompService::OnAddSystemAbility(int32_t systemAbilityId, const std::string& deviceId)
 {
     SC_LOG_ERROR(LABEL, "Accessibility service is started");
-    SecCompEnhanceAdapter::EnableInputEnhance();
+    SecCompManager::GetInstance().EnableInputEnhance();
 }
 #endif
 
-bool SecCompService::Initialize() const
+bool SecCompService::Initialize()
 {
+    SecCompUpdateChannel::GetInstance().SetRecordHandler([this](const SecCompCallerInfo& caller,
+        const SecCompUpdateRecord& record, const UpdateRecordBase* base, uint32_t& version) {
+        return this->ApplyUpdateRecord(caller, record, base, version);
+    });
     return SecCompManager::GetInstance().Initialize();
 }
 }  // namespace SecurityComponent
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -27,6 +27,7 @@
 #include "sec_comp_info.h"
 #include "sec_comp_manager.h"
 #include "sec_comp_service_stub.h"
+#include "sec_comp_update_channel.h"
 #include "security_component_service_ipc_interface_code.h"
 #include "singleton.h"
 #include "system_ability.h"
@@ -52,6 +53,10 @@ public:
         const sptr<IRemoteObject>& dialogCallback, const SecCompRawdata& rawData, SecCompRawdata& rawReply) override;
     int32_t VerifySavePermission(AccessToken::AccessTokenID tokenId, bool& isGranted) override;
     int32_t PreRegisterSecCompProcess(const SecCompRawdata& rawData, SecCompRawdata& rawReply) override;
+    int32_t RegisterSecurityComponents(const SecCompRawdata& rawData, SecCompRawdata& rawReply) override;
+    int32_t UnregisterSecurityComponents(const SecCompRawdata& rawData, SecCompRawdata& rawReply) override;
+    int32_t SetupUpdateChannel(int fd) override;
+    int32_t NotifyUpdateChannel() override;
 
     int Dump(int fd, const std::vector<std::u16string>& args) override;
 #if (!defined (TDD_ENABLE)) && (!defined (FUZZ_ENABLE))
@@ -63,21 +68,39 @@ private:
     int32_t RegisterReadFromRawdata(SecCompRawdata& rawData, SecCompType& type, std::string& componentInfo);
     int32_t RegisterSecurityComponentBody(SecCompType type, const std::string& componentInfo, int32_t& scId);
     int32_t RegisterWriteToRawdata(int32_t res, int32_t scId, SecCompRawdata& rawReply);
+    int32_t RegisterBatchReadFromRawdata(SecCompRawdata& rawData, std::vector<SecCompRegisterItem>& items);
+    int32_t RegisterSecurityComponentsBody(std::vector<SecCompRegisterItem>& items);
+    int32_t RegisterBatchWriteToRawdata(int32_t res, const std::vector<SecCompRegisterItem>& items,
+        SecCompRawdata& rawReply);
+    bool GetRegisterCallerInfo(SecCompCallerInfo& caller);
+    void ReportRegisterSuccess(const SecCompCallerInfo& caller, int32_t scId, SecCompType type);
     int32_t UpdateReadFromRawdata(SecCompRawdata& rawData, int32_t& scId, std::string& componentInfo);
-    int32_t UpdateSecurityComponentBody(int32_t scId, const std::string& componentInfo);
-    int32_t UpdateWriteToRawdata(int32_t res, SecCompRawdata& rawReply);
+    int32_t UpdateSecurityComponentBody(int32_t scId, const std::string& componentInfo, uint32_t& version);
+    int32_t UpdateParsedComponent(int32_t scId, const SecCompInfoPayload& info, const SecCompCallerInfo& caller,
+        uint32_t& version);
+    int32_t UpdateWriteToRawdata(int32_t res, uint32_t version, SecCompRawdata& rawReply);
     int32_t UnregisterReadFromRawdata(SecCompRawdata& rawData, int32_t& scId);
     int32_t UnregisterSecurityComponentBody(int32_t scId);
     int32_t UnregisterWriteToRawdata(int32_t res, SecCompRawdata& rawReply);
+    int32_t UnregisterBatchReadFromRawdata(SecCompRawdata& rawData, std::vector<int32_t>& scIds);
+    int32_t UnregisterSecurityComponentsBody(const std::vector<int32_t>& scIds, std::vector<int32_t>& results);
+    int32_t UnregisterBatchWriteToRawdata(int32_t res, const std::vector<int32_t>& results, SecCompRawdata& rawReply);
     int32_t ReportSecurityComponentClickEventBody(SecCompInfo& secCompInfo,
         sptr<IRemoteObject> callerToken, sptr<IRemoteObject> dialogCallback, std::string& message);
     int32_t ReportWriteToRawdata(int32_t res, std::string message, SecCompRawdata& rawReply);
-    int32_t PreRegisterReadFromRawdata(SecCompRawdata& rawData);
+    int32_t PreRegisterReadFromRawdata(SecCompRawdata& rawData, uint32_t& infoVersion);
     int32_t PreRegisterSecCompProcessBody();
-    int32_t PreRegisterWriteToRawdata(int32_t res, SecCompRawdata& rawReply);
-    int32_t ParseParams(const std::string& componentInfo, SecCompCallerInfo& caller, nlohmann::json& jsonRes);
-    bool Initialize() const;
+    int32_t PreRegisterWriteToRawdata(int32_t res, uint32_t infoVersion, SecCompRawdata& rawReply);
+    void DrainUpdateChannel();
+    int32_t TakeUpdateChannelResult(int32_t scId);
+    int32_t ApplyUpdateRecord(const SecCompCallerInfo& caller, const SecCompUpdateRecord& record,
+        const UpdateRecordBase* base, uint32_t& version);
+    int32_t ParseParams(const std::string& componentInfo, SecCompCallerInfo& caller, SecCompInfoPayload& infoRes);
+    // binary info is viewed in componentInfo, which must outlive infoRes
+    int32_t ParseComponentInfo(const std::string& componentInfo, SecCompInfoPayload& infoRes);
+    bool Initialize();
     bool RegisterAppStateObserver();
+    void ReportServiceInitSuccess() const;
     void UnregisterAppStateObserver();
     bool GetCallerInfo(SecCompCallerInfo& caller);
     bool IsMediaLibraryCalling();
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sec_comp_update_channel.h"
+
+#include <string>
+#include <vector>
+#include "sec_comp_err.h"
+#include "sec_comp_log.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompUpdateChannel"};
+static constexpr size_t MAX_UPDATE_CHANNEL_NUM = 128;
+// components tracked by one channel, a process holds at most 500 of them at a time
+static constexpr size_t MAX_CHANNEL_COMPONENT_NUM = 512;
+// consumer stays busy this long after its last record, updates of one animation need one doorbell
+static constexpr int64_t UPDATE_CHANNEL_LINGER_MILLISECONDS = 50;
+static const std::string UPDATE_CHANNEL_LINGER_TASK_PREFIX = "UpdateChannelLinger_";
+static std::mutex g_instanceMutex;
+}
+
+SecCompUpdateChannel& SecCompUpdateChannel::GetInstance()
+{
+    static SecCompUpdateChannel* instance = nullptr;
+    if (instance == nullptr) {
+        std::lock_guard<std::mutex> lock(g_instanceMutex);
+        if (instance == nullptr) {
+            instance = new SecCompUpdateChannel();
+        }
+    }
+    return *instance;
+}
+
+void SecCompUpdateChannel::InitEventHandler(const std::shared_ptr<SecEventHandler>& secHandler)
+{
+    secHandler_ = secHandler;
+}
+
+void SecCompUpdateChannel::SetRecordHandler(const UpdateRecordHandler& handler)
+{
+    recordHandler_ = handler;
+}
+
+int32_t SecCompUpdateChannel::Setup(const SecCompCallerInfo& caller, int32_t fd)
+{
+    auto channel = std::make_shared<ProcessChannel>();
+    channel->ring = SecCompUpdateRing::AttachConsumer(fd);
+    if (channel->ring == nullptr) {
+        SC_LOG_ERROR(LABEL, "Attach update ring failed, pid %{public}d", caller.pid);
+        return SC_SERVICE_ERROR_VALUE_INVALID;
+    }
+    channel->caller = caller;
+
+    std::lock_guard<std::mutex> lock(channelLock_);
+    if ((channelMap_.find(caller.pid) == channelMap_.end()) && (channelMap_.size() >= MAX_UPDATE_CHANNEL_NUM)) {
+        SC_LOG_ERROR(LABEL, "Update channel num is over limit");
+        return SC_SERVICE_ERROR_MEMORY_OPERATE_FAIL;
+    }
+    channelMap_[caller.pid] = channel;
+    SC_LOG_INFO(LABEL, "Setup update channel, pid %{public}d", caller.pid);
+    return SC_OK;
+}
+
+std::shared_ptr<SecCompUpdateChannel::ProcessChannel> SecCompUpdateChannel::FindChannel(int32_t pid)
+{
+    std::lock_guard<std::mutex> lock(channelLock_);
+    auto iter = channelMap_.find(pid);
+    if (iter == channelMap_.end()) {
+        return nullptr;
+    }
+    return iter->second;
+}
+
+bool SecCompUpdateChannel::DrainLocked(ProcessChannel& channel)
+{
+    if (channel.isCorrupted) {
+        return false;
+    }
+    bool isPopped = false;
+    SecCompUpdateRecord record;
+    UpdateRingStatus status;
+    while ((status = channel.ring->Pop(record)) == UpdateRingStatus::RING_OK) {
+        isPopped = true;
+        auto baseIter = channel.baseMap.find(record.scId);
+        const UpdateRecordBase* base = (baseIter != channel.baseMap.end()) ? &baseIter->second : nullptr;
+        uint32_t version = 0;
+        int32_t res = (recordHandler_ != nullptr) ?
+            recordHandler_(channel.caller, record, base, version) : SC_SERVICE_ERROR_SERVICE_NOT_EXIST;
+        if (res == SC_OK) {
+            channel.failedMap.erase(record.scId);
+            if ((baseIter != channel.baseMap.end()) || (channel.baseMap.size() < MAX_CHANNEL_COMPONENT_NUM)) {
+                channel.baseMap[record.scId] = { record.seq, version };
+            }
+            continue;
+        }
+        SC_LOG_ERROR(LABEL, "Update %{public}d from channel failed, result: %{public}d", record.scId, res);
+        // the delta chain of the component is broken, the producer sends full info after seeing the failure
+        channel.baseMap.erase(record.scId);
+        if ((channel.failedMap.find(record.scId) != channel.failedMap.end()) ||
+            (channel.failedMap.size() < MAX_CHANNEL_COMPONENT_NUM)) {
+            channel.failedMap[record.scId] = res;
+        }
+        channel.ring->AddFailedNum();
+    }
+    // the ring is closed to the producer, records queued in it are lost
+    if (status == UpdateRingStatus::RING_CORRUPTED) {
+        channel.isCorrupted = true;
+    }
+    return isPopped;
+}
+
+void SecCompUpdateChannel::Drain(int32_t pid)
+{
+    std::shared_ptr<ProcessChannel> channel = FindChannel(pid);
+    if (channel == nullptr) {
+        return;
+    }
+    // records are applied in the order they were pushed, the idle state is left to the doorbell path
+    std::lock_guard<std::mutex> drainLock(channel->drainLock);
+    DrainLocked(*channel);
+}
+
+void SecCompUpdateChannel::PostLingerLocked(ProcessChannel& channel)
+{
+    if (channel.isLingerPosted || channel.isCorrupted) {
+        return;
+    }
+    int32_t pid = channel.caller.pid;
+    std::function<void()> lingerTask = ([pid]() {
+        SecCompUpdateChannel::GetInstance().Linger(pid);
+    });
+    if ((secHandler_ != nullptr) && secHandler_->ProxyPostTask(lingerTask,
+        UPDATE_CHANNEL_LINGER_TASK_PREFIX + std::to_string(pid), UPDATE_CHANNEL_LINGER_MILLISECONDS)) {
+        channel.isLingerPosted = true;
+        return;
+    }
+    // no handler to come back later, go idle now and let the next push ring again
+    while (!channel.ring->MarkIdle()) {
+        DrainLocked(channel);
+    }
+}
+
+void SecCompUpdateChannel::Notify(int32_t uid)
+{
+    std::vector<std::shared_ptr<ProcessChannel>> channels;
+    {
+        std::lock_guard<std::mutex> lock(channelLock_);
+        for (const auto& iter : channelMap_) {
+            if (iter.second->caller.uid == uid) {
+                channels.emplace_back(iter.second);
+            }
+        }
+    }
+    for (const auto& channel : channels) {
+        std::lock_guard<std::mutex> drainLock(channel->drainLock);
+        DrainLocked(*channel);
+        PostLingerLocked(*channel);
+    }
+}
+
+void SecCompUpdateChannel::Linger(int32_t pid)
+{
+    std::shared_ptr<ProcessChannel> channel = FindChannel(pid);
+    if (channel == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> drainLock(channel->drainLock);
+    channel->isLingerPosted = false;
+    // records keep coming, the producer still sees a busy consumer and rings no doorbell
+    if (DrainLocked(*channel)) {
+        PostLingerLocked(*channel);
+        return;
+    }
+    if (!channel->ring->MarkIdle()) {
+        DrainLocked(*channel);
+        PostLingerLocked(*channel);
+    }
+}
+
+int32_t SecCompUpdateChannel::TakeFailedResult(int32_t pid, int32_t scId)
+{
+    std::shared_ptr<ProcessChannel> channel = FindChannel(pid);
+    if (channel == nullptr) {
+        return SC_OK;
+    }
+    std::lock_guard<std::mutex> drainLock(channel->drainLock);
+    auto iter = channel->failedMap.find(scId);
+    if (iter != channel->failedMap.end()) {
+        int32_t res = iter->second;
+        channel->failedMap.erase(iter);
+        return res;
+    }
+    // updates lost in a corrupted ring are unknown, each component updated through it fails once
+    if (channel->isCorrupted && (channel->baseMap.erase(scId) != 0)) {
+        return SC_SERVICE_ERROR_COMPONENT_INFO_INVALID;
+    }
+    return SC_OK;
+}
+
+void SecCompUpdateChannel::RemoveComponent(int32_t pid, int32_t scId)
+{
+    std::shared_ptr<ProcessChannel> channel = FindChannel(pid);
+    if (channel == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> drainLock(channel->drainLock);
+    channel->baseMap.erase(scId);
+    channel->failedMap.erase(scId);
+}
+
+void SecCompUpdateChannel::Close(int32_t pid)
+{
+    std::lock_guard<std::mutex> lock(channelLock_);
+    channelMap_.erase(pid);
+}
+
+void SecCompUpdateChannel::Clear()
+{
+    std::lock_guard<std::mutex> lock(channelLock_);
+    channelMap_.clear();
+}
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
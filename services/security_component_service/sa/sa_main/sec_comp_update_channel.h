@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SECURITY_COMPONENT_UPDATE_CHANNEL_H
+#define SECURITY_COMPONENT_UPDATE_CHANNEL_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "nocopyable.h"
+#include "sec_comp_manager.h"
+#include "sec_comp_update_ring.h"
+#include "sec_event_handler.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+// state of a component left by its last ring record, a delta in the ring is built on it
+struct UpdateRecordBase {
+    uint32_t seq = 0;
+    uint32_t version = 0;
+};
+
+// applies one record for the process which set the channel up, base is nullptr if the component has none
+using UpdateRecordHandler = std::function<int32_t(const SecCompCallerInfo& caller,
+    const SecCompUpdateRecord& record, const UpdateRecordBase* base, uint32_t& version)>;
+
+class SecCompUpdateChannel {
+public:
+    static SecCompUpdateChannel& GetInstance();
+    virtual ~SecCompUpdateChannel() = default;
+
+    void InitEventHandler(const std::shared_ptr<SecEventHandler>& secHandler);
+    void SetRecordHandler(const UpdateRecordHandler& handler);
+    int32_t Setup(const SecCompCallerInfo& caller, int32_t fd);
+    // pops every pending record of pid in order, called before a synchronous request of pid
+    void Drain(int32_t pid);
+    // doorbell of uid, channels keep draining for a while so that the following pushes need no doorbell
+    void Notify(int32_t uid);
+    // failed result of the last ring record of scId, reported once to the next synchronous request
+    int32_t TakeFailedResult(int32_t pid, int32_t scId);
+    void RemoveComponent(int32_t pid, int32_t scId);
+    void Close(int32_t pid);
+    void Clear();
+
+private:
+    struct ProcessChannel {
+        std::mutex drainLock;
+        std::unique_ptr<SecCompUpdateRing> ring;
+        // identity checked at setup, the oneway doorbell carries no pid
+        SecCompCallerInfo caller;
+        // fields below are guarded by drainLock
+        bool isLingerPosted = false;
+        bool isCorrupted = false;
+        std::unordered_map<int32_t, UpdateRecordBase> baseMap;
+        std::unordered_map<int32_t, int32_t> failedMap;
+    };
+
+    SecCompUpdateChannel() = default;
+    std::shared_ptr<ProcessChannel> FindChannel(int32_t pid);
+    bool DrainLocked(ProcessChannel& channel);
+    void PostLingerLocked(ProcessChannel& channel);
+    void Linger(int32_t pid);
+
+    // pid -> update ring shared by the process, set up after PreRegisterSecCompProcess
+    std::mutex channelLock_;
+    std::unordered_map<int32_t, std::shared_ptr<ProcessChannel>> channelMap_;
+    std::shared_ptr<SecEventHandler> secHandler_;
+    UpdateRecordHandler recordHandler_;
+    DISALLOW_COPY_AND_MOVE(SecCompUpdateChannel);
+};
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
+#endif  // SECURITY_COMPONENT_UPDATE_CHANNEL_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,10 +14,11 @@
  */
 #include "window_info_helper.h"
 
-#include <thread>
 #include <vector>
 #include "sec_comp_info_helper.h"
+#include "sec_comp_latency_stats.h"
 #include "sec_comp_log.h"
+#include "window_scale_cache.h"
 
 namespace OHOS {
 namespace Security {
@@ -26,8 +27,6 @@ namespace {
 constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "WindowInfoHelper"};
 constexpr int32_t INVALID_WINDOW_LAYER = -1;
 constexpr uint32_t UI_EXTENSION_MASK = 0x40000000;
-static constexpr int32_t GET_WINDOW_WAITTIME_MILLISECONDS = 1; // 1ms
-static constexpr int32_t GET_WINDOW_REPEAT_TIMES = 10;
 }
 
 bool WindowInfoHelper::TryGetWindowInfo(int32_t windowId, int32_t userId,
@@ -52,29 +51,20 @@ bool WindowInfoHelper::TryGetWindowInfo(int32_t windowId, int32_t userId,
 Scales WindowInfoHelper::GetWindowScale(int32_t windowId, int32_t userId, bool& isCompatScaleMode,
     SecCompRect& scaleRect)
 {
+    LatencyStageTimer timer(LATENCY_STAGE_GET_WINDOW_SCALE);
     Scales scales;
     scales.floatingScale = FULL_SCREEN_SCALE;
-    auto sleepTime = std::chrono::milliseconds(GET_WINDOW_WAITTIME_MILLISECONDS);
-    sptr<Rosen::AccessibilityWindowInfo> windowInfo = nullptr;
-    int32_t i = 0;
-    for (i = 0; i < GET_WINDOW_REPEAT_TIMES; ++i) {
-        if (TryGetWindowInfo(windowId, userId, windowInfo)) {
-            break;
-        }
-        std::this_thread::sleep_for(sleepTime);
-    }
-    if ((i >= GET_WINDOW_REPEAT_TIMES) || (windowInfo == nullptr)) {
+    WindowScaleInfo info;
+    if (!WindowScaleCache::GetInstance().GetWindowScaleInfo(windowId, userId, info)) {
         SC_LOG_WARN(LABEL, "Cannot find AccessibilityWindowInfo, return default scale");
         return scales;
     }
-    isCompatScaleMode = windowInfo->isCompatScaleMode_;
-    scales.floatingScale = windowInfo->scaleVal_;
-    scales.scaleX = windowInfo->scaleX_;
-    scales.scaleY = windowInfo->scaleY_;
-    scaleRect.x_ = windowInfo->scaleRect_.posX_;
-    scaleRect.y_ = windowInfo->scaleRect_.posY_;
-    scaleRect.width_ = windowInfo->scaleRect_.width_;
-    scaleRect.height_ = windowInfo->scaleRect_.height_;
+    isCompatScaleMode = info.isCompatScaleMode;
+    scales = info.scales;
+    scaleRect.x_ = info.scaleRect.x_;
+    scaleRect.y_ = info.scaleRect.y_;
+    scaleRect.width_ = info.scaleRect.width_;
+    scaleRect.height_ = info.scaleRect.height_;
     SC_LOG_INFO(LABEL, "Get floatingScale = %{public}f, scaleX = %{public}f, scaleY = %{public}f, \
         isCompatScaleMode = %{public}d", scales.floatingScale, scales.scaleX, scales.scaleY, isCompatScaleMode);
     return scales;
@@ -169,6 +159,7 @@ static bool IsOtherWindowCoverComp(int32_t compWinId, const SecCompRect& secRect
 bool WindowInfoHelper::CheckOtherWindowCoverComp(int32_t compWinId, const SecCompRect& secRect, int32_t userId,
     std::string& message)
 {
+    LatencyStageTimer timer(LATENCY_STAGE_CHECK_WINDOW_COVER);
     if ((static_cast<uint32_t>(compWinId) & UI_EXTENSION_MASK) == UI_EXTENSION_MASK) {
         SC_LOG_INFO(LABEL, "UI extension can not check");
         return true;
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "window_scale_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include "sec_comp_log.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+namespace {
+constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "WindowScaleCache"};
+static constexpr int32_t WAIT_WINDOW_ADDED_MILLISECONDS = 10; // 10ms
+static constexpr int32_t GET_WINDOW_WAITTIME_MILLISECONDS = 1; // 1ms
+static constexpr int32_t GET_WINDOW_REPEAT_TIMES = 10;
+static constexpr int32_t SMART_EDGE_WINDOW_ID = 1;
+static constexpr size_t MAX_WINDOW_CACHE_SIZE = 1024;
+static std::mutex g_instanceMutex;
+
+static std::vector<int32_t> GetCacheWindowIds(const Rosen::AccessibilityWindowInfo& info)
+{
+    std::vector<int32_t> ids = { info.wid_ };
+    if (info.wid_ == SMART_EDGE_WINDOW_ID) {
+        ids.emplace_back(info.innerWid_);
+    }
+    return ids;
+}
+
+static void ConvertWindowInfo(const Rosen::AccessibilityWindowInfo& windowInfo, WindowScaleInfo& info)
+{
+    info.isCompatScaleMode = windowInfo.isCompatScaleMode_;
+    info.scales.floatingScale = windowInfo.scaleVal_;
+    info.scales.scaleX = windowInfo.scaleX_;
+    info.scales.scaleY = windowInfo.scaleY_;
+    info.scaleRect.x_ = windowInfo.scaleRect_.posX_;
+    info.scaleRect.y_ = windowInfo.scaleRect_.posY_;
+    info.scaleRect.width_ = windowInfo.scaleRect_.width_;
+    info.scaleRect.height_ = windowInfo.scaleRect_.height_;
+}
+
+static bool FindQueriedWindow(const std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos, int32_t windowId,
+    WindowScaleInfo& info)
+{
+    for (const auto& windowInfo : infos) {
+        if (windowInfo == nullptr) {
+            continue;
+        }
+        auto ids = GetCacheWindowIds(*windowInfo);
+        if (std::find(ids.begin(), ids.end(), windowId) != ids.end()) {
+            ConvertWindowInfo(*windowInfo, info);
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+WindowScaleCache& WindowScaleCache::GetInstance()
+{
+    static WindowScaleCache* instance = nullptr;
+    if (instance == nullptr) {
+        std::lock_guard<std::mutex> lock(g_instanceMutex);
+        if (instance == nullptr) {
+            instance = new WindowScaleCache();
+        }
+    }
+    return *instance;
+}
+
+void WindowScaleCache::WindowUpdateListener::OnWindowUpdate(
+    const std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos, Rosen::WindowUpdateType type)
+{
+    if (type == Rosen::WindowUpdateType::WINDOW_UPDATE_REMOVED) {
+        WindowScaleCache::GetInstance().RemoveWindows(infos);
+        return;
+    }
+    WindowScaleCache::GetInstance().UpdateWindows(infos);
+}
+
+bool WindowScaleCache::RegisterListener(int32_t userId)
+{
+    std::lock_guard<std::mutex> lock(listenerLock_);
+    auto iter = listenerMap_.find(userId);
+    if (iter != listenerMap_.end()) {
+        return iter->second != nullptr;
+    }
+    // a failed user is not retried, its windows are always queried directly.
+    listenerMap_[userId] = nullptr;
+    sptr<WindowUpdateListener> listener = new (std::nothrow) WindowUpdateListener();
+    if (listener == nullptr) {
+        SC_LOG_ERROR(LABEL, "Failed to create window update listener");
+        return false;
+    }
+    if (Rosen::WindowManager::GetInstance(userId).RegisterWindowUpdateListener(listener) != Rosen::WMError::WM_OK) {
+        SC_LOG_ERROR(LABEL, "Failed to register window update listener, userId %{public}d", userId);
+        return false;
+    }
+    listenerMap_[userId] = listener;
+    SC_LOG_INFO(LABEL, "Register window update listener success, userId %{public}d", userId);
+    return true;
+}
+
+void WindowScaleCache::UnregisterListeners()
+{
+    std::lock_guard<std::mutex> lock(listenerLock_);
+    for (auto& listener : listenerMap_) {
+        if (listener.second != nullptr) {
+            Rosen::WindowManager::GetInstance(listener.first).UnregisterWindowUpdateListener(listener.second);
+        }
+    }
+    listenerMap_.clear();
+    Clear();
+}
+
+bool WindowScaleCache::QueryWindows(int32_t userId, std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos)
+{
+    if (Rosen::WindowManager::GetInstance(userId).GetAccessibilityWindowInfo(infos) != Rosen::WMError::WM_OK) {
+        SC_LOG_ERROR(LABEL, "Get AccessibilityWindowInfo failed");
+        return false;
+    }
+    return true;
+}
+
+bool WindowScaleCache::FindWindow(int32_t windowId, WindowScaleInfo& info)
+{
+    auto iter = windowScaleMap_.find(windowId);
+    if (iter == windowScaleMap_.end()) {
+        return false;
+    }
+    info = iter->second;
+    return true;
+}
+
+void WindowScaleCache::UpdateWindows(const std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos)
+{
+    {
+        std::lock_guard<std::mutex> lock(cacheLock_);
+        if (windowScaleMap_.size() + infos.size() > MAX_WINDOW_CACHE_SIZE) {
+            SC_LOG_WARN(LABEL, "Window scale cache is full, clear it");
+            windowScaleMap_.clear();
+        }
+        for (const auto& windowInfo : infos) {
+            if (windowInfo == nullptr) {
+                continue;
+            }
+            WindowScaleInfo info;
+            ConvertWindowInfo(*windowInfo, info);
+            for (int32_t id : GetCacheWindowIds(*windowInfo)) {
+                windowScaleMap_[id] = info;
+            }
+        }
+    }
+    windowAddedCond_.notify_all();
+}
+
+void WindowScaleCache::RemoveWindows(const std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos)
+{
+    std::lock_guard<std::mutex> lock(cacheLock_);
+    for (const auto& windowInfo : infos) {
+        if (windowInfo == nullptr) {
+            continue;
+        }
+        for (int32_t id : GetCacheWindowIds(*windowInfo)) {
+            windowScaleMap_.erase(id);
+        }
+    }
+}
+
+void WindowScaleCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(cacheLock_);
+    windowScaleMap_.clear();
+}
+
+bool WindowScaleCache::GetWindowScaleInfo(int32_t windowId, int32_t userId, WindowScaleInfo& info)
+{
+    bool isRegistered = RegisterListener(userId);
+    if (isRegistered) {
+        std::lock_guard<std::mutex> lock(cacheLock_);
+        if (FindWindow(windowId, info)) {
+            return true;
+        }
+    }
+
+    std::vector<sptr<Rosen::AccessibilityWindowInfo>> infos;
+    if (!isRegistered) {
+        // no added event will come, window may be reported later than the component, query it again.
+        for (int32_t i = 0; i < GET_WINDOW_REPEAT_TIMES; ++i) {
+            infos.clear();
+            if (QueryWindows(userId, infos) && FindQueriedWindow(infos, windowId, info)) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(GET_WINDOW_WAITTIME_MILLISECONDS));
+        }
+        return false;
+    }
+
+    // windows created before the listener was registered are only known by query.
+    if (!QueryWindows(userId, infos)) {
+        return false;
+    }
+
+    UpdateWindows(infos);
+    std::unique_lock<std::mutex> lock(cacheLock_);
+    // window may be reported later than the component, wait for its added event.
+    windowAddedCond_.wait_for(lock, std::chrono::milliseconds(WAIT_WINDOW_ADDED_MILLISECONDS),
+        [this, windowId]() { return windowScaleMap_.find(windowId) != windowScaleMap_.end(); });
+    return FindWindow(windowId, info);
+}
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SECURITY_COMPONENT_WINDOW_SCALE_CACHE_H
+#define SECURITY_COMPONENT_WINDOW_SCALE_CACHE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "nocopyable.h"
+#include "sec_comp_info.h"
+#include "window_manager.h"
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+struct WindowScaleInfo {
+    Scales scales;
+    bool isCompatScaleMode = false;
+    SecCompRect scaleRect;
+};
+
+class __attribute__((visibility("default"))) WindowScaleCache {
+public:
+    static WindowScaleCache& GetInstance();
+    virtual ~WindowScaleCache() = default;
+
+    bool GetWindowScaleInfo(int32_t windowId, int32_t userId, WindowScaleInfo& info);
+    void UpdateWindows(const std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos);
+    void RemoveWindows(const std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos);
+    void UnregisterListeners();
+    void Clear();
+
+private:
+    class WindowUpdateListener : public Rosen::IWindowUpdateListener {
+    public:
+        void OnWindowUpdate(const std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos,
+            Rosen::WindowUpdateType type) override;
+    };
+
+    WindowScaleCache() = default;
+    bool RegisterListener(int32_t userId);
+    bool QueryWindows(int32_t userId, std::vector<sptr<Rosen::AccessibilityWindowInfo>>& infos);
+    bool FindWindow(int32_t windowId, WindowScaleInfo& info);
+
+    // windowId -> scale info, filled by window update events
+    std::mutex cacheLock_;
+    std::condition_variable windowAddedCond_;
+    std::unordered_map<int32_t, WindowScaleInfo> windowScaleMap_;
+    // userId -> listener, WindowManager instance is per user
+    std::mutex listenerLock_;
+    std::unordered_map<int32_t, sptr<WindowUpdateListener>> listenerMap_;
+    DISALLOW_COPY_AND_MOVE(WindowScaleCache);
+};
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
+#endif  // SECURITY_COMPONENT_WINDOW_SCALE_CACHE_H
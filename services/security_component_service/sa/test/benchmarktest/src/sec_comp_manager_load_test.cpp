@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sec_comp_err.h"
+#include "sec_comp_latency_stats.h"
+#include "sec_comp_manager.h"
+#include "service_test_common.h"
+#include "window_manager.h"
+
+using namespace OHOS;
+using namespace OHOS::Security::SecurityComponent;
+
+namespace {
+static constexpr int32_t TEST_PID_BASE = 10000;
+static constexpr int32_t TEST_UID_BASE = 20000;
+static constexpr int32_t NANO_TO_SEC = 1000000000;
+static constexpr uint32_t LOAD_PERCENTILES[] = { 50, 90, 99 };
+static constexpr double MICRO_TO_SEC = 1000000.0;
+// only single register, update and click are driven, they are the first latency operations
+static constexpr uint32_t LOAD_OP_NUM = LATENCY_OP_CLICK + 1;
+static const char* const OPERATION_NAMES[LOAD_OP_NUM] = { "register", "update", "click" };
+
+struct LoadConfig {
+    int32_t processNum = 50;
+    int32_t componentNum = 500;
+    // weights of register, update and click in the operation mix
+    std::array<uint32_t, LOAD_OP_NUM> mix = { 10, 60, 30 };
+    int32_t threadNum = 8;
+    int32_t durationSec = 10;
+};
+
+struct LoadProcess {
+    explicit LoadProcess(size_t componentNum) : scIds(componentNum) {}
+
+    SecCompCallerInfo caller;
+    // register replaces a slot, update and click pick the current component of a slot
+    std::vector<std::atomic<int32_t>> scIds;
+};
+
+struct OperationResult {
+    LatencyHistogram latency;
+    uint64_t errorCount = 0;
+    // update or click of a slot which is being registered again
+    uint64_t skippedCount = 0;
+};
+
+using ThreadResult = std::array<OperationResult, LOAD_OP_NUM>;
+
+struct LoadContext {
+    const LoadConfig& config;
+    std::vector<std::unique_ptr<LoadProcess>>& processes;
+    const nlohmann::json& jsonComponent;
+    std::atomic<bool> isStopped {false};
+};
+
+static bool ParseIntArg(const char* arg, const char* name, int32_t& value)
+{
+    size_t len = strlen(name);
+    if (strncmp(arg, name, len) != 0) {
+        return false;
+    }
+    value = std::max(atoi(arg + len), 1);
+    return true;
+}
+
+static bool ParseMixArg(const char* arg, LoadConfig& config)
+{
+    static const char* const mixName = "--mix=";
+    if (strncmp(arg, mixName, strlen(mixName)) != 0) {
+        return false;
+    }
+    uint32_t reg = 0;
+    uint32_t update = 0;
+    uint32_t click = 0;
+    // register:update:click
+    if ((sscanf(arg + strlen(mixName), "%u:%u:%u", &reg, &update, &click) == static_cast<int>(LOAD_OP_NUM)) &&
+        ((reg + update + click) > 0)) {
+        config.mix = { reg, update, click };
+    }
+    return true;
+}
+
+static bool ParseArgs(int argc, char** argv, LoadConfig& config)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (ParseIntArg(argv[i], "--processes=", config.processNum) ||
+            ParseIntArg(argv[i], "--components=", config.componentNum) ||
+            ParseIntArg(argv[i], "--threads=", config.threadNum) ||
+            ParseIntArg(argv[i], "--duration=", config.durationSec) ||
+            ParseMixArg(argv[i], config)) {
+            continue;
+        }
+        fprintf(stderr, "usage: %s [--processes=50] [--components=500] [--threads=8] [--duration=10] "
+            "[--mix=register:update:click]\n", argv[0]);
+        return false;
+    }
+    return true;
+}
+
+static uint64_t GetMonotonicMicroseconds()
+{
+    struct timespec tv = {};
+    clock_gettime(CLOCK_MONOTONIC, &tv);
+    return static_cast<uint64_t>(tv.tv_sec * static_cast<uint64_t>(NANO_TO_SEC) + tv.tv_nsec) /
+        ServiceTestCommon::TIME_CONVERSION_UNIT;
+}
+
+static int32_t RegisterToSlot(LoadProcess& process, size_t slot, const nlohmann::json& jsonComponent)
+{
+    int32_t oldScId = process.scIds[slot].exchange(INVALID_SC_ID);
+    if (oldScId != INVALID_SC_ID) {
+        SecCompManager::GetInstance().UnregisterSecurityComponent(oldScId, process.caller);
+    }
+    int32_t scId = INVALID_SC_ID;
+    int32_t res = SecCompManager::GetInstance().RegisterSecurityComponent(SAVE_COMPONENT, jsonComponent,
+        process.caller, scId);
+    if (res != SC_OK) {
+        return res;
+    }
+    // another register of the slot may have finished meanwhile, the slot keeps only one component
+    int32_t expected = INVALID_SC_ID;
+    if (!process.scIds[slot].compare_exchange_strong(expected, scId)) {
+        SecCompManager::GetInstance().UnregisterSecurityComponent(scId, process.caller);
+    }
+    return res;
+}
+
+static int32_t UpdateSlot(LoadProcess& process, int32_t scId, const nlohmann::json& jsonComponent)
+{
+    uint32_t version = 0;
+    return SecCompManager::GetInstance().UpdateSecurityComponent(scId, jsonComponent, process.caller, version);
+}
+
+static int32_t ClickSlot(LoadProcess& process, int32_t scId, const nlohmann::json& jsonComponent)
+{
+    uint8_t extraData[1] = { 0 };
+    SecCompClickEvent clickInfo = {};
+    clickInfo.type = ClickEventType::POINT_EVENT_TYPE;
+    clickInfo.point.touchX = ServiceTestCommon::TEST_COORDINATE;
+    clickInfo.point.touchY = ServiceTestCommon::TEST_COORDINATE;
+    clickInfo.point.timestamp = GetMonotonicMicroseconds();
+    clickInfo.extraInfo.dataSize = sizeof(extraData);
+    clickInfo.extraInfo.data = extraData;
+    SecCompInfo info { scId, "", clickInfo };
+    std::vector<sptr<IRemoteObject>> remote = { nullptr, nullptr };
+    std::string message;
+    return SecCompManager::GetInstance().ReportSecurityComponentClickEvent(info, jsonComponent, process.caller,
+        remote, message);
+}
+
+static int32_t RunOperation(LatencyOperation op, LoadProcess& process, size_t slot, int32_t scId,
+    const nlohmann::json& jsonComponent)
+{
+    // scoped like the service does, so that stages and lock waits are attributed to op
+    LatencyOperationScope scope(op);
+    switch (op) {
+        case LATENCY_OP_REGISTER:
+            return RegisterToSlot(process, slot, jsonComponent);
+        case LATENCY_OP_UPDATE:
+            return UpdateSlot(process, scId, jsonComponent);
+        default:
+            return ClickSlot(process, scId, jsonComponent);
+    }
+}
+
+static void RunLoadThread(LoadContext& context, uint32_t seed, ThreadResult& result)
+{
+    std::mt19937 random(seed);
+    std::discrete_distribution<uint32_t> opDist(context.config.mix.begin(), context.config.mix.end());
+    std::uniform_int_distribution<size_t> processDist(0, context.processes.size() - 1);
+    std::uniform_int_distribution<size_t> slotDist(0, static_cast<size_t>(context.config.componentNum) - 1);
+    while (!context.isStopped.load(std::memory_order_relaxed)) {
+        LatencyOperation op = static_cast<LatencyOperation>(opDist(random));
+        LoadProcess& process = *context.processes[processDist(random)];
+        size_t slot = slotDist(random);
+        int32_t scId = process.scIds[slot].load();
+        if ((op != LATENCY_OP_REGISTER) && (scId == INVALID_SC_ID)) {
+            result[op].skippedCount++;
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        int32_t res = RunOperation(op, process, slot, scId, context.jsonComponent);
+        result[op].latency.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count()));
+        if (res != SC_OK) {
+            result[op].errorCount++;
+        }
+    }
+}
+
+static bool PrepareProcesses(const LoadConfig& config, const nlohmann::json& jsonComponent,
+    std::vector<std::unique_ptr<LoadProcess>>& processes)
+{
+    for (int32_t i = 0; i < config.processNum; ++i) {
+        auto process = std::make_unique<LoadProcess>(static_cast<size_t>(config.componentNum));
+        process->caller = { ServiceTestCommon::HAP_TOKEN_ID, TEST_UID_BASE + i, TEST_PID_BASE + i,
+            ServiceTestCommon::TEST_USER_ID };
+        SecCompManager::GetInstance().AddSecurityComponentProcess(process->caller);
+        for (int32_t slot = 0; slot < config.componentNum; ++slot) {
+            if (RegisterToSlot(*process, static_cast<size_t>(slot), jsonComponent) != SC_OK) {
+                fprintf(stderr, "register component %d of process %d failed\n", slot, i);
+                return false;
+            }
+        }
+        processes.emplace_back(std::move(process));
+    }
+    return true;
+}
+
+static void PrintHistogram(const char* name, const LatencyHistogram& histogram, const char* suffix)
+{
+    printf("      \"%s\": {\"count\": %llu, \"sum_us\": %llu", name,
+        static_cast<unsigned long long>(histogram.GetCount()), static_cast<unsigned long long>(histogram.GetSum()));
+    for (uint32_t percent : LOAD_PERCENTILES) {
+        printf(", \"p%u_us\": %llu", percent, static_cast<unsigned long long>(histogram.GetPercentile(percent)));
+    }
+    printf(", \"max_us\": %llu}%s\n", static_cast<unsigned long long>(histogram.GetMax()), suffix);
+}
+
+static void PrintReport(const LoadConfig& config, const std::vector<ThreadResult>& results, double elapsedSec)
+{
+    printf("{\n  \"config\": {\"processes\": %d, \"components\": %d, \"threads\": %d, \"duration_s\": %d, "
+        "\"mix\": [%u, %u, %u]},\n  \"elapsed_s\": %.3f,\n  \"operations\": {\n", config.processNum,
+        config.componentNum, config.threadNum, config.durationSec, config.mix[LATENCY_OP_REGISTER],
+        config.mix[LATENCY_OP_UPDATE], config.mix[LATENCY_OP_CLICK], elapsedSec);
+    for (uint32_t op = 0; op < LOAD_OP_NUM; ++op) {
+        OperationResult total;
+        for (const auto& result : results) {
+            total.latency.Merge(result[op].latency);
+            total.errorCount += result[op].errorCount;
+            total.skippedCount += result[op].skippedCount;
+        }
+        printf("    \"%s\": {\n      \"ops\": %llu,\n      \"ops_per_s\": %.1f,\n      \"errors\": %llu,\n"
+            "      \"skipped\": %llu,\n", OPERATION_NAMES[op],
+            static_cast<unsigned long long>(total.latency.GetCount()),
+            static_cast<double>(total.latency.GetCount()) / elapsedSec,
+            static_cast<unsigned long long>(total.errorCount), static_cast<unsigned long long>(total.skippedCount));
+        PrintHistogram("latency", total.latency, ",");
+        // one sample per lock acquired, sum_us / ops is the lock wait of one operation
+        PrintHistogram("lock_wait", SecCompLatencyStats::GetInstance().GetHistogram(
+            static_cast<LatencyOperation>(op), LATENCY_STAGE_LOCK_WAIT), "");
+        printf("    }%s\n", (op + 1 < LOAD_OP_NUM) ? "," : "");
+    }
+    printf("  }\n}\n");
+}
+}
+
+// drives SecCompManager in process with mocked window, display, access token and enhance dependencies,
+// the report is a json object so that runs of two commits can be compared by tools
+int main(int argc, char** argv)
+{
+    LoadConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        return 1;
+    }
+    Rosen::WindowManager::GetInstance().SetDefaultSecCompScene();
+    SecCompManager::GetInstance().Initialize();
+
+    nlohmann::json jsonComponent;
+    ServiceTestCommon::BuildSaveComponentJson(jsonComponent);
+    std::vector<std::unique_ptr<LoadProcess>> processes;
+    if (!PrepareProcesses(config, jsonComponent, processes)) {
+        return 1;
+    }
+    SecCompLatencyStats::GetInstance().Reset();
+
+    LoadContext context = { config, processes, jsonComponent };
+    std::vector<ThreadResult> results(static_cast<size_t>(config.threadNum));
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < config.threadNum; ++i) {
+        threads.emplace_back(RunLoadThread, std::ref(context), static_cast<uint32_t>(i + 1), std::ref(results[i]));
+    }
+    std::this_thread::sleep_for(std::chrono::seconds(config.durationSec));
+    context.isStopped.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double elapsedSec = static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count()) / MICRO_TO_SEC;
+    PrintReport(config, results, elapsedSec);
+
+    for (const auto& process : processes) {
+        SecCompManager::GetInstance().NotifyProcessDied(process->caller.pid, false);
+    }
+    return 0;
+}
@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "location_button.h"
+#include "paste_button.h"
+#include "save_button.h"
+#include "sec_comp_err.h"
+#define private public
+#include "sec_comp_entity.h"
+#include "sec_comp_info_helper.h"
+#undef private
+#include "service_test_common.h"
+#include "window_info_helper.h"
+#include "window_manager.h"
+
+using namespace OHOS;
+using namespace OHOS::Security::SecurityComponent;
+
+namespace {
+static constexpr double TEST_SCREEN_WIDTH = 1260.0;
+static constexpr double TEST_SCREEN_HEIGHT = 2720.0;
+static constexpr double TEST_WATCH_RADIUS = 233.0;
+static constexpr double TEST_WATCH_COORDINATE = 150.0;
+static constexpr int32_t TEST_WINDOW_OFFSET = 150;
+static constexpr int32_t TEST_COVER_WINDOW_OFFSET = 195;
+static constexpr int32_t TEST_COVER_WINDOW_ID = 1;
+static constexpr int32_t NANO_TO_SEC = 1000000000;
+static constexpr float TEST_SCALE = 1.0F;
+static std::atomic<uint64_t> g_allocCount {0};
+
+enum WindRectCase : int64_t {
+    WIND_RECT_DISJOINT = 0,
+    WIND_RECT_OVERLAP,
+    WIND_RECT_ROUND_CORNER,
+};
+
+static void BuildComponentJson(SecCompType type, nlohmann::json& jsonComponent)
+{
+    switch (type) {
+        case PASTE_COMPONENT:
+            ServiceTestCommon::BuildPasteComponentJson(jsonComponent);
+            break;
+        case SAVE_COMPONENT:
+            ServiceTestCommon::BuildSaveComponentJson(jsonComponent);
+            break;
+        default:
+            ServiceTestCommon::BuildLocationComponentJson(jsonComponent);
+            break;
+    }
+}
+
+static SecCompRect BuildTestRect(double coordinate)
+{
+    SecCompRect rect;
+    rect.x_ = coordinate;
+    rect.y_ = coordinate;
+    rect.width_ = ServiceTestCommon::TEST_COORDINATE;
+    rect.height_ = ServiceTestCommon::TEST_COORDINATE;
+    return rect;
+}
+
+static SecCompInfoHelper::ScreenInfo BuildScreenInfo(bool isWearable)
+{
+    SecCompInfoHelper::ScreenInfo screenInfo = {
+        .displayId = 0,
+        .crossAxisState = CrossAxisState::STATE_INVALID,
+        .isWearable = isWearable,
+        .superFoldOffsetY = 0,
+        .isCompatScaleMode = false,
+        .screenShape = isWearable ? Rosen::ScreenShape::ROUND : Rosen::ScreenShape::RECTANGLE
+    };
+    return screenInfo;
+}
+
+static uint64_t GetMonotonicMicroseconds()
+{
+    struct timespec tv = {};
+    clock_gettime(CLOCK_MONOTONIC, &tv);
+    return static_cast<uint64_t>(tv.tv_sec * static_cast<uint64_t>(NANO_TO_SEC) + tv.tv_nsec) /
+        ServiceTestCommon::TIME_CONVERSION_UNIT;
+}
+}
+
+// counts heap allocations of this binary for the parsing cases
+void* operator new(std::size_t size)
+{
+    g_allocCount++;
+    void* ptr = malloc((size == 0) ? 1 : size);
+    if (ptr == nullptr) {
+        abort();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t size) noexcept
+{
+    (void)size;
+    free(ptr);
+}
+
+static void SetAllocCounter(benchmark::State& state, uint64_t allocStart)
+{
+    state.counters["allocs"] = benchmark::Counter(static_cast<double>(g_allocCount.load() - allocStart),
+        benchmark::Counter::kAvgIterations);
+}
+
+static SecCompBase* NewComponent(SecCompType type)
+{
+    switch (type) {
+        case PASTE_COMPONENT:
+            return new PasteButton();
+        case SAVE_COMPONENT:
+            return new SaveButton();
+        default:
+            return new LocationButton();
+    }
+}
+
+// component info of the type given by the first argument, shared by the per-type parsing cases
+class ComponentInfoFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override
+    {
+        type_ = static_cast<SecCompType>(state.range(0));
+        BuildComponentJson(type_, jsonComponent_);
+        jsonText_ = jsonComponent_.dump();
+        info_ = SecCompInfoPayload(jsonComponent_);
+        std::string message;
+        base_.reset(SecCompInfoHelper::ParseComponent(type_, info_, ServiceTestCommon::TEST_USER_ID, message));
+        if ((base_ == nullptr) || !base_->ToBinary(binary_, sizeof(binary_), binaryLen_)) {
+            binaryLen_ = 0;
+        }
+        // an update that moves the component, rect and windowRect always come together
+        jsonDelta_[JsonTagConstants::JSON_BASE_VERSION_TAG] = 1;
+        jsonDelta_[JsonTagConstants::JSON_RECT] = jsonComponent_[JsonTagConstants::JSON_RECT];
+        jsonDelta_[JsonTagConstants::JSON_RECT][JsonTagConstants::JSON_RECT_X] = ServiceTestCommon::TEST_COORDINATE + 1;
+        jsonDelta_[JsonTagConstants::JSON_WINDOW_RECT] = jsonComponent_[JsonTagConstants::JSON_WINDOW_RECT];
+    }
+
+    void TearDown(const benchmark::State& state) override
+    {
+        base_.reset();
+        jsonDelta_.clear();
+    }
+
+    SecCompType type_ = UNKNOWN_SC_TYPE;
+    nlohmann::json jsonComponent_;
+    std::string jsonText_;
+    SecCompInfoPayload info_;
+    uint8_t binary_[SC_BINARY_MAX_SIZE] = { 0 };
+    size_t binaryLen_ = 0;
+    std::unique_ptr<SecCompBase> base_;
+    nlohmann::json jsonDelta_;
+};
+
+BENCHMARK_DEFINE_F(ComponentInfoFixture, BenchParseComponent)(benchmark::State& state)
+{
+    std::string message;
+    for (auto _ : state) {
+        std::unique_ptr<SecCompBase> comp(SecCompInfoHelper::ParseComponent(type_, info_,
+            ServiceTestCommon::TEST_USER_ID, message));
+        if (comp == nullptr) {
+            state.SkipWithError("parse component failed");
+            break;
+        }
+        benchmark::DoNotOptimize(comp.get());
+    }
+}
+BENCHMARK_REGISTER_F(ComponentInfoFixture, BenchParseComponent)->ArgName("type")->Arg(LOCATION_COMPONENT)
+    ->Arg(PASTE_COMPONENT)->Arg(SAVE_COMPONENT);
+
+// decoded in place from the request buffer, see SecCompService::ParseComponentInfo
+BENCHMARK_DEFINE_F(ComponentInfoFixture, BenchFromBinary)(benchmark::State& state)
+{
+    if (binaryLen_ == 0) {
+        state.SkipWithError("to binary failed");
+        return;
+    }
+    std::string message;
+    uint64_t allocStart = g_allocCount.load();
+    for (auto _ : state) {
+        std::unique_ptr<SecCompBase> comp(NewComponent(type_));
+        if (!comp->FromBinary(binary_, binaryLen_, message, false)) {
+            state.SkipWithError("from binary failed");
+            break;
+        }
+        benchmark::DoNotOptimize(comp.get());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * binaryLen_));
+    SetAllocCounter(state, allocStart);
+}
+BENCHMARK_REGISTER_F(ComponentInfoFixture, BenchFromBinary)->ArgName("type")->Arg(LOCATION_COMPONENT)
+    ->Arg(PASTE_COMPONENT)->Arg(SAVE_COMPONENT);
+
+// json text parsed to a dom and then filled, the way enhance and delta info still go
+BENCHMARK_DEFINE_F(ComponentInfoFixture, BenchFromJsonDom)(benchmark::State& state)
+{
+    std::string message;
+    uint64_t allocStart = g_allocCount.load();
+    for (auto _ : state) {
+        std::unique_ptr<SecCompBase> comp(NewComponent(type_));
+        nlohmann::json json = nlohmann::json::parse(jsonText_, nullptr, false);
+        if (!comp->FromJson(json, message, false)) {
+            state.SkipWithError("from json failed");
+            break;
+        }
+        benchmark::DoNotOptimize(comp.get());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * jsonText_.size()));
+    SetAllocCounter(state, allocStart);
+}
+BENCHMARK_REGISTER_F(ComponentInfoFixture, BenchFromJsonDom)->ArgName("type")->Arg(LOCATION_COMPONENT)
+    ->Arg(PASTE_COMPONENT)->Arg(SAVE_COMPONENT);
+
+BENCHMARK_DEFINE_F(ComponentInfoFixture, BenchFromJsonText)(benchmark::State& state)
+{
+    std::string message;
+    uint64_t allocStart = g_allocCount.load();
+    for (auto _ : state) {
+        std::unique_ptr<SecCompBase> comp(NewComponent(type_));
+        if (!comp->FromJsonText(jsonText_, message, false)) {
+            state.SkipWithError("from json text failed");
+            break;
+        }
+        benchmark::DoNotOptimize(comp.get());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * jsonText_.size()));
+    SetAllocCounter(state, allocStart);
+}
+BENCHMARK_REGISTER_F(ComponentInfoFixture, BenchFromJsonText)->ArgName("type")->Arg(LOCATION_COMPONENT)
+    ->Arg(PASTE_COMPONENT)->Arg(SAVE_COMPONENT);
+
+// update delta applied to a copy of the registered component
+BENCHMARK_DEFINE_F(ComponentInfoFixture, BenchPatchComponent)(benchmark::State& state)
+{
+    if (base_ == nullptr) {
+        state.SkipWithError("parse component failed");
+        return;
+    }
+    std::string message;
+    uint64_t allocStart = g_allocCount.load();
+    for (auto _ : state) {
+        std::unique_ptr<SecCompBase> comp(SecCompInfoHelper::PatchComponent(base_.get(), jsonDelta_, message));
+        if (comp == nullptr) {
+            state.SkipWithError("patch component failed");
+            break;
+        }
+        benchmark::DoNotOptimize(comp.get());
+    }
+    SetAllocCounter(state, allocStart);
+}
+BENCHMARK_REGISTER_F(ComponentInfoFixture, BenchPatchComponent)->ArgName("type")->Arg(LOCATION_COMPONENT)
+    ->Arg(PASTE_COMPONENT)->Arg(SAVE_COMPONENT);
+
+static void BenchFromJson(benchmark::State& state)
+{
+    nlohmann::json jsonComponent;
+    ServiceTestCommon::BuildLocationComponentJson(jsonComponent);
+    std::string message;
+    for (auto _ : state) {
+        LocationButton button;
+        if (!button.FromJson(jsonComponent, message, false)) {
+            state.SkipWithError("from json failed");
+            break;
+        }
+        benchmark::DoNotOptimize(button);
+    }
+}
+BENCHMARK(BenchFromJson);
+
+static void BenchToJson(benchmark::State& state)
+{
+    nlohmann::json jsonComponent;
+    ServiceTestCommon::BuildLocationComponentJson(jsonComponent);
+    std::string message;
+    LocationButton button;
+    if (!button.FromJson(jsonComponent, message, false)) {
+        state.SkipWithError("from json failed");
+        return;
+    }
+    for (auto _ : state) {
+        nlohmann::json jsonRes;
+        button.ToJson(jsonRes);
+        benchmark::DoNotOptimize(jsonRes);
+    }
+}
+BENCHMARK(BenchToJson);
+
+static void BenchCheckRectValid(benchmark::State& state)
+{
+    SecCompRect rect = BuildTestRect(ServiceTestCommon::TEST_COORDINATE);
+    SecCompRect windowRect = BuildTestRect(ServiceTestCommon::ZERO_OFFSET);
+    windowRect.width_ = TEST_SCREEN_WIDTH;
+    windowRect.height_ = TEST_SCREEN_HEIGHT;
+    SecCompInfoHelper::ScreenInfo screenInfo = BuildScreenInfo(false);
+    std::string message;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SecCompInfoHelper::CheckRectValid(rect, windowRect, screenInfo, message,
+            TEST_SCALE));
+    }
+}
+BENCHMARK(BenchCheckRectValid);
+
+static void BenchIsOutOfScreen(benchmark::State& state)
+{
+    SecCompRect rect = BuildTestRect(ServiceTestCommon::TEST_COORDINATE);
+    SecCompInfoHelper::ScreenInfo screenInfo = BuildScreenInfo(false);
+    std::string message;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SecCompInfoHelper::IsOutOfScreen(rect, TEST_SCREEN_WIDTH, TEST_SCREEN_HEIGHT,
+            message, screenInfo));
+    }
+}
+BENCHMARK(BenchIsOutOfScreen);
+
+static void BenchIsOutOfWatchScreen(benchmark::State& state)
+{
+    SecCompRect rect = BuildTestRect(TEST_WATCH_COORDINATE);
+    std::string message;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(SecCompInfoHelper::IsOutOfWatchScreen(rect, TEST_WATCH_RADIUS, message));
+    }
+}
+BENCHMARK(BenchIsOutOfWatchScreen);
+
+// every check queries the windows from the mock window manager
+static void BenchCheckOtherWindowCoverComp(benchmark::State& state)
+{
+    SecCompRect secRect = BuildTestRect(ServiceTestCommon::TEST_COORDINATE);
+    secRect.borderRadius_.leftTop = ServiceTestCommon::TEST_DIMENSION / ServiceTestCommon::QUARTER;
+    secRect.borderRadius_.rightTop = ServiceTestCommon::TEST_DIMENSION / ServiceTestCommon::QUARTER;
+    secRect.borderRadius_.leftBottom = ServiceTestCommon::TEST_DIMENSION / ServiceTestCommon::QUARTER;
+    secRect.borderRadius_.rightBottom = ServiceTestCommon::TEST_DIMENSION / ServiceTestCommon::QUARTER;
+    uint32_t windowSize = static_cast<uint32_t>(ServiceTestCommon::TEST_COORDINATE);
+    sptr<Rosen::UnreliableWindowInfo> compWin = new Rosen::UnreliableWindowInfo();
+    sptr<Rosen::UnreliableWindowInfo> coverWin = new Rosen::UnreliableWindowInfo();
+    coverWin->windowId_ = TEST_COVER_WINDOW_ID;
+    coverWin->windowRect_ = { 0, 0, windowSize, windowSize };
+    coverWin->zOrder_ = 1;
+    switch (state.range(0)) {
+        case WIND_RECT_OVERLAP:
+            coverWin->windowRect_.posX_ = TEST_WINDOW_OFFSET;
+            coverWin->windowRect_.posY_ = TEST_WINDOW_OFFSET;
+            break;
+        case WIND_RECT_ROUND_CORNER:
+            coverWin->windowRect_.posX_ = TEST_COVER_WINDOW_OFFSET;
+            coverWin->windowRect_.posY_ = TEST_COVER_WINDOW_OFFSET;
+            break;
+        default:
+            break;
+    }
+    Rosen::WindowManager::GetInstance().result_ = Rosen::WMError::WM_OK;
+    Rosen::WindowManager::GetInstance().info_ = { compWin, coverWin };
+    std::string message;
+    for (auto _ : state) {
+        message.clear();
+        benchmark::DoNotOptimize(WindowInfoHelper::CheckOtherWindowCoverComp(compWin->windowId_, secRect,
+            ServiceTestCommon::TEST_USER_ID, message));
+    }
+    Rosen::WindowManager::GetInstance().SetDefaultSecCompScene();
+}
+BENCHMARK(BenchCheckOtherWindowCoverComp)->ArgName("case")->Arg(WIND_RECT_DISJOINT)->Arg(WIND_RECT_OVERLAP)
+    ->Arg(WIND_RECT_ROUND_CORNER);
+
+static void BenchCheckClickInfo(benchmark::State& state)
+{
+    Rosen::WindowManager::GetInstance().SetDefaultSecCompScene();
+    auto component = std::make_shared<LocationButton>();
+    component->rect_ = BuildTestRect(ServiceTestCommon::TEST_COORDINATE);
+    SecCompOwnerInfo owner = { ServiceTestCommon::TEST_TOKEN_ID, ServiceTestCommon::TEST_PID_1,
+        ServiceTestCommon::TEST_UID_1, ServiceTestCommon::TEST_USER_ID };
+    SecCompEntity entity(component, ServiceTestCommon::TEST_SC_ID_1, owner);
+    uint8_t extraData[1] = { 0 };
+    SecCompClickEvent clickInfo = {};
+    clickInfo.type = ClickEventType::POINT_EVENT_TYPE;
+    clickInfo.extraInfo.dataSize = sizeof(extraData);
+    clickInfo.extraInfo.data = extraData;
+    std::string message;
+    for (auto _ : state) {
+        clickInfo.point.touchX = ServiceTestCommon::TEST_COORDINATE;
+        clickInfo.point.touchY = ServiceTestCommon::TEST_COORDINATE;
+        clickInfo.point.timestamp = GetMonotonicMicroseconds();
+        if (entity.CheckClickInfo(clickInfo, 0, CrossAxisState::STATE_INVALID, message) != SC_OK) {
+            state.SkipWithError("check click info failed");
+            break;
+        }
+    }
+}
+BENCHMARK(BenchCheckClickInfo);
+
+int main(int argc, char** argv)
+{
+    // json by default so that results of two commits can be compared by tools,
+    // a --benchmark_format given on the command line comes later and wins
+    std::string defaultFormat = "--benchmark_format=json";
+    std::vector<char*> args(argv, argv + argc);
+    args.insert(args.begin() + std::min<size_t>(1, args.size()), defaultFormat.data());
+    int argNum = static_cast<int>(args.size());
+    benchmark::Initialize(&argNum, args.data());
+    if (benchmark::ReportUnrecognizedArguments(argNum, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -16,10 +16,13 @@
 #define SECURITY_COMPONENT_INTERFACES_INNER_KITS_ACCESSTOKEN_KIT_H
 
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <vector>
 #include "access_token.h"
+#include "perm_state_change_callback_customize.h"
 
 namespace OHOS {
 namespace Security {
@@ -40,6 +43,13 @@ public:
 
     static int VerifyAccessToken(AccessTokenID tokenID, const std::string& permissionName);
 
+    static int32_t RegisterPermStateChangeCallback(const std::shared_ptr<PermStateChangeCallbackCustomize>& callback)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        callbackList_.emplace_back(callback);
+        return registerPermStateChangeCallbackRes;
+    };
+
     static int GetHapTokenInfo(AccessTokenID tokenID, HapTokenInfo& hapTokenInfoRes)
     {
         return AccessTokenKit::getHapTokenInfoRes;
@@ -65,6 +75,8 @@ public:
     static std::mutex mutex_;
     static std::map<AccessTokenID, std::set<std::string>> permMap_;
     static int getHapTokenInfoRes;
+    static int32_t registerPermStateChangeCallbackRes;
+    static std::vector<std::shared_ptr<PermStateChangeCallbackCustomize>> callbackList_;
 };
 } // namespace SECURITY_COMPONENT_INTERFACES_INNER_KITS_ACCESSTOKEN_KIT_H
 } // namespace Security
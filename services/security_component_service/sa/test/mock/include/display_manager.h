@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Copyright (c) 2025-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -22,6 +22,18 @@
 namespace OHOS::Rosen {
 class DisplayManager {
 public:
+    class IDisplayListener : public virtual RefBase {
+    public:
+        virtual void OnCreate(DisplayId) = 0;
+        virtual void OnDestroy(DisplayId) = 0;
+        virtual void OnChange(DisplayId) = 0;
+    };
+
+    class IFoldStatusListener : public virtual RefBase {
+    public:
+        virtual void OnFoldStatusChanged([[maybe_unused]] FoldStatus foldStatus) {}
+    };
+
     static DisplayManager& GetInstance()
     {
         static DisplayManager instance;
@@ -42,6 +54,26 @@ public:
     {
         return sptr<DisplayInfo>::MakeSptr();
     }
+
+    DMError RegisterDisplayListener(sptr<IDisplayListener> listener)
+    {
+        return DMError::DM_OK;
+    }
+
+    DMError UnregisterDisplayListener(sptr<IDisplayListener> listener)
+    {
+        return DMError::DM_OK;
+    }
+
+    DMError RegisterFoldStatusListener(sptr<IFoldStatusListener> listener)
+    {
+        return DMError::DM_OK;
+    }
+
+    DMError UnregisterFoldStatusListener(sptr<IFoldStatusListener> listener)
+    {
+        return DMError::DM_OK;
+    }
 };
 }
 #endif // SECURITY_COMPONENT_MANAGER_DISPLAY_MANAGER_MOCK_H
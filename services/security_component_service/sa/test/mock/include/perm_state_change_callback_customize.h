@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SECURITY_COMPONENT_MOCK_PERM_STATE_CHANGE_CALLBACK_CUSTOMIZE_H
+#define SECURITY_COMPONENT_MOCK_PERM_STATE_CHANGE_CALLBACK_CUSTOMIZE_H
+
+#include <string>
+#include <vector>
+#include "access_token.h"
+
+namespace OHOS {
+namespace Security {
+namespace AccessToken {
+struct PermStateChangeScope {
+    std::vector<AccessTokenID> tokenIDs;
+    std::vector<std::string> permList;
+};
+
+struct PermStateChangeInfo {
+    int32_t permStateChangeType;
+    AccessTokenID tokenID;
+    std::string permissionName;
+};
+
+class PermStateChangeCallbackCustomize {
+public:
+    PermStateChangeCallbackCustomize() = default;
+    explicit PermStateChangeCallbackCustomize(const PermStateChangeScope& scopeInfo) : scopeInfo_(scopeInfo) {}
+    virtual ~PermStateChangeCallbackCustomize() = default;
+
+    virtual void PermStateChangeCallback(PermStateChangeInfo& result) = 0;
+
+    void GetScope(PermStateChangeScope& scopeInfo) const
+    {
+        scopeInfo = scopeInfo_;
+    }
+
+private:
+    PermStateChangeScope scopeInfo_;
+};
+} // namespace AccessToken
+} // namespace Security
+} // namespace OHOS
+#endif // SECURITY_COMPONENT_MOCK_PERM_STATE_CHANGE_CALLBACK_CUSTOMIZE_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -26,6 +26,17 @@ using WindowMode = uint32_t;
 using WindowType = uint32_t;
 enum class WMError : int32_t {
     WM_OK = 0,
+    WM_ERROR_INVALID_PERMISSION = 100,
+};
+
+enum class WindowUpdateType : int32_t {
+    WINDOW_UPDATE_ADDED = 1,
+    WINDOW_UPDATE_REMOVED,
+    WINDOW_UPDATE_FOCUSED,
+    WINDOW_UPDATE_BOUNDS,
+    WINDOW_UPDATE_ACTIVE,
+    WINDOW_UPDATE_PROPERTY,
+    WINDOW_UPDATE_ALL,
 };
 
 struct Rect {
@@ -77,6 +88,11 @@ public:
     float scaleY_ { 1.0f };
 };
 
+class IWindowUpdateListener : virtual public RefBase {
+public:
+    virtual void OnWindowUpdate(const std::vector<sptr<AccessibilityWindowInfo>>& infos, WindowUpdateType type) = 0;
+};
+
 #ifndef FUZZ_ENABLE
 class WindowManager {
 public:
@@ -104,6 +120,20 @@ public:
         return result_;
     }
 
+    WMError RegisterWindowUpdateListener(const sptr<IWindowUpdateListener>& listener)
+    {
+        if (registerResult_ == WMError::WM_OK) {
+            listener_ = listener;
+        }
+        return registerResult_;
+    }
+
+    WMError UnregisterWindowUpdateListener(const sptr<IWindowUpdateListener>& listener)
+    {
+        listener_ = nullptr;
+        return WMError::WM_OK;
+    }
+
     WindowManager() {};
 
     void SetDefaultSecCompScene()
@@ -129,6 +159,9 @@ public:
     std::vector<sptr<Rosen::AccessibilityWindowInfo>> list_;
     std::vector<sptr<Rosen::UnreliableWindowInfo>> info_;
     WMError result_ = OHOS::Rosen::WMError::WM_OK;
+    // window update listener is not available by default, scale is queried directly.
+    WMError registerResult_ = OHOS::Rosen::WMError::WM_ERROR_INVALID_PERMISSION;
+    sptr<IWindowUpdateListener> listener_ = nullptr;
     int32_t lastUserId_ = -1;
 private:
     ~WindowManager() {};
@@ -176,6 +209,16 @@ public:
         return OHOS::Rosen::WMError::WM_OK;
     }
 
+    WMError RegisterWindowUpdateListener(const sptr<IWindowUpdateListener>& listener)
+    {
+        return OHOS::Rosen::WMError::WM_OK;
+    }
+
+    WMError UnregisterWindowUpdateListener(const sptr<IWindowUpdateListener>& listener)
+    {
+        return OHOS::Rosen::WMError::WM_OK;
+    }
+
     WindowManager() {};
     int32_t lastUserId_ = -1;
 private:
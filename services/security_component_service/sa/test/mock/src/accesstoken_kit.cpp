@@ -1,5 +1,5 @@
 /*
-* Copyright (c) 2023 Huawei Device Co., Ltd.
+* Copyright (c) 2023-2026 Huawei Device Co., Ltd.
 * Licensed under the Apache License, Version 2.0 (the "License");
 * you may not use this file except in compliance with the License.
 * You may obtain a copy of the License at
@@ -21,8 +21,10 @@ namespace OHOS {
 namespace Security {
 namespace AccessToken {
 int32_t AccessTokenKit::getHapTokenInfoRes = 0;
+int32_t AccessTokenKit::registerPermStateChangeCallbackRes = 0;
 std::mutex AccessTokenKit::mutex_;
 std::map<AccessTokenID, std::set<std::string>> AccessTokenKit::permMap_;
+std::vector<std::shared_ptr<PermStateChangeCallbackCustomize>> AccessTokenKit::callbackList_;
 
 int AccessTokenKit::RevokePermission(AccessTokenID tokenID, const std::string& permissionName, int flag)
 {
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -208,6 +208,24 @@ bool SecCompEnhanceAdapter::EnhanceSrvDeserialize(SecCompRawdata& input, Message
 }
 #endif // FUZZ_ENABLE
 
+bool SecCompEnhanceAdapter::EnhanceClientSerialize(const std::shared_ptr<MessageParcel>& input,
+    SecCompRawdata& output)
+{
+    return (input != nullptr) && EnhanceClientSerialize(*input, output);
+}
+
+bool SecCompEnhanceAdapter::EnhanceSrvSerialize(const std::shared_ptr<MessageParcel>& input,
+    SecCompRawdata& output)
+{
+    return (input != nullptr) && EnhanceSrvSerialize(*input, output);
+}
+
+std::shared_ptr<MessageParcel> SecCompEnhanceAdapter::AcquireParcel()
+{
+    SC_LOG_DEBUG(LABEL, "AcquireParcel success");
+    return std::make_shared<MessageParcel>();
+}
+
 void SecCompEnhanceAdapter::RegisterScIdEnhance(int32_t scId)
 {
     SC_LOG_DEBUG(LABEL, "RegisterScIdEnhance success");
@@ -240,6 +258,18 @@ int32_t SecCompEnhanceAdapter::CheckComponentInfoEnhance(int32_t pid,
     return SC_OK;
 }
 
+bool SecCompEnhanceAdapter::IsSrvEnhanceEnabled()
+{
+    SC_LOG_DEBUG(LABEL, "IsSrvEnhanceEnabled success");
+    return false;
+}
+
+bool SecCompEnhanceAdapter::IsClientEnhanceEnabled()
+{
+    SC_LOG_DEBUG(LABEL, "IsClientEnhanceEnabled success");
+    return false;
+}
+
 void SecCompEnhanceAdapter::AddSecurityComponentProcess(int32_t pid)
 {
     SC_LOG_DEBUG(LABEL, "AddSecurityComponentProcess success");
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -140,7 +140,7 @@ HWTEST_F(AppStateObserverTest, OnProcessStateChanged001, TestSize.Level0)
     AppExecFwk::ProcessData processData;
     processData.state = AppExecFwk::AppProcessState::APP_STATE_CREATE;
     observer_->OnProcessStateChanged(processData);
-    ASSERT_EQ(observer_->foregrandProcList_.size(), static_cast<size_t>(0));
+    ASSERT_EQ(observer_->fgPidProcMap_.size(), static_cast<size_t>(0));
 
     processData.state = AppExecFwk::AppProcessState::APP_STATE_FOREGROUND;
     processData.pid = ServiceTestCommon::TEST_PID_1;
@@ -219,6 +219,32 @@ HWTEST_F(AppStateObserverTest, AddProcessToForegroundSet002, TestSize.Level0)
     ASSERT_FALSE(observer_->IsProcessForeground(-1, ServiceTestCommon::TEST_UID_1));
 }
 
+/**
+ * @tc.name: IsProcessForeground002
+ * @tc.desc: Test pid of process added by uid is filled by its first call
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(AppStateObserverTest, IsProcessForeground002, TestSize.Level0)
+{
+    AppExecFwk::AppStateData stateData = {
+        .pid = -1,
+        .uid = ServiceTestCommon::TEST_UID_1,
+    };
+    observer_->AddProcessToForegroundSet(stateData);
+    observer_->AddProcessToForegroundSet(stateData);
+    ASSERT_EQ(observer_->fgUidProcMap_.size(), static_cast<size_t>(1));
+    ASSERT_FALSE(observer_->IsProcessForeground(ServiceTestCommon::TEST_PID_1, ServiceTestCommon::TEST_UID_2));
+    ASSERT_TRUE(observer_->IsProcessForeground(ServiceTestCommon::TEST_PID_1, ServiceTestCommon::TEST_UID_1));
+    ASSERT_EQ(observer_->fgUidProcMap_.size(), static_cast<size_t>(0));
+    ASSERT_EQ(observer_->fgPidProcMap_[ServiceTestCommon::TEST_PID_1].pid, ServiceTestCommon::TEST_PID_1);
+
+    // other processes of the uid are not foreground once the pid is known
+    ASSERT_FALSE(observer_->IsProcessForeground(ServiceTestCommon::TEST_PID_2, ServiceTestCommon::TEST_UID_1));
+    observer_->AddProcessToForegroundSet(stateData);
+    ASSERT_EQ(observer_->fgUidProcMap_.size(), static_cast<size_t>(0));
+}
+
 /**
  * @tc.name: DumpProcess001
  * @tc.desc: Test DumpProcess
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "display_geometry_cache_test.h"
+
+#include "sec_comp_log.h"
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::Security::SecurityComponent;
+
+namespace {
+static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
+    LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "DisplayGeometryCacheTest"};
+static constexpr uint64_t TEST_DISPLAY_ID = 0;
+static constexpr int32_t TEST_SCREEN_SIZE = 1500;
+}
+
+void DisplayGeometryCacheTest::SetUpTestCase()
+{}
+
+void DisplayGeometryCacheTest::TearDownTestCase()
+{}
+
+void DisplayGeometryCacheTest::SetUp()
+{
+    SC_LOG_INFO(LABEL, "setup");
+}
+
+void DisplayGeometryCacheTest::TearDown()
+{
+    DisplayGeometryCache::GetInstance().UnregisterListeners();
+    DisplayGeometryCache::GetInstance().Clear();
+}
+
+/**
+ * @tc.name: GetDisplayGeometry001
+ * @tc.desc: Test display geometry queried once and then read from cache while listeners are registered
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DisplayGeometryCacheTest, GetDisplayGeometry001, TestSize.Level0)
+{
+    DisplayGeometryCache& cache = DisplayGeometryCache::GetInstance();
+    DisplayGeometry geometry;
+    // nothing would invalidate it, so it is not cached
+    EXPECT_TRUE(cache.GetDisplayGeometry(TEST_DISPLAY_ID, geometry));
+    EXPECT_EQ(TEST_SCREEN_SIZE, geometry.width);
+    EXPECT_TRUE(cache.LoadSnapshot()->displays.empty());
+
+    ASSERT_TRUE(cache.RegisterListeners());
+    EXPECT_TRUE(cache.LoadSnapshot()->displays.empty());
+    EXPECT_TRUE(cache.GetDisplayGeometry(TEST_DISPLAY_ID, geometry));
+    EXPECT_EQ(TEST_SCREEN_SIZE, geometry.width);
+    EXPECT_EQ(TEST_SCREEN_SIZE, geometry.physicalHeight);
+    EXPECT_EQ(static_cast<size_t>(1), cache.LoadSnapshot()->displays.size());
+
+    auto snapshot = cache.LoadSnapshot();
+    EXPECT_TRUE(cache.GetDisplayGeometry(TEST_DISPLAY_ID, geometry));
+    EXPECT_EQ(snapshot, cache.LoadSnapshot());
+
+    cache.RemoveDisplay(TEST_DISPLAY_ID);
+    EXPECT_TRUE(cache.LoadSnapshot()->displays.empty());
+    // reader holding an old snapshot still sees its content
+    EXPECT_EQ(static_cast<size_t>(1), snapshot->displays.size());
+
+    cache.UpdateDisplay(TEST_DISPLAY_ID);
+    EXPECT_EQ(static_cast<size_t>(1), cache.LoadSnapshot()->displays.size());
+}
+
+/**
+ * @tc.name: GetDisplayGeometry002
+ * @tc.desc: Test geometry queried by a reader is not published after a change seen while querying
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DisplayGeometryCacheTest, GetDisplayGeometry002, TestSize.Level0)
+{
+    DisplayGeometryCache& cache = DisplayGeometryCache::GetInstance();
+    ASSERT_TRUE(cache.RegisterListeners());
+    DisplayGeometry geometry;
+    geometry.width = TEST_SCREEN_SIZE;
+    uint64_t generation = cache.generation_.load();
+    cache.RemoveDisplay(TEST_DISPLAY_ID);
+    cache.PublishQueriedDisplay(TEST_DISPLAY_ID, geometry, generation);
+    EXPECT_TRUE(cache.LoadSnapshot()->displays.empty());
+
+    generation = cache.generation_.load();
+    cache.PublishQueriedDisplay(TEST_DISPLAY_ID, geometry, generation);
+    EXPECT_EQ(static_cast<size_t>(1), cache.LoadSnapshot()->displays.size());
+
+    generation = cache.generation_.load();
+    cache.Clear();
+    cache.StoreFoldCrease({}, TEST_SCREEN_SIZE, &generation);
+    EXPECT_FALSE(cache.LoadSnapshot()->isCreaseLoaded);
+}
+
+/**
+ * @tc.name: GetFoldOffsetY001
+ * @tc.desc: Test fold offset loaded once and reloaded when fold status changes
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DisplayGeometryCacheTest, GetFoldOffsetY001, TestSize.Level0)
+{
+    DisplayGeometryCache& cache = DisplayGeometryCache::GetInstance();
+    EXPECT_EQ(0, cache.GetFoldOffsetY());
+    EXPECT_FALSE(cache.LoadSnapshot()->isCreaseLoaded);
+
+    ASSERT_TRUE(cache.RegisterListeners());
+    ASSERT_NE(nullptr, cache.foldStatusListener_);
+    EXPECT_TRUE(cache.RegisterListeners());
+    EXPECT_EQ(0, cache.GetFoldOffsetY());
+    EXPECT_TRUE(cache.LoadSnapshot()->isCreaseLoaded);
+
+    DisplayGeometry geometry;
+    EXPECT_TRUE(cache.GetDisplayGeometry(TEST_DISPLAY_ID, geometry));
+    cache.foldStatusListener_->OnFoldStatusChanged(Rosen::FoldStatus::FOLDED);
+    EXPECT_TRUE(cache.LoadSnapshot()->displays.empty());
+    EXPECT_TRUE(cache.LoadSnapshot()->isCreaseLoaded);
+
+    cache.displayListener_->OnCreate(TEST_DISPLAY_ID);
+    EXPECT_EQ(static_cast<size_t>(1), cache.LoadSnapshot()->displays.size());
+    cache.displayListener_->OnDestroy(TEST_DISPLAY_ID);
+    EXPECT_TRUE(cache.LoadSnapshot()->displays.empty());
+
+    cache.UnregisterListeners();
+    EXPECT_EQ(nullptr, cache.displayListener_);
+    EXPECT_FALSE(cache.LoadSnapshot()->isCreaseLoaded);
+}
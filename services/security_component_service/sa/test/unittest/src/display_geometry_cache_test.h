@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DISPLAY_GEOMETRY_CACHE_TEST_H
+#define DISPLAY_GEOMETRY_CACHE_TEST_H
+
+#include <gtest/gtest.h>
+#define private public
+#include "display_geometry_cache.h"
+#undef private
+
+namespace OHOS {
+namespace Security {
+namespace SecurityComponent {
+class DisplayGeometryCacheTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+
+    static void TearDownTestCase();
+
+    void SetUp();
+
+    void TearDown();
+};
+}  // namespace SecurityComponent
+}  // namespace Security
+}  // namespace OHOS
+#endif  // DISPLAY_GEOMETRY_CACHE_TEST_H
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -15,6 +15,7 @@
 #include "first_use_dialog_test.h"
 
 #include <cstdio>
+#include <vector>
 #include "accesstoken_kit.h"
 #include "ability_manager_client.h"
 #include "i_sec_comp_dialog_callback.h"
@@ -36,10 +37,18 @@ static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
 static const std::string SEC_COMP_SRV_CFG_PATH = "/data/service/el1/public/security_component_service";
 static const std::string SEC_COMP_SRV_CFG_FILE = SEC_COMP_SRV_CFG_PATH + "/" + "first_use_record.json";
 static const std::string SEC_COMP_SRV_CFG_BACK_FILE = SEC_COMP_SRV_CFG_PATH + "/" + "first_use_record.json.bak";
+static const std::string SEC_COMP_SRV_JOURNAL_FILE = SEC_COMP_SRV_CFG_PATH + "/" + "first_use_record.journal";
+static const std::string SEC_COMP_SRV_SNAPSHOT_FILE = SEC_COMP_SRV_CFG_PATH + "/" + "first_use_record.dat";
+static const std::string BACK_FILE_SUFFIX = ".bak";
+static const std::vector<std::string> SEC_COMP_SRV_RECORD_FILES = {
+    SEC_COMP_SRV_JOURNAL_FILE, SEC_COMP_SRV_SNAPSHOT_FILE
+};
 static const std::string INVALID_PATH = "/invalid_path";
 static const std::string DATA_FOLDER = "/data";
 constexpr uint64_t LOCATION_BUTTON_FIRST_USE = 1 << 0;
 constexpr uint64_t SAVE_BUTTON_FIRST_USE = 1 << 1;
+// more than the 100k config file limit the journal was once read with
+constexpr uint32_t TEST_JOURNAL_RECORD_NUM = 8000;
 
 static std::shared_ptr<SecCompEntity> CreateTestEntity()
 {
@@ -78,6 +87,12 @@ void FirstUseDialogTest::SetUp()
     SC_LOG_INFO(LABEL, "setup");
     AAFwk::AbilityManagerClient::GetInstance()->lastUserId_ = -1;
     struct stat fstat = {};
+    for (const auto& file : SEC_COMP_SRV_RECORD_FILES) {
+        if (stat(file.c_str(), &fstat) == 0) {
+            std::string cmdline = "mv " + file + " " + file + BACK_FILE_SUFFIX;
+            system(cmdline.c_str());
+        }
+    }
     if (stat(SEC_COMP_SRV_CFG_FILE.c_str(), &fstat) != 0) {
         return;
     }
@@ -88,6 +103,14 @@ void FirstUseDialogTest::SetUp()
 void FirstUseDialogTest::TearDown()
 {
     struct stat fstat = {};
+    for (const auto& file : SEC_COMP_SRV_RECORD_FILES) {
+        std::string rmCmdline = "rm -f " + file;
+        system(rmCmdline.c_str());
+        if (stat((file + BACK_FILE_SUFFIX).c_str(), &fstat) == 0) {
+            std::string cmdline = "mv " + file + BACK_FILE_SUFFIX + " " + file;
+            system(cmdline.c_str());
+        }
+    }
     if (stat(SEC_COMP_SRV_CFG_BACK_FILE.c_str(), &fstat) != 0) {
         return;
     }
@@ -106,9 +129,9 @@ HWTEST_F(FirstUseDialogTest, ReportUserData001, TestSize.Level0)
     FirstUseDialog diag;
     diag.firstUseMap_[1] = 1;
     diag.SaveFirstUseRecord();
-    ASSERT_EQ(true, ReportUserData(SEC_COMP_SRV_CFG_FILE, DATA_FOLDER));
+    ASSERT_EQ(true, ReportUserData(SEC_COMP_SRV_SNAPSHOT_FILE, DATA_FOLDER));
     ASSERT_EQ(false, ReportUserData(INVALID_PATH, DATA_FOLDER));
-    ASSERT_EQ(false, ReportUserData(SEC_COMP_SRV_CFG_FILE, INVALID_PATH));
+    ASSERT_EQ(false, ReportUserData(SEC_COMP_SRV_SNAPSHOT_FILE, INVALID_PATH));
 }
 
 /**
@@ -322,6 +345,7 @@ HWTEST_F(FirstUseDialogTest, SaveFirstUseRecord003, TestSize.Level0)
     diag.firstUseMap_.clear();
     diag.LoadFirstUseRecord();
     EXPECT_EQ(0, static_cast<int32_t>(diag.firstUseMap_.size()));
+    EXPECT_EQ(0, static_cast<int32_t>(diag.GetFirstUseCompTypes(1)));
     OHOS::Security::AccessToken::AccessTokenKit::getHapTokenInfoRes = 0;
 }
 
@@ -338,8 +362,144 @@ HWTEST_F(FirstUseDialogTest, SaveFirstUseRecord004, TestSize.Level0)
     diag.SaveFirstUseRecord();
     diag.firstUseMap_.clear();
     diag.LoadFirstUseRecord();
-    EXPECT_EQ(1, static_cast<int32_t>(diag.firstUseMap_.size()));
-    EXPECT_EQ(1, static_cast<int32_t>(diag.firstUseMap_[1]));
+    EXPECT_EQ(0, static_cast<int32_t>(diag.firstUseMap_.size()));
+    EXPECT_EQ(1, static_cast<int32_t>(diag.snapshot_.recordNum));
+    EXPECT_EQ(1, static_cast<int32_t>(diag.GetFirstUseCompTypes(1)));
+}
+
+/**
+ * @tc.name: FlushFirstUseRecord001
+ * @tc.desc: Test only changed records are appended to journal and loaded after snapshot
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(FirstUseDialogTest, FlushFirstUseRecord001, TestSize.Level0)
+{
+    FirstUseDialog diag;
+    diag.firstUseMap_[1] = SAVE_BUTTON_FIRST_USE;
+    diag.SaveFirstUseRecord();
+    EXPECT_EQ(0, static_cast<int32_t>(diag.journalRecordNum_));
+
+    diag.firstUseMap_[2] = SAVE_BUTTON_FIRST_USE;
+    diag.dirtyTokens_.insert(2);
+    diag.FlushFirstUseRecord();
+    EXPECT_EQ(1, static_cast<int32_t>(diag.journalRecordNum_));
+    EXPECT_TRUE(diag.dirtyTokens_.empty());
+
+    // nothing changed, nothing written
+    diag.FlushFirstUseRecord();
+    EXPECT_EQ(1, static_cast<int32_t>(diag.journalRecordNum_));
+
+    FirstUseDialog loadDiag;
+    loadDiag.LoadFirstUseRecord();
+    EXPECT_EQ(1, static_cast<int32_t>(loadDiag.snapshot_.recordNum));
+    EXPECT_EQ(1, static_cast<int32_t>(loadDiag.firstUseMap_.size()));
+    EXPECT_EQ(SAVE_BUTTON_FIRST_USE, loadDiag.GetFirstUseCompTypes(1));
+    EXPECT_EQ(SAVE_BUTTON_FIRST_USE, loadDiag.GetFirstUseCompTypes(2));
+    EXPECT_EQ(1, static_cast<int32_t>(loadDiag.journalRecordNum_));
+
+    // compaction folds the journal into snapshot
+    diag.SaveFirstUseRecord();
+    struct stat fstat = {};
+    EXPECT_NE(0, stat(SEC_COMP_SRV_JOURNAL_FILE.c_str(), &fstat));
+    loadDiag.firstUseMap_.clear();
+    loadDiag.LoadFirstUseRecord();
+    EXPECT_EQ(2, static_cast<int32_t>(loadDiag.snapshot_.recordNum));
+    EXPECT_EQ(0, static_cast<int32_t>(loadDiag.firstUseMap_.size()));
+    EXPECT_EQ(SAVE_BUTTON_FIRST_USE, loadDiag.GetFirstUseCompTypes(2));
+}
+
+/**
+ * @tc.name: LoadFirstUseRecord011
+ * @tc.desc: Test journal with torn tail is loaded and compacted
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(FirstUseDialogTest, LoadFirstUseRecord011, TestSize.Level0)
+{
+    FirstUseDialog diag;
+    diag.firstUseMap_[1] = SAVE_BUTTON_FIRST_USE;
+    diag.dirtyTokens_.insert(1);
+    diag.FlushFirstUseRecord();
+    std::string cmdline = "echo -n broken >> " + SEC_COMP_SRV_JOURNAL_FILE;
+    system(cmdline.c_str());
+
+    FirstUseDialog loadDiag;
+    loadDiag.LoadFirstUseRecord();
+    EXPECT_EQ(1, static_cast<int32_t>(loadDiag.snapshot_.recordNum));
+    EXPECT_EQ(SAVE_BUTTON_FIRST_USE, loadDiag.GetFirstUseCompTypes(1));
+    EXPECT_EQ(0, static_cast<int32_t>(loadDiag.journalRecordNum_));
+    struct stat fstat = {};
+    EXPECT_NE(0, stat(SEC_COMP_SRV_JOURNAL_FILE.c_str(), &fstat));
+}
+
+/**
+ * @tc.name: FlushFirstUseRecord002
+ * @tc.desc: Test a journal longer than the config file limit is loaded whole
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(FirstUseDialogTest, FlushFirstUseRecord002, TestSize.Level0)
+{
+    FirstUseDialog diag;
+    for (AccessTokenID tokenId = 1; tokenId <= TEST_JOURNAL_RECORD_NUM; ++tokenId) {
+        diag.firstUseMap_[tokenId] = LOCATION_BUTTON_FIRST_USE;
+    }
+    diag.SaveFirstUseRecord();
+    // every record changes, the journal stays shorter than the records in memory and is not compacted
+    for (AccessTokenID tokenId = 1; tokenId <= TEST_JOURNAL_RECORD_NUM; ++tokenId) {
+        diag.firstUseMap_[tokenId] = LOCATION_BUTTON_FIRST_USE | SAVE_BUTTON_FIRST_USE;
+        diag.dirtyTokens_.insert(tokenId);
+    }
+    diag.FlushFirstUseRecord();
+    EXPECT_EQ(TEST_JOURNAL_RECORD_NUM, diag.journalRecordNum_);
+
+    FirstUseDialog loadDiag;
+    loadDiag.LoadFirstUseRecord();
+    EXPECT_EQ(TEST_JOURNAL_RECORD_NUM, loadDiag.journalRecordNum_);
+    EXPECT_EQ(LOCATION_BUTTON_FIRST_USE | SAVE_BUTTON_FIRST_USE,
+        loadDiag.GetFirstUseCompTypes(TEST_JOURNAL_RECORD_NUM));
+}
+
+/**
+ * @tc.name: LoadFirstUseRecord012
+ * @tc.desc: Test json record is loaded on first use and moved to snapshot
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(FirstUseDialogTest, LoadFirstUseRecord012, TestSize.Level0)
+{
+    std::string cmdline = "echo {\\\"FirstUseRecord\\\":[{\\\"CompType\\\":2,\\\"TokenId\\\":1}]} > "
+         + SEC_COMP_SRV_CFG_FILE;
+    system(cmdline.c_str());
+    FirstUseDialog diag;
+    EXPECT_FALSE(diag.isRecordLoaded_.load());
+    diag.SaveFirstUseRecord();
+    EXPECT_TRUE(diag.isRecordLoaded_.load());
+
+    struct stat fstat = {};
+    EXPECT_NE(0, stat(SEC_COMP_SRV_CFG_FILE.c_str(), &fstat));
+    EXPECT_EQ(0, static_cast<int32_t>(diag.firstUseMap_.size()));
+    EXPECT_EQ(1, static_cast<int32_t>(diag.snapshot_.recordNum));
+    EXPECT_EQ(SAVE_BUTTON_FIRST_USE, diag.GetFirstUseCompTypes(1));
+    EXPECT_EQ(0, static_cast<int32_t>(diag.GetFirstUseCompTypes(2)));
+}
+
+/**
+ * @tc.name: LoadFirstUseRecord013
+ * @tc.desc: Test broken snapshot is not mapped
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(FirstUseDialogTest, LoadFirstUseRecord013, TestSize.Level0)
+{
+    std::string cmdline = "echo broken_first_use_snapshot > " + SEC_COMP_SRV_SNAPSHOT_FILE;
+    system(cmdline.c_str());
+    FirstUseDialog diag;
+    diag.LoadFirstUseRecord();
+    EXPECT_EQ(nullptr, diag.snapshot_.addr);
+    EXPECT_EQ(0, static_cast<int32_t>(diag.snapshot_.recordNum));
+    EXPECT_EQ(0, static_cast<int32_t>(diag.GetFirstUseCompTypes(1)));
 }
 
 class TestRemoteObject : public IRemoteObject {
@@ -415,6 +575,9 @@ HWTEST_F(FirstUseDialogTest, SetFirstUseMap001, TestSize.Level0)
     EXPECT_EQ(diag.SetFirstUseMap(entity), true);
     EXPECT_EQ(SAVE_BUTTON_FIRST_USE, static_cast<uint64_t>(diag.firstUseMap_[0]));
 
+    EXPECT_TRUE(diag.isFlushPosted_);
+    EXPECT_EQ(1, static_cast<int32_t>(diag.dirtyTokens_.size()));
+
     // second use save button
     EXPECT_EQ(diag.SetFirstUseMap(entity), true);
     EXPECT_EQ(SAVE_BUTTON_FIRST_USE, static_cast<uint64_t>(diag.firstUseMap_[0]));
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sec_comp_bundle_info_cache_test.h"
+
+#include "sec_comp_log.h"
+#include "service_test_common.h"
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::Security::SecurityComponent;
+
+namespace {
+static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
+    LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompBundleInfoCacheTest"};
+static constexpr int32_t BYPASS_TEST_UID = 99999;
+static constexpr int32_t TEST_CACHE_SIZE = 256;
+}
+
+void SecCompBundleInfoCacheTest::SetUpTestCase()
+{}
+
+void SecCompBundleInfoCacheTest::TearDownTestCase()
+{}
+
+void SecCompBundleInfoCacheTest::SetUp()
+{
+    SC_LOG_INFO(LABEL, "setup");
+}
+
+void SecCompBundleInfoCacheTest::TearDown()
+{
+    SecCompBundleInfoCache::GetInstance().bundleInfoMap_.clear();
+    SecCompBundleInfoCache::GetInstance().insertOrder_.clear();
+    SecCompBundleInfoCache::GetInstance().hitCount_ = 0;
+    SecCompBundleInfoCache::GetInstance().missCount_ = 0;
+}
+
+/**
+ * @tc.name: GetBundleName001
+ * @tc.desc: Test get bundle name from bms once and then from cache
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompBundleInfoCacheTest, GetBundleName001, TestSize.Level0)
+{
+    SecCompBundleInfoCache& cache = SecCompBundleInfoCache::GetInstance();
+    EXPECT_EQ("test.bypass", cache.GetBundleName(BYPASS_TEST_UID));
+    EXPECT_EQ(static_cast<uint64_t>(1), cache.missCount_.load());
+    EXPECT_EQ("test.bypass", cache.GetBundleName(BYPASS_TEST_UID));
+    EXPECT_EQ(static_cast<uint64_t>(1), cache.hitCount_.load());
+
+    cache.RemoveBundleInfo(BYPASS_TEST_UID);
+    EXPECT_TRUE(cache.bundleInfoMap_.empty());
+    EXPECT_TRUE(cache.insertOrder_.empty());
+    EXPECT_EQ("test.bypass", cache.GetBundleName(BYPASS_TEST_UID));
+    EXPECT_EQ(static_cast<uint64_t>(2), cache.missCount_.load());
+
+    std::string dumpStr;
+    cache.DumpBundleInfoCache(dumpStr);
+    EXPECT_NE(std::string::npos, dumpStr.find("hit:1, miss:2"));
+}
+
+/**
+ * @tc.name: UpdateBundleName001
+ * @tc.desc: Test bundle name filled by process state and evicted when cache is full
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompBundleInfoCacheTest, UpdateBundleName001, TestSize.Level0)
+{
+    SecCompBundleInfoCache& cache = SecCompBundleInfoCache::GetInstance();
+    cache.UpdateBundleName(ServiceTestCommon::TEST_UID_1, "");
+    EXPECT_TRUE(cache.bundleInfoMap_.empty());
+
+    cache.UpdateBundleName(ServiceTestCommon::TEST_UID_1, "com.example.test");
+    EXPECT_EQ("com.example.test", cache.GetBundleName(ServiceTestCommon::TEST_UID_1));
+    EXPECT_EQ(static_cast<uint64_t>(0), cache.missCount_.load());
+
+    SecCompBundleInfo info;
+    EXPECT_TRUE(cache.GetBundleInfo(ServiceTestCommon::TEST_UID_1, ServiceTestCommon::TEST_USER_ID, info));
+    EXPECT_EQ("com.example.test", info.bundleName);
+    EXPECT_TRUE(cache.GetBundleInfo(ServiceTestCommon::TEST_UID_1, ServiceTestCommon::TEST_USER_ID, info));
+    EXPECT_EQ(static_cast<uint64_t>(1), cache.missCount_.load());
+
+    for (int32_t i = 0; i < TEST_CACHE_SIZE; i++) {
+        cache.UpdateBundleName(ServiceTestCommon::TEST_UID_1 + i + 1, "com.example.test");
+    }
+    EXPECT_EQ(static_cast<size_t>(TEST_CACHE_SIZE), cache.bundleInfoMap_.size());
+    EXPECT_EQ(cache.bundleInfoMap_.end(), cache.bundleInfoMap_.find(ServiceTestCommon::TEST_UID_1));
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "sec_comp_latency_stats_test.h"
+
+#include "sec_comp_log.h"
+
+using namespace testing::ext;
+using namespace OHOS;
+using namespace OHOS::Security::SecurityComponent;
+
+namespace {
+static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
+    LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "SecCompLatencyStatsTest"};
+static constexpr uint64_t TEST_SAMPLE_NUM = 100;
+static constexpr uint64_t TEST_SLOW_SAMPLE = 5000;
+static constexpr uint64_t TEST_SAMPLE_SUM = 9950;
+static constexpr uint64_t TEST_MAX_LATENCY = 0x100000000;
+}
+
+void SecCompLatencyStatsTest::SetUpTestCase()
+{}
+
+void SecCompLatencyStatsTest::TearDownTestCase()
+{}
+
+void SecCompLatencyStatsTest::SetUp()
+{
+    SC_LOG_INFO(LABEL, "setup");
+}
+
+void SecCompLatencyStatsTest::TearDown()
+{
+    SecCompLatencyStats::GetInstance().Reset();
+}
+
+/**
+ * @tc.name: GetBucketIndex001
+ * @tc.desc: Test every value falls into a bucket whose bound is within one eighth above it
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompLatencyStatsTest, GetBucketIndex001, TestSize.Level0)
+{
+    for (uint64_t value : { 0ULL, 7ULL, 8ULL, 9ULL, 100ULL, 1023ULL, 1024ULL, 123456ULL, 0xFFFFFFFFULL }) {
+        uint32_t index = LatencyHistogram::GetBucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::BUCKET_NUM);
+        uint64_t upperBound = LatencyHistogram::GetBucketUpperBound(index);
+        EXPECT_GE(upperBound, value);
+        EXPECT_LE(upperBound - value, value / LatencyHistogram::SUB_BUCKET_NUM);
+    }
+    EXPECT_EQ(LatencyHistogram::BUCKET_NUM - 1, LatencyHistogram::GetBucketIndex(TEST_MAX_LATENCY));
+}
+
+/**
+ * @tc.name: GetPercentile001
+ * @tc.desc: Test percentiles and max of recorded latency
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompLatencyStatsTest, GetPercentile001, TestSize.Level0)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(0, histogram.GetPercentile(50));
+    for (uint64_t i = 1; i < TEST_SAMPLE_NUM; ++i) {
+        histogram.Record(i);
+    }
+    histogram.Record(TEST_SLOW_SAMPLE);
+
+    EXPECT_EQ(TEST_SAMPLE_NUM, histogram.GetCount());
+    EXPECT_EQ(TEST_SLOW_SAMPLE, histogram.GetMax());
+    EXPECT_EQ(TEST_SAMPLE_SUM, histogram.GetSum());
+    uint64_t p50 = histogram.GetPercentile(50);
+    EXPECT_GE(p50, 50);
+    EXPECT_LE(p50, 55);
+    EXPECT_GE(histogram.GetPercentile(99), 99);
+    EXPECT_EQ(TEST_SLOW_SAMPLE, histogram.GetPercentile(100));
+
+    histogram.Reset();
+    EXPECT_EQ(0, histogram.GetCount());
+    EXPECT_EQ(0, histogram.GetSum());
+    EXPECT_EQ(0, histogram.GetMax());
+}
+
+/**
+ * @tc.name: Merge001
+ * @tc.desc: Test merged histogram holds the samples of both histograms
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompLatencyStatsTest, Merge001, TestSize.Level0)
+{
+    LatencyHistogram fastHistogram;
+    LatencyHistogram slowHistogram;
+    for (uint64_t i = 1; i < TEST_SAMPLE_NUM; ++i) {
+        ((i <= TEST_SAMPLE_NUM / 2) ? fastHistogram : slowHistogram).Record(i);
+    }
+    slowHistogram.Record(TEST_SLOW_SAMPLE);
+
+    LatencyHistogram histogram;
+    histogram.Merge(slowHistogram);
+    histogram.Merge(fastHistogram);
+    EXPECT_EQ(TEST_SAMPLE_NUM, histogram.GetCount());
+    EXPECT_EQ(TEST_SAMPLE_SUM, histogram.GetSum());
+    // a smaller max merged later does not lower it
+    EXPECT_EQ(TEST_SLOW_SAMPLE, histogram.GetMax());
+    uint64_t p50 = histogram.GetPercentile(50);
+    EXPECT_GE(p50, 50);
+    EXPECT_LE(p50, 55);
+    EXPECT_GE(histogram.GetPercentile(99), 99);
+    EXPECT_EQ(TEST_SLOW_SAMPLE, histogram.GetPercentile(100));
+
+    fastHistogram.Merge(LatencyHistogram());
+    EXPECT_EQ(TEST_SAMPLE_NUM / 2, fastHistogram.GetCount());
+    EXPECT_EQ(TEST_SAMPLE_NUM / 2, fastHistogram.GetMax());
+}
+
+/**
+ * @tc.name: Record001
+ * @tc.desc: Test stages are only recorded inside an operation and dumped until reset
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompLatencyStatsTest, Record001, TestSize.Level0)
+{
+    SecCompLatencyStats& stats = SecCompLatencyStats::GetInstance();
+    {
+        LatencyStageTimer timer(LATENCY_STAGE_CHECK_RECT_INFO);
+    }
+    std::string dumpStr;
+    stats.Dump(dumpStr);
+    EXPECT_EQ(std::string::npos, dumpStr.find("checkRectInfo"));
+
+    {
+        LatencyOperationScope scope(LATENCY_OP_CLICK);
+        EXPECT_EQ(LATENCY_OP_CLICK, SecCompLatencyStats::GetCurrentOperation());
+        {
+            LatencyOperationScope nestedScope(LATENCY_OP_UPDATE);
+            LatencyStageTimer timer(LATENCY_STAGE_PARSE_INFO);
+        }
+        EXPECT_EQ(LATENCY_OP_CLICK, SecCompLatencyStats::GetCurrentOperation());
+        LatencyStageTimer timer(LATENCY_STAGE_CHECK_RECT_INFO);
+    }
+    {
+        LatencyOperationScope scope(LATENCY_OP_BATCH_UNREGISTER);
+    }
+    EXPECT_EQ(LATENCY_OP_BUTT, SecCompLatencyStats::GetCurrentOperation());
+    EXPECT_EQ(1, stats.histograms_[LATENCY_OP_CLICK][LATENCY_STAGE_TOTAL].GetCount());
+    EXPECT_EQ(1, stats.histograms_[LATENCY_OP_CLICK][LATENCY_STAGE_CHECK_RECT_INFO].GetCount());
+    EXPECT_EQ(0, stats.histograms_[LATENCY_OP_CLICK][LATENCY_STAGE_PARSE_INFO].GetCount());
+    EXPECT_EQ(1, stats.histograms_[LATENCY_OP_UPDATE][LATENCY_STAGE_PARSE_INFO].GetCount());
+
+    dumpStr.clear();
+    stats.Dump(dumpStr);
+    EXPECT_NE(std::string::npos, dumpStr.find("click.checkRectInfo: count 1"));
+    EXPECT_NE(std::string::npos, dumpStr.find("update.parseInfo: count 1"));
+    EXPECT_NE(std::string::npos, dumpStr.find("batchUnregister.total: count 1"));
+
+    stats.Reset();
+    dumpStr.clear();
+    stats.Dump(dumpStr);
+    EXPECT_EQ(std::string::npos, dumpStr.find("click.total"));
+}
+
+/**
+ * @tc.name: StartupPhase001
+ * @tc.desc: Test startup phase is recorded once and kept after reset
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompLatencyStatsTest, StartupPhase001, TestSize.Level0)
+{
+    SecCompLatencyStats& stats = SecCompLatencyStats::GetInstance();
+    stats.RecordStartupPhase(STARTUP_PHASE_PUBLISH, TEST_SLOW_SAMPLE);
+    EXPECT_EQ(TEST_SLOW_SAMPLE, stats.GetStartupPhase(STARTUP_PHASE_PUBLISH));
+    stats.RecordStartupPhase(STARTUP_PHASE_BUTT, TEST_SLOW_SAMPLE);
+    EXPECT_EQ(0, stats.GetStartupPhase(STARTUP_PHASE_BUTT));
+
+    {
+        StartupPhaseTimer timer(STARTUP_PHASE_PUBLISH);
+        timer.Finish();
+        EXPECT_GT(TEST_SLOW_SAMPLE, stats.GetStartupPhase(STARTUP_PHASE_PUBLISH));
+        stats.RecordStartupPhase(STARTUP_PHASE_PUBLISH, TEST_SLOW_SAMPLE);
+    }
+    // finished timer does not record again at destruction
+    EXPECT_EQ(TEST_SLOW_SAMPLE, stats.GetStartupPhase(STARTUP_PHASE_PUBLISH));
+
+    stats.Reset();
+    std::string dumpStr;
+    stats.Dump(dumpStr);
+    EXPECT_NE(std::string::npos, dumpStr.find("publish " + std::to_string(TEST_SLOW_SAMPLE)));
+    stats.RecordStartupPhase(STARTUP_PHASE_PUBLISH, 0);
+}
@@ -102,6 +102,13 @@ static SecCompOwnerInfo BuildOwnerInfo(AccessTokenID tokenId = ServiceTestCommon
 }
 
 static const int32_t SLEEP_TIME = 5;
+
+static void AddAppToMaliciousAppList(int32_t pid)
+{
+    for (uint32_t i = 0; i <= SecCompMaliciousApps::MAX_CONTINUOUS_ENHANCE_FAIL_COUNT; ++i) {
+        SecCompManager::GetInstance().malicious_.AddAppToMaliciousAppList(pid);
+    }
+}
 }
 
 void SecCompManagerTest::SetUpTestCase()
@@ -128,6 +135,7 @@ void SecCompManagerTest::SetUp()
 void SecCompManagerTest::TearDown()
 {
     SecCompManager::GetInstance().componentMap_.clear();
+    SecCompManager::GetInstance().ResetSlots();
 }
 
 
@@ -139,11 +147,18 @@ void SecCompManagerTest::TearDown()
  */
 HWTEST_F(SecCompManagerTest, CreateScId001, TestSize.Level0)
 {
-    SecCompManager::GetInstance().scIdStart_ = ServiceTestCommon::MAX_INT_NUM;
-    ASSERT_EQ(ServiceTestCommon::SC_ID_START, SecCompManager::GetInstance().CreateScId());
-
-    SecCompManager::GetInstance().scIdStart_ = ServiceTestCommon::SC_ID_START;
-    ASSERT_EQ(ServiceTestCommon::SC_ID_START + 1, SecCompManager::GetInstance().CreateScId());
+    int32_t scId = SecCompManager::GetInstance().CreateScId();
+    ASSERT_GE(scId, ServiceTestCommon::SC_ID_START);
+    int32_t scIdNew = SecCompManager::GetInstance().CreateScId();
+    ASSERT_GE(scIdNew, ServiceTestCommon::SC_ID_START);
+    ASSERT_NE(scId, scIdNew);
+
+    // released slot is reused with a new generation
+    SecCompManager::GetInstance().ReleaseScId(scId);
+    int32_t scIdReused = SecCompManager::GetInstance().CreateScId();
+    ASSERT_GE(scIdReused, ServiceTestCommon::SC_ID_START);
+    ASSERT_NE(scId, scIdReused);
+    ASSERT_NE(scIdNew, scIdReused);
 }
 
 /**
@@ -160,12 +175,21 @@ HWTEST_F(SecCompManagerTest, CreateScId002, TestSize.Level0)
     compPtr->rect_.y_ = ServiceTestCommon::TEST_COORDINATE;
     compPtr->rect_.width_ = ServiceTestCommon::TEST_COORDINATE;
     compPtr->rect_.height_ = ServiceTestCommon::TEST_COORDINATE;
+    int32_t scId = SecCompManager::GetInstance().CreateScId();
     std::shared_ptr<SecCompEntity> entity =
-        std::make_shared<SecCompEntity>(compPtr, ServiceTestCommon::SC_ID_START, BuildOwnerInfo());
+        std::make_shared<SecCompEntity>(compPtr, scId, BuildOwnerInfo());
     ASSERT_EQ(SC_OK, SecCompManager::GetInstance().AddSecurityComponentToList(1, 0, entity));
+    ASSERT_EQ(entity, SecCompManager::GetInstance().GetSecurityComponentFromList(1, scId));
+    ASSERT_EQ(nullptr, SecCompManager::GetInstance().GetSecurityComponentFromList(2, scId));
+
+    ASSERT_NE(scId, SecCompManager::GetInstance().CreateScId());
 
-    SecCompManager::GetInstance().scIdStart_ = ServiceTestCommon::MAX_INT_NUM;
-    ASSERT_EQ(ServiceTestCommon::SC_ID_START + 1, SecCompManager::GetInstance().CreateScId());
+    // stale scId can not find the entity after delete and slot reuse
+    ASSERT_EQ(SC_OK, SecCompManager::GetInstance().DeleteSecurityComponentFromList(1, scId));
+    ASSERT_EQ(nullptr, SecCompManager::GetInstance().GetSecurityComponentFromList(1, scId));
+    ASSERT_NE(scId, SecCompManager::GetInstance().CreateScId());
+    ASSERT_EQ(SC_SERVICE_ERROR_COMPONENT_NOT_EXIST,
+        SecCompManager::GetInstance().DeleteSecurityComponentFromList(1, scId));
 }
 
 /**
@@ -352,12 +376,11 @@ HWTEST_F(SecCompManagerTest, RegisterSecurityComponent001, TestSize.Level0)
         .userId = ServiceTestCommon::TEST_USER_ID
     };
     int32_t scId;
-    SecCompManager::GetInstance().malicious_.maliciousAppList_.insert(ServiceTestCommon::TEST_PID_1);
+    AddAppToMaliciousAppList(ServiceTestCommon::TEST_PID_1);
     nlohmann::json jsonInvalid;
     EXPECT_EQ(SC_ENHANCE_ERROR_IN_MALICIOUS_LIST,
         SecCompManager::GetInstance().RegisterSecurityComponent(LOCATION_COMPONENT, jsonInvalid, caller, scId));
-    SecCompManager::GetInstance().malicious_.maliciousAppList_.clear();
-    SecCompManager::GetInstance().malicious_.maliciousFailCountMap_.clear();
+    SecCompManager::GetInstance().malicious_.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
 
     LocationButton buttonInvalid = BuildInvalidLocationComponent();
     buttonInvalid.ToJson(jsonInvalid);
@@ -370,8 +393,64 @@ HWTEST_F(SecCompManagerTest, RegisterSecurityComponent001, TestSize.Level0)
 
     EXPECT_EQ(SC_OK,
         SecCompManager::GetInstance().RegisterSecurityComponent(LOCATION_COMPONENT, jsonValid, caller, scId));
-    SecCompManager::GetInstance().malicious_.maliciousAppList_.clear();
-    SecCompManager::GetInstance().malicious_.maliciousFailCountMap_.clear();
+    SecCompManager::GetInstance().malicious_.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
+}
+
+/**
+ * @tc.name: RegisterSecurityComponents001
+ * @tc.desc: Test register and unregister security components in batch
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompManagerTest, RegisterSecurityComponents001, TestSize.Level0)
+{
+    SecCompCallerInfo caller = {
+        .tokenId = ServiceTestCommon::TEST_TOKEN_ID,
+        .uid = 1,
+        .pid = ServiceTestCommon::TEST_PID_1,
+        .userId = ServiceTestCommon::TEST_USER_ID
+    };
+    nlohmann::json jsonValid;
+    BuildValidLocationComponent().ToJson(jsonValid);
+    nlohmann::json jsonInvalid;
+    BuildInvalidLocationComponent().ToJson(jsonInvalid);
+    std::vector<SecCompRegisterItem> items(3);
+    for (auto& item : items) {
+        item.type = LOCATION_COMPONENT;
+    }
+    items[2].result = SC_SERVICE_ERROR_VALUE_INVALID;
+    std::vector<SecCompInfoPayload> infos = { jsonValid, jsonInvalid, jsonValid };
+    std::vector<SecCompInfoPayload> infoMismatch = { jsonValid };
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID,
+        SecCompManager::GetInstance().RegisterSecurityComponents(items, infoMismatch, caller));
+
+    EXPECT_EQ(SC_OK, SecCompManager::GetInstance().RegisterSecurityComponents(items, infos, caller));
+    EXPECT_EQ(SC_OK, items[0].result);
+    EXPECT_NE(INVALID_SC_ID, items[0].scId);
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_INFO_INVALID, items[1].result);
+    EXPECT_EQ(INVALID_SC_ID, items[1].scId);
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, items[2].result);
+    EXPECT_EQ(INVALID_SC_ID, items[2].scId);
+    EXPECT_NE(nullptr,
+        SecCompManager::GetInstance().GetSecurityComponentFromList(ServiceTestCommon::TEST_PID_1, items[0].scId));
+
+    std::vector<int32_t> results;
+    SecCompManager::GetInstance().UnregisterSecurityComponents({ items[0].scId, items[1].scId }, caller, results);
+    ASSERT_EQ(2u, results.size());
+    EXPECT_EQ(SC_OK, results[0]);
+    EXPECT_NE(SC_OK, results[1]);
+    EXPECT_EQ(nullptr,
+        SecCompManager::GetInstance().GetSecurityComponentFromList(ServiceTestCommon::TEST_PID_1, items[0].scId));
+
+    AddAppToMaliciousAppList(ServiceTestCommon::TEST_PID_1);
+    items[0].result = SC_OK;
+    items[1].result = SC_OK;
+    EXPECT_EQ(SC_OK, SecCompManager::GetInstance().RegisterSecurityComponents(items, infos, caller));
+    EXPECT_EQ(SC_ENHANCE_ERROR_IN_MALICIOUS_LIST, items[0].result);
+    EXPECT_EQ(INVALID_SC_ID, items[0].scId);
+    EXPECT_EQ(SC_ENHANCE_ERROR_IN_MALICIOUS_LIST, items[1].result);
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, items[2].result);
+    SecCompManager::GetInstance().malicious_.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
 }
 
 /**
@@ -382,7 +461,7 @@ HWTEST_F(SecCompManagerTest, RegisterSecurityComponent001, TestSize.Level0)
  */
 HWTEST_F(SecCompManagerTest, UpdateSecurityComponent001, TestSize.Level0)
 {
-    SecCompManager::GetInstance().malicious_.maliciousAppList_.insert(ServiceTestCommon::TEST_PID_1);
+    AddAppToMaliciousAppList(ServiceTestCommon::TEST_PID_1);
     nlohmann::json jsonValid;
     LocationButton buttonValid = BuildValidLocationComponent();
     buttonValid.ToJson(jsonValid);
@@ -392,10 +471,10 @@ HWTEST_F(SecCompManagerTest, UpdateSecurityComponent001, TestSize.Level0)
         .pid = ServiceTestCommon::TEST_PID_1,
         .userId = ServiceTestCommon::TEST_USER_ID
     };
-    EXPECT_EQ(SC_ENHANCE_ERROR_IN_MALICIOUS_LIST,
-        SecCompManager::GetInstance().UpdateSecurityComponent(ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller));
-    SecCompManager::GetInstance().malicious_.maliciousAppList_.clear();
-    SecCompManager::GetInstance().malicious_.maliciousFailCountMap_.clear();
+    uint32_t version = 0;
+    EXPECT_EQ(SC_ENHANCE_ERROR_IN_MALICIOUS_LIST, SecCompManager::GetInstance().UpdateSecurityComponent(
+        ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller, version));
+    SecCompManager::GetInstance().malicious_.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
 
     std::shared_ptr<LocationButton> compPtr = std::make_shared<LocationButton>();
     compPtr->type_ = LOCATION_COMPONENT;
@@ -408,14 +487,13 @@ HWTEST_F(SecCompManagerTest, UpdateSecurityComponent001, TestSize.Level0)
     nlohmann::json jsonInvalid;
     LocationButton buttonInvalid = BuildInvalidLocationComponent();
     buttonInvalid.ToJson(jsonInvalid);
-    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_INFO_INVALID,
-        SecCompManager::GetInstance().UpdateSecurityComponent(ServiceTestCommon::TEST_SC_ID_1, jsonInvalid, caller));
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_INFO_INVALID, SecCompManager::GetInstance().UpdateSecurityComponent(
+        ServiceTestCommon::TEST_SC_ID_1, jsonInvalid, caller, version));
 
     // no enhance data
-    EXPECT_EQ(SC_OK,
-        SecCompManager::GetInstance().UpdateSecurityComponent(ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller));
-    SecCompManager::GetInstance().malicious_.maliciousAppList_.clear();
-    SecCompManager::GetInstance().malicious_.maliciousFailCountMap_.clear();
+    EXPECT_EQ(SC_OK, SecCompManager::GetInstance().UpdateSecurityComponent(
+        ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller, version));
+    SecCompManager::GetInstance().malicious_.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
 }
 
 /**
@@ -472,14 +550,20 @@ HWTEST_F(SecCompManagerTest, AddSecurityComponentToList004, TestSize.Level0)
     std::shared_ptr<SecCompManager> managerInstance = std::make_shared<SecCompManager>();
     managerInstance->isSaExit_ = false;
     int pid = 1;
-    std::shared_ptr<SecCompEntity> entity =
-        std::make_shared<SecCompEntity>(nullptr, 0, BuildOwnerInfo(0));
     const int MAX_COMPONENT_SIZE = 500;
     for (int i = 0; i < MAX_COMPONENT_SIZE; i++) {
-        managerInstance->componentMap_[pid].compList.emplace_back(entity);
+        std::shared_ptr<SecCompEntity> entity =
+            std::make_shared<SecCompEntity>(nullptr, managerInstance->CreateScId(), BuildOwnerInfo(0));
+        ASSERT_EQ(SC_OK, managerInstance->AddSecurityComponentToList(pid, 0, entity));
     }
+    ASSERT_EQ(static_cast<size_t>(MAX_COMPONENT_SIZE), managerInstance->componentMap_[pid]->compCount);
 
+    std::shared_ptr<SecCompEntity> entity =
+        std::make_shared<SecCompEntity>(nullptr, managerInstance->CreateScId(), BuildOwnerInfo(0));
     ASSERT_NE(managerInstance->AddSecurityComponentToList(pid, 0, entity), SC_SERVICE_ERROR_VALUE_INVALID);
+
+    managerInstance->NotifyProcessDied(pid, true);
+    ASSERT_EQ(managerInstance->freeSlots_.size(), managerInstance->slotCount_.load());
 }
 
 /**
@@ -579,14 +663,81 @@ HWTEST_F(SecCompManagerTest, UpdateSecurityComponent002, TestSize.Level0)
         .pid = ServiceTestCommon::TEST_PID_1,
         .userId = ServiceTestCommon::TEST_USER_ID
     };
+    uint32_t version = 0;
     ASSERT_NE(SC_SERVICE_ERROR_COMPONENT_INFO_INVALID, SecCompManager::GetInstance().UpdateSecurityComponent(
-        ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller));
+        ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller, version));
 
     SecCompManager::GetInstance().malicious_.AddAppToMaliciousAppList(ServiceTestCommon::TEST_PID_1);
     LocationButton buttonValid = BuildValidLocationComponent();
     buttonValid.ToJson(jsonValid);
     ASSERT_NE(SC_ENHANCE_ERROR_IN_MALICIOUS_LIST, SecCompManager::GetInstance().UpdateSecurityComponent(
-        ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller));
+        ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller, version));
+}
+
+/**
+ * @tc.name: UpdateSecurityComponentDelta001
+ * @tc.desc: Test update security component with delta
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompManagerTest, UpdateSecurityComponentDelta001, TestSize.Level0)
+{
+    nlohmann::json jsonValid;
+    LocationButton buttonValid = BuildValidLocationComponent();
+    buttonValid.ToJson(jsonValid);
+    SecCompCallerInfo caller = {
+        .tokenId = ServiceTestCommon::TEST_TOKEN_ID,
+        .uid = 1,
+        .pid = ServiceTestCommon::TEST_PID_1,
+        .userId = ServiceTestCommon::TEST_USER_ID
+    };
+    std::shared_ptr<SecCompEntity> entity = std::make_shared<SecCompEntity>(
+        std::make_shared<LocationButton>(buttonValid), ServiceTestCommon::TEST_SC_ID_1, BuildOwnerInfo());
+    ASSERT_EQ(SC_OK,
+        SecCompManager::GetInstance().AddSecurityComponentToList(ServiceTestCommon::TEST_PID_1, 0, entity));
+    uint32_t version = 0;
+    ASSERT_EQ(SC_OK, SecCompManager::GetInstance().UpdateSecurityComponent(
+        ServiceTestCommon::TEST_SC_ID_1, jsonValid, caller, version));
+    bool isValid = entity->componentInfo_->GetValid();
+
+    nlohmann::json jsonDelta;
+    jsonDelta[JsonTagConstants::JSON_BASE_VERSION_TAG] = version;
+    jsonDelta[JsonTagConstants::JSON_RECT] = jsonValid[JsonTagConstants::JSON_RECT];
+    jsonDelta[JsonTagConstants::JSON_RECT][JsonTagConstants::JSON_RECT_X] = ServiceTestCommon::TEST_COORDINATE + 1;
+    // rect without windowRect
+    uint32_t newVersion = 0;
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_INFO_INVALID, SecCompManager::GetInstance().UpdateSecurityComponentDelta(
+        ServiceTestCommon::TEST_SC_ID_1, jsonDelta, caller, newVersion));
+
+    jsonDelta[JsonTagConstants::JSON_WINDOW_RECT] = jsonValid[JsonTagConstants::JSON_WINDOW_RECT];
+    EXPECT_EQ(SC_OK, SecCompManager::GetInstance().UpdateSecurityComponentDelta(
+        ServiceTestCommon::TEST_SC_ID_1, jsonDelta, caller, newVersion));
+    EXPECT_EQ(version + 1, newVersion);
+    EXPECT_EQ(ServiceTestCommon::TEST_COORDINATE + 1, entity->componentInfo_->rect_.x_);
+    EXPECT_EQ(isValid, entity->componentInfo_->GetValid());
+
+    // stale base version
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL, SecCompManager::GetInstance().UpdateSecurityComponentDelta(
+        ServiceTestCommon::TEST_SC_ID_1, jsonDelta, caller, newVersion));
+
+    // the raw rect is adjusted again by the window even if the delta carries no rect
+    entity->componentInfo_->rect_.x_ = ServiceTestCommon::TEST_COORDINATE + 2;
+    jsonDelta.erase(JsonTagConstants::JSON_RECT);
+    jsonDelta.erase(JsonTagConstants::JSON_WINDOW_RECT);
+    jsonDelta[JsonTagConstants::JSON_BASE_VERSION_TAG] = newVersion;
+    EXPECT_EQ(SC_OK, SecCompManager::GetInstance().UpdateSecurityComponentDelta(
+        ServiceTestCommon::TEST_SC_ID_1, jsonDelta, caller, newVersion));
+    EXPECT_EQ(ServiceTestCommon::TEST_COORDINATE + 1, entity->componentInfo_->rect_.x_);
+
+    // style can not be carried by delta
+    jsonDelta[JsonTagConstants::JSON_BASE_VERSION_TAG] = newVersion;
+    jsonDelta[JsonTagConstants::JSON_STYLE_TAG] = jsonValid[JsonTagConstants::JSON_STYLE_TAG];
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_INFO_INVALID, SecCompManager::GetInstance().UpdateSecurityComponentDelta(
+        ServiceTestCommon::TEST_SC_ID_1, jsonDelta, caller, newVersion));
+
+    jsonDelta.erase(JsonTagConstants::JSON_BASE_VERSION_TAG);
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, SecCompManager::GetInstance().UpdateSecurityComponentDelta(
+        ServiceTestCommon::TEST_SC_ID_1, jsonDelta, caller, newVersion));
 }
 
 /**
@@ -681,8 +832,7 @@ HWTEST_F(SecCompManagerTest, ExitWhenAppMgrDied001, TestSize.Level0)
  */
 HWTEST_F(SecCompManagerTest, SendCheckInfoEnhanceSysEvent001, TestSize.Level0)
 {
-    SecCompManager::GetInstance().malicious_.maliciousAppList_.clear();
-    SecCompManager::GetInstance().malicious_.maliciousFailCountMap_.clear();
+    SecCompManager::GetInstance().malicious_.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
     ASSERT_TRUE(SecCompManager::GetInstance().malicious_.IsMaliciousAppListEmpty());
     int32_t scId = INVALID_SC_ID;
     const std::string scene = "";
@@ -740,6 +890,40 @@ HWTEST_F(SecCompManagerTest, MaliciousAppListThreshold002, TestSize.Level0)
     SecCompManager::GetInstance().malicious_.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
 }
 
+/**
+ * @tc.name: MaliciousAppListThreshold003
+ * @tc.desc: Test failures older than the time window decay and process died clears the record
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompManagerTest, MaliciousAppListThreshold003, TestSize.Level0)
+{
+    constexpr int32_t TEST_UID = 1;
+    SecCompMaliciousApps& malicious = SecCompManager::GetInstance().malicious_;
+    malicious.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
+
+    malicious.AddAppToMaliciousAppList(ServiceTestCommon::TEST_PID_1);
+    auto record = malicious.FindRecord(ServiceTestCommon::TEST_PID_1);
+    ASSERT_NE(nullptr, record);
+    // pretend the failures happened long ago
+    record->failState.store(SecCompMaliciousApps::PackFailState(1,
+        SecCompMaliciousApps::MAX_CONTINUOUS_ENHANCE_FAIL_COUNT));
+    malicious.AddAppToMaliciousAppList(ServiceTestCommon::TEST_PID_1);
+    ASSERT_FALSE(malicious.IsInMaliciousAppList(ServiceTestCommon::TEST_PID_1, TEST_UID));
+    ASSERT_EQ(static_cast<uint32_t>(2), record->totalFailCount.load());
+
+    AddAppToMaliciousAppList(ServiceTestCommon::TEST_PID_1);
+    ASSERT_TRUE(malicious.IsInMaliciousAppList(ServiceTestCommon::TEST_PID_1, TEST_UID));
+    ASSERT_FALSE(malicious.IsInMaliciousAppList(ServiceTestCommon::TEST_PID_1, 0));
+    std::string dumpStr;
+    malicious.Dump(dumpStr);
+    ASSERT_NE(std::string::npos, dumpStr.find("isMalicious:1"));
+
+    SecCompManager::GetInstance().NotifyProcessDied(ServiceTestCommon::TEST_PID_1, false);
+    ASSERT_EQ(nullptr, malicious.FindRecord(ServiceTestCommon::TEST_PID_1));
+    ASSERT_TRUE(malicious.IsMaliciousAppListEmpty());
+}
+
 /**
  * @tc.name: DumpSecComp001
  * @tc.desc: Test check DumpSecComp
@@ -1230,3 +1414,144 @@ HWTEST_F(SecCompManagerTest, CheckClickSecurityComponentInfo004, TestSize.Level0
         secCompInfo, jsonValid, caller, remote, message));
     SecCompManager::GetInstance().malicious_.RemoveAppFromMaliciousAppList(ServiceTestCommon::TEST_PID_1);
 }
+
+/**
+ * @tc.name: ProcessCompInfosRemoved001
+ * @tc.desc: Test process lock holder can not use components of a died process
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompManagerTest, ProcessCompInfosRemoved001, TestSize.Level0)
+{
+    std::shared_ptr<LocationButton> compPtr = std::make_shared<LocationButton>();
+    ASSERT_NE(nullptr, compPtr);
+    int32_t scId = SecCompManager::GetInstance().CreateScId();
+    std::shared_ptr<SecCompEntity> entity = std::make_shared<SecCompEntity>(compPtr, scId, BuildOwnerInfo());
+    ASSERT_EQ(SC_OK,
+        SecCompManager::GetInstance().AddSecurityComponentToList(ServiceTestCommon::TEST_PID_1, 0, entity));
+    std::shared_ptr<ProcessCompInfos> info =
+        SecCompManager::GetInstance().GetProcessCompInfos(ServiceTestCommon::TEST_PID_1);
+    ASSERT_NE(nullptr, info);
+    ASSERT_EQ(nullptr, SecCompManager::GetInstance().GetProcessCompInfos(ServiceTestCommon::TEST_PID_2));
+
+    SecCompManager::GetInstance().NotifyProcessDied(ServiceTestCommon::TEST_PID_1, true);
+    EXPECT_TRUE(info->isRemoved);
+    EXPECT_EQ(static_cast<size_t>(0), info->compCount);
+    EXPECT_EQ(nullptr, SecCompManager::GetInstance().GetProcessCompInfos(ServiceTestCommon::TEST_PID_1));
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_NOT_EXIST, SecCompManager::GetInstance().DeleteSecurityComponentFromList(
+        ServiceTestCommon::TEST_PID_1, scId));
+
+    // pid reused by a new process gets a new process info
+    std::shared_ptr<SecCompEntity> entityNew = std::make_shared<SecCompEntity>(compPtr,
+        SecCompManager::GetInstance().CreateScId(), BuildOwnerInfo());
+    ASSERT_EQ(SC_OK,
+        SecCompManager::GetInstance().AddSecurityComponentToList(ServiceTestCommon::TEST_PID_1, 0, entityNew));
+    EXPECT_NE(info, SecCompManager::GetInstance().GetProcessCompInfos(ServiceTestCommon::TEST_PID_1));
+    EXPECT_EQ(nullptr, SecCompManager::GetInstance().GetSecurityComponentFromList(
+        ServiceTestCommon::TEST_PID_1, scId));
+}
+
+/**
+ * @tc.name: CommitSecurityComponent001
+ * @tc.desc: Test commit staged security component with version check, unchanged info keeps the version
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompManagerTest, CommitSecurityComponent001, TestSize.Level0)
+{
+    std::shared_ptr<LocationButton> compPtr = std::make_shared<LocationButton>();
+    ASSERT_NE(nullptr, compPtr);
+    int32_t scId = SecCompManager::GetInstance().CreateScId();
+    std::shared_ptr<SecCompEntity> entity = std::make_shared<SecCompEntity>(compPtr, scId, BuildOwnerInfo());
+    ASSERT_EQ(SC_OK,
+        SecCompManager::GetInstance().AddSecurityComponentToList(ServiceTestCommon::TEST_PID_1, 0, entity));
+    std::shared_ptr<ProcessCompInfos> info =
+        SecCompManager::GetInstance().GetProcessCompInfos(ServiceTestCommon::TEST_PID_1);
+    ASSERT_NE(nullptr, info);
+
+    std::shared_ptr<SecCompEntity> staged =
+        SecCompManager::GetInstance().SnapshotSecurityComponent(*info, ServiceTestCommon::TEST_PID_1, scId);
+    std::shared_ptr<SecCompEntity> stagedOld =
+        SecCompManager::GetInstance().SnapshotSecurityComponent(*info, ServiceTestCommon::TEST_PID_1, scId);
+    ASSERT_NE(nullptr, staged);
+    ASSERT_NE(entity, staged);
+    // same info reported again keeps the component and its version
+    uint32_t version = entity->version_;
+    std::shared_ptr<SecCompBase> baseInfo = staged->componentInfo_;
+    staged->componentInfo_ = std::make_shared<LocationButton>();
+    EXPECT_EQ(SC_OK, SecCompManager::GetInstance().CommitSecurityComponent(
+        *info, ServiceTestCommon::TEST_PID_1, staged, baseInfo, true));
+    EXPECT_EQ(compPtr, entity->componentInfo_);
+    EXPECT_EQ(version, entity->version_);
+
+    staged->componentInfo_ = std::make_shared<LocationButton>();
+    staged->componentInfo_->fontSize_ = ServiceTestCommon::TEST_SIZE;
+    EXPECT_EQ(SC_OK, SecCompManager::GetInstance().CommitSecurityComponent(
+        *info, ServiceTestCommon::TEST_PID_1, staged, baseInfo, true));
+    EXPECT_EQ(staged->componentInfo_, entity->componentInfo_);
+    EXPECT_EQ(version + 1, entity->version_);
+
+    // entity changed after snapshot, an unchanged report still replaces the newer info
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL, SecCompManager::GetInstance().CommitSecurityComponent(
+        *info, ServiceTestCommon::TEST_PID_1, stagedOld, baseInfo, true));
+    EXPECT_EQ(SC_OK, SecCompManager::GetInstance().CommitSecurityComponent(
+        *info, ServiceTestCommon::TEST_PID_1, stagedOld, baseInfo, false));
+    EXPECT_EQ(compPtr, entity->componentInfo_);
+    EXPECT_EQ(version + 2, entity->version_); // 2: changed by two commits
+
+    stagedOld->SetGrant(true);
+    SecCompManager::GetInstance().CommitGrantState(*info, ServiceTestCommon::TEST_PID_1, stagedOld);
+    EXPECT_TRUE(entity->IsGrant());
+
+    // grant made by the dialog on its snapshot
+    entity->SetGrant(false);
+    SecCompManager::GetInstance().CommitDialogGrantState(stagedOld);
+    EXPECT_TRUE(entity->IsGrant());
+
+    // entity unregistered after snapshot
+    ASSERT_EQ(SC_OK,
+        SecCompManager::GetInstance().DeleteSecurityComponentFromList(ServiceTestCommon::TEST_PID_1, scId));
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_NOT_EXIST, SecCompManager::GetInstance().CommitSecurityComponent(
+        *info, ServiceTestCommon::TEST_PID_1, staged, baseInfo, true));
+}
+
+/**
+ * @tc.name: StartDeferredInit001
+ * @tc.desc: Test deferred init runs once, clicks wait for it from before publish and fail retryably on timeout
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompManagerTest, StartDeferredInit001, TestSize.Level0)
+{
+    SecCompManager& manager = SecCompManager::GetInstance();
+    // service started without deferred steps has nothing to wait for
+    manager.deferredInitState_ = SecCompManager::DEFERRED_INIT_NOT_START;
+    EXPECT_TRUE(manager.WaitForDeferredInit());
+
+    std::shared_ptr<SecEventHandler> secHandler = manager.secHandler_;
+    manager.secHandler_ = nullptr;
+    int32_t finishNum = 0;
+    std::function<void ()> finishFunc = [&finishNum]() {
+        ++finishNum;
+    };
+    manager.StartDeferredInit(finishFunc);
+    EXPECT_EQ(1, finishNum);
+    EXPECT_EQ(SecCompManager::DEFERRED_INIT_DONE, manager.deferredInitState_);
+    EXPECT_TRUE(manager.WaitForDeferredInit());
+
+    manager.StartDeferredInit(finishFunc);
+    EXPECT_EQ(1, finishNum);
+
+    // prepared before publish but not started yet
+    manager.deferredInitState_ = SecCompManager::DEFERRED_INIT_NOT_START;
+    manager.isDeferredInitPosted_ = false;
+    manager.PrepareDeferredInit();
+    EXPECT_EQ(SecCompManager::DEFERRED_INIT_RUNNING, manager.deferredInitState_);
+    EXPECT_FALSE(manager.WaitForDeferredInit());
+    manager.StartDeferredInit(finishFunc);
+    EXPECT_EQ(2, finishNum);
+    EXPECT_TRUE(manager.WaitForDeferredInit());
+    manager.deferredInitState_ = SecCompManager::DEFERRED_INIT_NOT_START;
+    manager.isDeferredInitPosted_ = false;
+    manager.secHandler_ = secHandler;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -55,7 +55,7 @@ HWTEST_F(SecCompPermManagerTest, DelaySaveRevokePermission001, TestSize.Level0)
 {
     SecCompPermManager permMgr;
     permMgr.secHandler_ = nullptr;
-    ASSERT_FALSE(permMgr.DelaySaveRevokePermission(static_cast<AccessTokenID>(0), ""));
+    ASSERT_FALSE(permMgr.DelaySaveRevokePermission(static_cast<AccessTokenID>(0), 0));
 }
 
 /**
@@ -68,7 +68,7 @@ HWTEST_F(SecCompPermManagerTest, RevokeSavePermissionTask001, TestSize.Level0)
 {
     SecCompPermManager permMgr;
     permMgr.secHandler_ = nullptr;
-    ASSERT_FALSE(permMgr.RevokeSavePermissionTask(""));
+    ASSERT_FALSE(permMgr.RevokeSavePermissionTask(static_cast<AccessTokenID>(0)));
 }
 
 /**
@@ -98,14 +98,20 @@ HWTEST_F(SecCompPermManagerTest, RevokeTempSavePermissionCount001, TestSize.Leve
     AccessTokenID id = 0;
     permMgr.RevokeTempSavePermissionCount(id);
 
-    permMgr.applySaveCountMap_[id] = 1;
-    permMgr.RevokeTempSavePermissionCount(static_cast<AccessTokenID>(0));
-    permMgr.saveTaskDequeMap_[id].push_back("test");
-    permMgr.RevokeTempSavePermissionCount(static_cast<AccessTokenID>(0));
+    // expired lease is dropped and unpublished
+    permMgr.saveLeaseMap_[id].expiries.push_back(1);
+    permMgr.PublishSaveExpiry(id, 1);
+    permMgr.RevokeTempSavePermissionCount(id);
+    ASSERT_EQ(permMgr.saveLeaseMap_.count(id), static_cast<size_t>(0));
+    ASSERT_EQ(permMgr.saveExpiryMap_->count(id), static_cast<size_t>(0));
 
-    permMgr.secHandler_ = std::make_shared<SecEventHandler>(nullptr);
-    permMgr.RevokeTempSavePermissionCount(static_cast<AccessTokenID>(0));
-    ASSERT_EQ(permMgr.applySaveCountMap_[id], 0);
+    // lease still valid is kept, timer can not be posted again without handler
+    permMgr.saveLeaseMap_[id].expiries.push_back(1);
+    permMgr.saveLeaseMap_[id].expiries.push_back(INT64_MAX);
+    permMgr.saveLeaseMap_[id].isTimerPosted = true;
+    permMgr.RevokeTempSavePermissionCount(id);
+    ASSERT_EQ(permMgr.saveLeaseMap_[id].expiries.size(), static_cast<size_t>(1));
+    ASSERT_FALSE(permMgr.saveLeaseMap_[id].isTimerPosted);
 }
 
 /**
@@ -119,15 +125,38 @@ HWTEST_F(SecCompPermManagerTest, RevokeTempSavePermission001, TestSize.Level0)
     SecCompPermManager permMgr;
     permMgr.secHandler_ = nullptr;
     AccessTokenID id = 0;
-    permMgr.saveTaskDequeMap_[id].push_back("test");
+    permMgr.saveLeaseMap_[id].isTimerPosted = true;
     permMgr.RevokeTempSavePermission(id);
-    ASSERT_EQ(permMgr.saveTaskDequeMap_[id].size(), static_cast<size_t>(0));
+    ASSERT_EQ(permMgr.saveLeaseMap_.count(id), static_cast<size_t>(0));
 
     permMgr.secHandler_ = std::make_shared<SecEventHandler>(nullptr);
-    permMgr.saveTaskDequeMap_[id].push_back("test1");
+    ASSERT_EQ(SC_OK, permMgr.GrantTempSavePermission(id));
+    ASSERT_EQ(SC_OK, permMgr.GrantTempSavePermission(id));
+    ASSERT_EQ(permMgr.saveLeaseMap_[id].expiries.size(), static_cast<size_t>(2));
+    ASSERT_TRUE(permMgr.VerifySavePermission(id));
     permMgr.RevokeTempSavePermission(id);
     permMgr.CancelAppRevokingPermisions(id);
-    ASSERT_EQ(permMgr.saveTaskDequeMap_[id].size(), static_cast<size_t>(0));
+    ASSERT_EQ(permMgr.saveLeaseMap_.count(id), static_cast<size_t>(0));
+    ASSERT_FALSE(permMgr.VerifySavePermission(id));
+}
+
+/**
+ * @tc.name: VerifySavePermission001
+ * @tc.desc: Test save permission is not granted once the published expiry has passed
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompPermManagerTest, VerifySavePermission001, TestSize.Level0)
+{
+    SecCompPermManager permMgr;
+    AccessTokenID id = 1000;
+    ASSERT_FALSE(permMgr.VerifySavePermission(id));
+    permMgr.PublishSaveExpiry(id, INT64_MAX);
+    ASSERT_TRUE(permMgr.VerifySavePermission(id));
+    permMgr.PublishSaveExpiry(id, 1);
+    ASSERT_FALSE(permMgr.VerifySavePermission(id));
+    permMgr.UnpublishSaveExpiry(id);
+    ASSERT_EQ(permMgr.saveExpiryMap_->count(id), static_cast<size_t>(0));
 }
 
 /**
@@ -140,11 +169,76 @@ HWTEST_F(SecCompPermManagerTest, RemoveAppGrantPermissionRecord001, TestSize.Lev
 {
     SecCompPermManager permMgr;
     AccessTokenID id = 0;
-    permMgr.RemoveAppGrantPermissionRecord(id, "test");
+    permMgr.RemoveAppGrantPermissionRecord(id, PERMISSION_BIT_SECURE_PASTE);
+
+    permMgr.AddAppGrantPermissionRecord(id, PERMISSION_BIT_LOCATION | PERMISSION_BIT_SECURE_PASTE);
+    permMgr.RemoveAppGrantPermissionRecord(id, PERMISSION_BIT_SECURE_PASTE);
+    ASSERT_EQ(permMgr.grantMap_[id], static_cast<uint32_t>(PERMISSION_BIT_LOCATION));
+    permMgr.RemoveAppGrantPermissionRecord(id, PERMISSION_BIT_LOCATION);
+    ASSERT_EQ(permMgr.grantMap_.count(id), static_cast<size_t>(0));
+}
+
+/**
+ * @tc.name: GrantAppPermission001
+ * @tc.desc: Test a grant record revoked outside is granted again and revoke all clears the record
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompPermManagerTest, GrantAppPermission001, TestSize.Level0)
+{
+    SecCompPermManager permMgr;
+    AccessTokenID id = 1000;
+    ASSERT_EQ(SC_OK, permMgr.GrantAppPermission(id, "ohos.permission.SECURE_PASTE"));
+    ASSERT_EQ(SC_OK, permMgr.GrantAppPermission(id, "ohos.permission.LOCATION"));
+    ASSERT_EQ(permMgr.grantMap_[id], static_cast<uint32_t>(PERMISSION_BIT_SECURE_PASTE | PERMISSION_BIT_LOCATION));
+
+    // the record says granted but access token does not, so the grant reaches access token again
+    AccessTokenKit::RevokePermission(id, "ohos.permission.SECURE_PASTE", 0);
+    ASSERT_EQ(SC_OK, permMgr.GrantAppPermission(id, "ohos.permission.SECURE_PASTE"));
+    ASSERT_EQ(0, AccessTokenKit::VerifyAccessToken(id, "ohos.permission.SECURE_PASTE"));
+
+    permMgr.RevokeAppPermisionsImmediately(id);
+    ASSERT_EQ(permMgr.grantMap_.count(id), static_cast<size_t>(0));
+    ASSERT_NE(0, AccessTokenKit::VerifyAccessToken(id, "ohos.permission.LOCATION"));
+    ASSERT_EQ(SC_OK, permMgr.GrantAppPermission(id, "ohos.permission.SECURE_PASTE"));
+    ASSERT_EQ(0, AccessTokenKit::VerifyAccessToken(id, "ohos.permission.SECURE_PASTE"));
+    permMgr.RevokeAppPermissions(id);
+}
+
+/**
+ * @tc.name: GrantAppPermission002
+ * @tc.desc: Test a held grant is trusted once revokes made outside are watched
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompPermManagerTest, GrantAppPermission002, TestSize.Level0)
+{
+    SecCompPermManager permMgr;
+    AccessTokenID id = 1000;
+    AccessTokenKit::registerPermStateChangeCallbackRes = -1;
+    permMgr.RegisterPermStateCallback();
+    ASSERT_FALSE(permMgr.isPermStateWatched_.load());
+    AccessTokenKit::registerPermStateChangeCallbackRes = 0;
+    permMgr.RegisterPermStateCallback();
+    ASSERT_TRUE(permMgr.isPermStateWatched_.load());
+    ASSERT_NE(nullptr, permMgr.permStateCallback_);
+
+    ASSERT_EQ(SC_OK, permMgr.GrantAppPermission(id, "ohos.permission.SECURE_PASTE"));
+    // held records are not confirmed by access token any more
+    AccessTokenKit::RevokePermission(id, "ohos.permission.SECURE_PASTE", 0);
+    ASSERT_EQ(SC_OK, permMgr.GrantAppPermission(id, "ohos.permission.SECURE_PASTE"));
+    ASSERT_NE(0, AccessTokenKit::VerifyAccessToken(id, "ohos.permission.SECURE_PASTE"));
 
-    permMgr.grantMap_[id].insert("test");
-    permMgr.RemoveAppGrantPermissionRecord(id, "test");
-    ASSERT_EQ(permMgr.grantMap_[id].size(), static_cast<size_t>(0));
+    // grants do not touch the record, a revoke clears it and the next click grants again
+    PermStateChangeInfo info = { 1, id, "ohos.permission.SECURE_PASTE" };
+    permMgr.permStateCallback_->PermStateChangeCallback(info);
+    permMgr.OnPermissionRevoked(id, "test");
+    ASSERT_EQ(permMgr.grantMap_[id], static_cast<uint32_t>(PERMISSION_BIT_SECURE_PASTE));
+    permMgr.OnPermissionRevoked(id, "ohos.permission.SECURE_PASTE");
+    ASSERT_EQ(permMgr.grantMap_.count(id), static_cast<size_t>(0));
+    ASSERT_EQ(SC_OK, permMgr.GrantAppPermission(id, "ohos.permission.SECURE_PASTE"));
+    ASSERT_EQ(0, AccessTokenKit::VerifyAccessToken(id, "ohos.permission.SECURE_PASTE"));
+    permMgr.RevokeAppPermissions(id);
 }
 
 /**
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -14,6 +14,7 @@
  */
 #include "sec_comp_service_mock_test.h"
 
+#include <unistd.h>
 #include "accesstoken_kit.h"
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
@@ -160,6 +161,49 @@ HWTEST_F(SecCompServiceMockTest, RegisterReadFromRawdata001, TestSize.Level0)
     EXPECT_EQ(SAVE_COMPONENT, type);
 }
 
+/**
+ * @tc.name: RegisterBatchReadFromRawdata001
+ * @tc.desc: Test batch register read from rawdata
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompServiceMockTest, RegisterBatchReadFromRawdata001, TestSize.Level0)
+{
+    secCompService_->state_ = ServiceRunningState::STATE_RUNNING;
+    secCompService_->Initialize();
+    MessageParcel data;
+    std::vector<SecCompRegisterItem> items;
+    std::string componentInfo;
+
+    // num is zero
+    data.WriteUint32(0);
+    SecCompRawdata rawdataZero;
+    EXPECT_EQ(true, SecCompEnhanceAdapter::EnhanceSrvSerialize(data, rawdataZero));
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, secCompService_->RegisterBatchReadFromRawdata(rawdataZero, items));
+    data.FlushBuffer();
+
+    // num is bigger than SC_BATCH_MAX_NUM
+    data.WriteUint32(SC_BATCH_MAX_NUM + 1);
+    SecCompRawdata rawdataBig;
+    EXPECT_EQ(true, SecCompEnhanceAdapter::EnhanceSrvSerialize(data, rawdataBig));
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, secCompService_->RegisterBatchReadFromRawdata(rawdataBig, items));
+    data.FlushBuffer();
+
+    // invalid type only fails its own item
+    data.WriteUint32(2);
+    data.WriteUint32(0);
+    data.WriteString(componentInfo);
+    data.WriteUint32(SAVE_COMPONENT);
+    data.WriteString(componentInfo);
+    SecCompRawdata rawdataValid;
+    EXPECT_EQ(true, SecCompEnhanceAdapter::EnhanceSrvSerialize(data, rawdataValid));
+    EXPECT_EQ(SC_OK, secCompService_->RegisterBatchReadFromRawdata(rawdataValid, items));
+    ASSERT_EQ(2u, items.size());
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, items[0].result);
+    EXPECT_EQ(SC_OK, items[1].result);
+    EXPECT_EQ(SAVE_COMPONENT, items[1].type);
+}
+
 /**
  * @tc.name: RegisterSecurityComponentBody001
  * @tc.desc: Test register security component
@@ -189,7 +233,8 @@ HWTEST_F(SecCompServiceMockTest, RegisterSecurityComponentBody001, TestSize.Leve
 
     // register security component ok
     EXPECT_EQ(SC_OK, secCompService_->RegisterSecurityComponentBody(SAVE_COMPONENT, saveInfo, scId));
-    EXPECT_EQ(SC_OK, secCompService_->UpdateSecurityComponentBody(scId, saveInfo));
+    uint32_t version = 0;
+    EXPECT_EQ(SC_OK, secCompService_->UpdateSecurityComponentBody(scId, saveInfo, version));
     uint8_t buffer[1] = { 0 };
     struct SecCompClickEvent touch = {
         .type = ClickEventType::POINT_EVENT_TYPE,
@@ -207,7 +252,7 @@ HWTEST_F(SecCompServiceMockTest, RegisterSecurityComponentBody001, TestSize.Leve
     std::string message;
     EXPECT_EQ(SC_OK, secCompService_->ReportSecurityComponentClickEventBody(secCompInfo, nullptr, nullptr, message));
     EXPECT_EQ(SC_OK, secCompService_->UnregisterSecurityComponentBody(scId));
-    SecCompPermManager::GetInstance().applySaveCountMap_.clear();
+    SecCompPermManager::GetInstance().RevokeTempSavePermission(ServiceTestCommon::HAP_TOKEN_ID);
 }
 
 /**
@@ -244,7 +289,7 @@ HWTEST_F(SecCompServiceMockTest, RegisterSecurityComponentBody002, TestSize.Leve
     EXPECT_EQ(SC_SERVICE_ERROR_CLICK_EVENT_INVALID,
         secCompService_->ReportSecurityComponentClickEventBody(secCompInfo, nullptr, nullptr, message));
     EXPECT_EQ(SC_OK, secCompService_->UnregisterSecurityComponentBody(scId));
-    SecCompPermManager::GetInstance().applySaveCountMap_.clear();
+    SecCompPermManager::GetInstance().RevokeTempSavePermission(ServiceTestCommon::HAP_TOKEN_ID);
 }
 
 /**
@@ -287,7 +332,7 @@ HWTEST_F(SecCompServiceMockTest, RegisterSecurityComponentBody003, TestSize.Leve
     EXPECT_EQ(SC_SERVICE_ERROR_PERMISSION_OPER_FAIL,
         secCompService_->ReportSecurityComponentClickEventBody(secCompInfo, nullptr, nullptr, message));
     EXPECT_EQ(SC_OK, secCompService_->UnregisterSecurityComponentBody(scId));
-    SecCompPermManager::GetInstance().applySaveCountMap_.clear();
+    SecCompPermManager::GetInstance().RevokeTempSavePermission(ServiceTestCommon::HAP_TOKEN_ID);
 }
 
 /**
@@ -410,7 +455,7 @@ HWTEST_F(SecCompServiceMockTest, UpdateWriteToRawdata001, TestSize.Level0)
     secCompService_->Initialize();
     SecCompRawdata rawReply;
     EXPECT_EQ(SC_OK,
-        secCompService_->UpdateWriteToRawdata(SC_OK, rawReply));
+        secCompService_->UpdateWriteToRawdata(SC_OK, 1, rawReply));
 }
 
 /**
@@ -610,14 +655,16 @@ HWTEST_F(SecCompServiceMockTest, PreRegisterReadFromRawdata001, TestSize.Level0)
     // rawdata.data is nullptr
     SecCompRawdata rawdataVoid;
     rawdataVoid.size = 1;
+    uint32_t infoVersion = SC_INFO_VERSION_BINARY;
     EXPECT_EQ(SC_SERVICE_ERROR_PARCEL_OPERATE_FAIL,
-        secCompService_->PreRegisterReadFromRawdata(rawdataVoid));
+        secCompService_->PreRegisterReadFromRawdata(rawdataVoid, infoVersion));
 
-    // PreRegisterReadFromRawdata OK
+    // PreRegisterReadFromRawdata OK, client without info version falls back to json
     SecCompRawdata rawdata;
     EXPECT_EQ(true, SecCompEnhanceAdapter::EnhanceSrvSerialize(data, rawdata));
     EXPECT_EQ(SC_OK,
-        secCompService_->PreRegisterReadFromRawdata(rawdata));
+        secCompService_->PreRegisterReadFromRawdata(rawdata, infoVersion));
+    EXPECT_EQ(SC_INFO_VERSION_JSON, infoVersion);
 }
 
 /**
@@ -632,7 +679,70 @@ HWTEST_F(SecCompServiceMockTest, PreRegisterWriteToRawdata001, TestSize.Level0)
     secCompService_->Initialize();
     SecCompRawdata rawReply;
     EXPECT_EQ(SC_OK,
-        secCompService_->PreRegisterWriteToRawdata(SC_OK, rawReply));
+        secCompService_->PreRegisterWriteToRawdata(SC_OK, SC_INFO_VERSION_BINARY, rawReply));
+    MessageParcel reply;
+    ASSERT_TRUE(SecCompEnhanceAdapter::EnhanceSrvDeserialize(rawReply, reply));
+    EXPECT_EQ(SC_OK, reply.ReadInt32());
+    EXPECT_EQ(SC_INFO_VERSION_BINARY, reply.ReadUint32());
+    // update ring is offered without enhance
+    EXPECT_EQ(SC_CHANNEL_UPDATE_RING, reply.ReadUint32());
+}
+
+/**
+ * @tc.name: SetupUpdateChannel001
+ * @tc.desc: Test SetupUpdateChannel rejects a fd which is not a ring region
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompServiceMockTest, SetupUpdateChannel001, TestSize.Level0)
+{
+    secCompService_->state_ = ServiceRunningState::STATE_RUNNING;
+    secCompService_->Initialize();
+    EXPECT_NE(SC_OK, secCompService_->SetupUpdateChannel(-1));
+    EXPECT_EQ(SC_OK, secCompService_->NotifyUpdateChannel());
+}
+
+/**
+ * @tc.name: DrainUpdateChannel001
+ * @tc.desc: Test a failed ring record is reported to the next call of its component and breaks its delta base
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompServiceMockTest, DrainUpdateChannel001, TestSize.Level0)
+{
+    int32_t fd = -1;
+    auto producer = SecCompUpdateRing::CreateProducer(SecCompUpdateRing::MIN_RING_CAPACITY, fd);
+    ASSERT_NE(nullptr, producer);
+    SecCompCallerInfo caller = {
+        .tokenId = 0,
+        .uid = BYPASS_TEST_UID,
+        .pid = 1,
+    };
+    SecCompUpdateChannel& channel = SecCompUpdateChannel::GetInstance();
+    EXPECT_EQ(SC_OK, channel.Setup(caller, fd));
+    close(fd);
+    constexpr int32_t okScId = 1;
+    constexpr int32_t failedScId = 2;
+    channel.SetRecordHandler([](const SecCompCallerInfo&, const SecCompUpdateRecord& record,
+        const UpdateRecordBase*, uint32_t& version) {
+        version = record.seq + 1;
+        return (record.scId == okScId) ? SC_OK : SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL;
+    });
+    bool needDoorbell = false;
+    ASSERT_TRUE(producer->Push(okScId, "{}", needDoorbell));
+    ASSERT_TRUE(producer->Push(failedScId, "{}", needDoorbell));
+    channel.Drain(caller.pid);
+
+    EXPECT_EQ(1, producer->GetFailedNum());
+    EXPECT_EQ(SC_OK, channel.TakeFailedResult(caller.pid, okScId));
+    EXPECT_EQ(SC_SERVICE_ERROR_COMPONENT_INFO_NOT_EQUAL, channel.TakeFailedResult(caller.pid, failedScId));
+    EXPECT_EQ(SC_OK, channel.TakeFailedResult(caller.pid, failedScId));
+    auto processChannel = channel.FindChannel(caller.pid);
+    ASSERT_NE(nullptr, processChannel);
+    EXPECT_EQ(1, processChannel->baseMap[okScId].version);
+    EXPECT_EQ(processChannel->baseMap.end(), processChannel->baseMap.find(failedScId));
+    channel.Close(caller.pid);
+    secCompService_->Initialize();
 }
 
 /**
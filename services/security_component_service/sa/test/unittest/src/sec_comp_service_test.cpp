@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023-2024 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -22,6 +22,7 @@
 #include "paste_button.h"
 #include "save_button.h"
 #include "sec_comp_err.h"
+#include "sec_comp_info_helper.h"
 #include "sec_comp_log.h"
 #include "sec_comp_tool.h"
 #include "service_test_common.h"
@@ -137,7 +138,7 @@ HWTEST_F(SecCompServiceTest, RegisterAppStateObserver001, TestSize.Level0)
     EXPECT_CALL(*MockAppMgrProxy::g_MockAppMgrProxy,
         GetForegroundApplications(testing::_)).WillOnce(testing::Return(-1));
     EXPECT_TRUE(secCompService_->RegisterAppStateObserver());
-    EXPECT_EQ(static_cast<const size_t>(0), secCompService_->appStateObserver_->foregrandProcList_.size());
+    EXPECT_EQ(static_cast<const size_t>(0), secCompService_->appStateObserver_->fgUidProcMap_.size());
 
     // get one foreground app
     secCompService_->appStateObserver_ = nullptr;
@@ -153,7 +154,7 @@ HWTEST_F(SecCompServiceTest, RegisterAppStateObserver001, TestSize.Level0)
             return 0;
         });
     EXPECT_TRUE(secCompService_->RegisterAppStateObserver());
-    EXPECT_EQ(static_cast<const size_t>(1), secCompService_->appStateObserver_->foregrandProcList_.size());
+    EXPECT_EQ(static_cast<const size_t>(1), secCompService_->appStateObserver_->fgUidProcMap_.size());
     secCompService_->UnregisterAppStateObserver();
     SystemAbilityManagerClient::clientInstance = nullptr;
 }
@@ -222,8 +223,9 @@ HWTEST_F(SecCompServiceTest, UnregisterSecurityComponentBody001, TestSize.Level0
 HWTEST_F(SecCompServiceTest, UpdateSecurityComponentBody001, TestSize.Level0)
 {
     // get caller fail
+    uint32_t version = 0;
     EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID,
-        secCompService_->UpdateSecurityComponentBody(ServiceTestCommon::TEST_SC_ID_1, ""));
+        secCompService_->UpdateSecurityComponentBody(ServiceTestCommon::TEST_SC_ID_1, "", version));
 
     ASSERT_EQ(0, SetSelfTokenID(ServiceTestCommon::HAP_TOKEN_ID));
     AppExecFwk::AppStateData stateData = {
@@ -231,7 +233,7 @@ HWTEST_F(SecCompServiceTest, UpdateSecurityComponentBody001, TestSize.Level0)
     };
     secCompService_->appStateObserver_->AddProcessToForegroundSet(stateData);
     EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID,
-        secCompService_->UpdateSecurityComponentBody(ServiceTestCommon::TEST_SC_ID_1, "{a"));
+        secCompService_->UpdateSecurityComponentBody(ServiceTestCommon::TEST_SC_ID_1, "{a", version));
 }
 
 /**
@@ -322,6 +324,11 @@ HWTEST_F(SecCompServiceTest, Dump001, TestSize.Level0)
     // hidumper -t
     args.emplace_back(Str8ToStr16("-t"));
     ASSERT_EQ(SC_OK, secCompService_->Dump(fd, args));
+
+    args.clear();
+    // hidumper -r
+    args.emplace_back(Str8ToStr16("-r"));
+    ASSERT_EQ(SC_OK, secCompService_->Dump(fd, args));
 }
 
 /**
@@ -359,9 +366,9 @@ HWTEST_F(SecCompServiceTest, GetCallerInfo002, TestSize.Level0)
 
     setuid(0);
     const std::string componentInfo;
-    nlohmann::json jsonRes;
+    SecCompInfoPayload infoRes;
     int32_t scId  = 0;
-    EXPECT_EQ(secCompService_->ParseParams(componentInfo, caller, jsonRes), SC_SERVICE_ERROR_VALUE_INVALID);
+    EXPECT_EQ(secCompService_->ParseParams(componentInfo, caller, infoRes), SC_SERVICE_ERROR_VALUE_INVALID);
     EXPECT_NE(secCompService_->UnregisterSecurityComponentBody(scId), SC_SERVICE_ERROR_VALUE_INVALID);
 
     struct SecCompClickEvent touchInfo = {};
@@ -370,3 +377,83 @@ HWTEST_F(SecCompServiceTest, GetCallerInfo002, TestSize.Level0)
     EXPECT_EQ(secCompService_->ReportSecurityComponentClickEventBody(secCompInfo, nullptr, nullptr, message),
       SC_SERVICE_ERROR_VALUE_INVALID);
 }
+
+/**
+ * @tc.name: ParseComponentInfo001
+ * @tc.desc: Test parse json and binary component info
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompServiceTest, ParseComponentInfo001, TestSize.Level0)
+{
+    SecCompInfoPayload infoRes;
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, secCompService_->ParseComponentInfo("{", infoRes));
+
+    nlohmann::json jsonComponent;
+    ServiceTestCommon::BuildLocationComponentJson(jsonComponent);
+    EXPECT_EQ(SC_OK, secCompService_->ParseComponentInfo(jsonComponent.dump(), infoRes));
+    EXPECT_TRUE(infoRes.json.is_string());
+
+    LocationButton button;
+    std::string message;
+    ASSERT_TRUE(button.FromJson(jsonComponent, message, false));
+    uint8_t buf[SC_BINARY_MAX_SIZE] = { 0 };
+    size_t len = 0;
+    ASSERT_TRUE(button.ToBinary(buf, sizeof(buf), len));
+    std::string binaryInfo(reinterpret_cast<char*>(buf), len);
+    EXPECT_EQ(SC_OK, secCompService_->ParseComponentInfo(binaryInfo, infoRes));
+    EXPECT_EQ(reinterpret_cast<const uint8_t*>(binaryInfo.data()), infoRes.binary);
+    EXPECT_EQ(binaryInfo.size(), infoRes.binaryLen);
+
+    SecCompBase* comp = SecCompInfoHelper::ParseComponent(LOCATION_COMPONENT, infoRes, 0, message);
+    ASSERT_NE(nullptr, comp);
+    EXPECT_EQ(button.ToJsonStr(), comp->ToJsonStr());
+    delete comp;
+
+    binaryInfo.append(SC_BINARY_MAX_SIZE, 'a');
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, secCompService_->ParseComponentInfo(binaryInfo, infoRes));
+}
+
+/**
+ * @tc.name: ParseComponentInfo002
+ * @tc.desc: Test json text is deferred to the sax parser and delta is parsed to dom
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SecCompServiceTest, ParseComponentInfo002, TestSize.Level0)
+{
+    nlohmann::json jsonComponent;
+    ServiceTestCommon::BuildLocationComponentJson(jsonComponent);
+    std::string componentInfo = jsonComponent.dump();
+    SecCompInfoPayload infoRes;
+    ASSERT_EQ(SC_OK, secCompService_->ParseComponentInfo(componentInfo, infoRes));
+    ASSERT_TRUE(infoRes.json.is_string());
+
+    std::string message;
+    SecCompBase* comp = SecCompInfoHelper::ParseComponent(LOCATION_COMPONENT, infoRes, 0, message);
+    ASSERT_NE(nullptr, comp);
+    LocationButton button;
+    ASSERT_TRUE(button.FromJson(jsonComponent, message, false));
+    EXPECT_EQ(button.ToJsonStr(), comp->ToJsonStr());
+    delete comp;
+
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, secCompService_->ParseComponentInfo("[" + componentInfo + "]", infoRes));
+    componentInfo.insert(1, SC_JSON_MAX_SIZE, ' ');
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, secCompService_->ParseComponentInfo(componentInfo, infoRes));
+
+    nlohmann::json jsonDelta;
+    jsonDelta[JsonTagConstants::JSON_BASE_VERSION_TAG] = 1;
+    jsonDelta[JsonTagConstants::JSON_PARENT_TAG] = jsonComponent[JsonTagConstants::JSON_PARENT_TAG];
+    std::string deltaInfo(1, static_cast<char>(SC_DELTA_MAGIC));
+    deltaInfo += jsonDelta.dump();
+    ASSERT_EQ(SC_OK, secCompService_->ParseComponentInfo(deltaInfo, infoRes));
+    EXPECT_TRUE(infoRes.isDelta);
+    EXPECT_TRUE(infoRes.json.is_object());
+    EXPECT_EQ(SC_SERVICE_ERROR_VALUE_INVALID, secCompService_->ParseComponentInfo(deltaInfo + "]", infoRes));
+
+    // a full info is never taken as delta, even if its first key is the base version
+    jsonComponent[JsonTagConstants::JSON_BASE_VERSION_TAG] = 1;
+    ASSERT_EQ(SC_OK, secCompService_->ParseComponentInfo(jsonComponent.dump(), infoRes));
+    EXPECT_FALSE(infoRes.isDelta);
+    EXPECT_TRUE(infoRes.json.is_string());
+}
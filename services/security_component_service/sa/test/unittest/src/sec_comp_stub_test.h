@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -57,6 +57,26 @@ public:
     {
         return 0;
     };
+
+    int32_t RegisterSecurityComponents(const SecCompRawdata& rawData, SecCompRawdata& rawReply) override
+    {
+        return 0;
+    };
+
+    int32_t UnregisterSecurityComponents(const SecCompRawdata& rawData, SecCompRawdata& rawReply) override
+    {
+        return 0;
+    };
+
+    int32_t SetupUpdateChannel(int fd) override
+    {
+        return 0;
+    };
+
+    int32_t NotifyUpdateChannel() override
+    {
+        return 0;
+    };
 };
 
 class SecCompStubTest : public testing::Test {
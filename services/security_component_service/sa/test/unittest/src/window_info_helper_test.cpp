@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2023 Huawei Device Co., Ltd.
+ * Copyright (c) 2023-2026 Huawei Device Co., Ltd.
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at
@@ -20,6 +20,7 @@
 #include "service_test_common.h"
 #include "window_info_helper.h"
 #include "window_manager.h"
+#include "window_scale_cache.h"
 
 using namespace testing::ext;
 using namespace OHOS;
@@ -29,6 +30,7 @@ using namespace OHOS::Security::SecurityComponent;
 namespace {
 static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {
     LOG_CORE, SECURITY_DOMAIN_SECURITY_COMPONENT, "WindowInfoHelperTest"};
+static constexpr uint32_t TEST_COVER_WINDOW_SIZE = 300;
 }
 
 namespace OHOS {
@@ -91,6 +93,58 @@ HWTEST_F(WindowInfoHelperTest, GetWindowScale001, TestSize.Level0)
     WindowManager::GetInstance().result_ = oldResult;
 }
 
+/**
+ * @tc.name: GetWindowScale002
+ * @tc.desc: Test window scale served from cache and refreshed by window update events
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(WindowInfoHelperTest, GetWindowScale002, TestSize.Level0)
+{
+    auto oldList = WindowManager::GetInstance().list_;
+    WindowScaleCache::GetInstance().UnregisterListeners();
+    WindowManager::GetInstance().result_ = WMError::WM_OK;
+    WindowManager::GetInstance().registerResult_ = WMError::WM_OK;
+    sptr<AccessibilityWindowInfo> compWin = new AccessibilityWindowInfo();
+    compWin->wid_ = 1;
+    compWin->innerWid_ = 100;
+    compWin->scaleVal_ = 1.0;
+    compWin->scaleX_ = 0.5;
+    compWin->scaleY_ = 0.5;
+    WindowManager::GetInstance().list_ = { compWin };
+
+    bool isCompatScaleMode = false;
+    SecCompRect scaleRect;
+    Scales scales =
+        WindowInfoHelper::GetWindowScale(100, ServiceTestCommon::TEST_USER_ID, isCompatScaleMode, scaleRect);
+    EXPECT_FLOAT_EQ(0.5, scales.scaleX);
+    ASSERT_NE(nullptr, WindowManager::GetInstance().listener_);
+
+    // cached value is used until the window update event arrives
+    sptr<AccessibilityWindowInfo> newWin = new AccessibilityWindowInfo();
+    newWin->wid_ = 1;
+    newWin->innerWid_ = 100;
+    newWin->scaleVal_ = 1.0;
+    newWin->scaleX_ = 0.75;
+    newWin->scaleY_ = 0.75;
+    WindowManager::GetInstance().list_ = { newWin };
+    scales = WindowInfoHelper::GetWindowScale(100, ServiceTestCommon::TEST_USER_ID, isCompatScaleMode, scaleRect);
+    EXPECT_FLOAT_EQ(0.5, scales.scaleX);
+    WindowManager::GetInstance().listener_->OnWindowUpdate({ newWin }, WindowUpdateType::WINDOW_UPDATE_PROPERTY);
+    scales = WindowInfoHelper::GetWindowScale(100, ServiceTestCommon::TEST_USER_ID, isCompatScaleMode, scaleRect);
+    EXPECT_FLOAT_EQ(0.75, scales.scaleX);
+
+    WindowManager::GetInstance().listener_->OnWindowUpdate({ newWin }, WindowUpdateType::WINDOW_UPDATE_REMOVED);
+    WindowManager::GetInstance().list_.clear();
+    scales = WindowInfoHelper::GetWindowScale(100, ServiceTestCommon::TEST_USER_ID, isCompatScaleMode, scaleRect);
+    EXPECT_FLOAT_EQ(WindowInfoHelper::FULL_SCREEN_SCALE, scales.floatingScale);
+
+    WindowScaleCache::GetInstance().UnregisterListeners();
+    EXPECT_EQ(nullptr, WindowManager::GetInstance().listener_);
+    WindowManager::GetInstance().registerResult_ = WMError::WM_ERROR_INVALID_PERMISSION;
+    WindowManager::GetInstance().list_ = oldList;
+}
+
 /**
  * @tc.name: CheckOtherWindowCoverComp001
  * @tc.desc: Test pinter event cross other window
@@ -329,6 +383,53 @@ HWTEST_F(WindowInfoHelperTest, CheckOtherWindowCoverComp007, TestSize.Level0)
     ASSERT_FALSE(WindowInfoHelper::CheckOtherWindowCoverComp(0, compRect, ServiceTestCommon::TEST_USER_ID, message));
 }
 
+/**
+ * @tc.name: CheckOtherWindowCoverComp008
+ * @tc.desc: Test overlay windows shown or gone without window update event are seen by the next check
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(WindowInfoHelperTest, CheckOtherWindowCoverComp008, TestSize.Level0)
+{
+    WindowScaleCache::GetInstance().UnregisterListeners();
+    WindowManager::GetInstance().result_ = WMError::WM_OK;
+    WindowManager::GetInstance().registerResult_ = WMError::WM_OK;
+    bool isCompatScaleMode = false;
+    SecCompRect scaleRect;
+    WindowInfoHelper::GetWindowScale(0, ServiceTestCommon::TEST_USER_ID, isCompatScaleMode, scaleRect);
+    ASSERT_NE(nullptr, WindowManager::GetInstance().listener_);
+
+    sptr<UnreliableWindowInfo> compWin = new UnreliableWindowInfo();
+    compWin->windowId_ = 0;
+    compWin->zOrder_ = 1;
+    sptr<UnreliableWindowInfo> coverWin = new UnreliableWindowInfo();
+    coverWin->windowId_ = 1;
+    coverWin->zOrder_ = 2;
+    coverWin->windowRect_ = Rosen::Rect { 0, 0, TEST_COVER_WINDOW_SIZE, TEST_COVER_WINDOW_SIZE };
+    WindowManager::GetInstance().info_ = { compWin };
+
+    SecCompRect compRect = {
+        ServiceTestCommon::TEST_COORDINATE, ServiceTestCommon::TEST_COORDINATE,
+        ServiceTestCommon::TEST_COORDINATE, ServiceTestCommon::TEST_COORDINATE
+    };
+    std::string message;
+    ASSERT_TRUE(WindowInfoHelper::CheckOtherWindowCoverComp(0, compRect, ServiceTestCommon::TEST_USER_ID, message));
+
+    // overlay window shown without window update event
+    WindowManager::GetInstance().info_ = { compWin, coverWin };
+    ASSERT_FALSE(WindowInfoHelper::CheckOtherWindowCoverComp(0, compRect, ServiceTestCommon::TEST_USER_ID, message));
+    EXPECT_FALSE(message.empty());
+
+    // overlay window gone without window update event
+    WindowManager::GetInstance().info_ = { compWin };
+    message.clear();
+    ASSERT_TRUE(WindowInfoHelper::CheckOtherWindowCoverComp(0, compRect, ServiceTestCommon::TEST_USER_ID, message));
+    EXPECT_TRUE(message.empty());
+
+    WindowScaleCache::GetInstance().UnregisterListeners();
+    WindowManager::GetInstance().registerResult_ = WMError::WM_ERROR_INVALID_PERMISSION;
+}
+
 /**
  * @tc.name: TryGetWindowInfo001
  * @tc.desc: Test TryGetWindowInfo with normal windowId match